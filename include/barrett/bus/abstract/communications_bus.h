@@ -58,6 +58,11 @@ public:
 	virtual int send(int busId, const unsigned char* data, size_t len) const = 0;
 	virtual int receive(int expectedBusId, unsigned char* data, size_t& len, bool blocking = true, bool realtime = false) const;
 	virtual int receiveRaw(int& busId, unsigned char* data, size_t& len, bool blocking = true) const = 0;
+
+	/** The highResolutionSystemTime() at which the message last returned by receive() or receiveRaw() arrived, as
+	 * stamped by the driver rather than by the thread that read it. 0.0 if the bus doesn't timestamp messages.
+	 */
+	virtual double getLastReceiveTime() const { return 0.0; }
 };
 
 
@@ -81,32 +81,37 @@ public:
 	/** receiveRaw Method works the same as receive but is realtime safe
 	 */
 	virtual int receiveRaw(int& busId, unsigned char* data, size_t& len,
-			bool blocking = true) const
-		{ return bus->receiveRaw(busId, data, len, blocking); }
+			bool blocking = true) const;
+	/** getLastReceiveTime Method gives the underlying bus' timestamp for the last message returned, even if it was buffered
+	 */
+	virtual double getLastReceiveTime() const { return lastReceiveTime; }
 
 protected:
 	int updateBuffers() const;
-	void storeMessage(int busId, const unsigned char* data, size_t len) const;
+	void storeMessage(int busId, const unsigned char* data, size_t len, double time) const;
 	bool retrieveMessage(int busId, unsigned char* data, size_t& len) const;
 
 	CommunicationsBus* bus;
 	bool deleteBus;
+	mutable double lastReceiveTime;
 
 private:
 	struct Message {
-		Message(const unsigned char* d, size_t l) :
-			len(l)
+		Message(const unsigned char* d, size_t l, double t) :
+			len(l), time(t)
 		{
 			memcpy(data, d, len);
 		}
 
-		void copyTo(unsigned char* d, size_t& l) {
+		void copyTo(unsigned char* d, size_t& l, double& t) {
 			l = len;
 			memcpy(d, data, len);
+			t = time;
 		}
 
 		unsigned char data[CommunicationsBus::MAX_MESSAGE_LEN];
 		size_t len;
+		double time;
 	};
 
 	static const size_t MESSAGE_BUFFER_SIZE = 10;
@@ -78,10 +78,14 @@ public:
 	/** receiveRaw() method loads data from socket buffer in a realtime safe manner.
 	 */
 	virtual int receiveRaw(int& busId, unsigned char* data, size_t& len, bool blocking = true) const;
+	/** getLastReceiveTime() method returns the time at which the driver received the last frame returned by receiveRaw().
+	 */
+	virtual double getLastReceiveTime() const { return lastReceiveTime; }
 
 protected:
 	mutable thread::RealTimeMutex mutex;
 	detail::can_handle* handle;
+	mutable double lastReceiveTime;
 
 private:
 	DISALLOW_COPY_AND_ASSIGN(CANSocket);
@@ -40,6 +40,7 @@
 #include <barrett/log/reader.h>
 #include <barrett/log/writer.h>
 #include <barrett/log/real_time_writer.h>
+#include <barrett/log/trajectory_file.h>
 
 
 #endif /* BARRETT_LOG_H_ */
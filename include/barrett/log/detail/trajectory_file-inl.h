@@ -0,0 +1,96 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+/**
+ * @file trajectory_file-inl.h
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <stdexcept>
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace log {
+
+
+template<typename T>
+void TrajectoryFile::getPoint(size_t i, T* point) const
+{
+	if (size_t(T::SizeAtCompileTime) != getDimension()) {
+		(logMessage("TrajectoryFile::%s(): \"%s\" has %d coordinates per point, not %d.")
+				% __func__ % fileName % getDimension() % T::SizeAtCompileTime).template raise<std::logic_error>();
+	}
+
+	const float* p = getPoint(i);
+	for (size_t j = 0; j < getDimension(); ++j) {
+		(*point)[j] = p[j];
+	}
+}
+
+template<typename T>
+void TrajectoryFile::getPose(size_t i, T* position, Eigen::Quaterniond* orientation) const
+{
+	if (getSpace() != POSE_SPACE) {
+		(logMessage("TrajectoryFile::%s(): \"%s\" doesn't contain poses.")
+				% __func__ % fileName).template raise<std::logic_error>();
+	}
+
+	const float* p = getPoint(i);
+	(*position)[0] = p[0];
+	(*position)[1] = p[1];
+	(*position)[2] = p[2];
+	*orientation = Eigen::Quaterniond(p[3], p[4], p[5], p[6]);
+}
+
+
+template<typename Derived>
+void TrajectoryFileWriter::add(double s, const Eigen::MatrixBase<Derived>& point)
+{
+	if (size_t(point.size()) != getDimension()) {
+		(logMessage("TrajectoryFileWriter::%s(): \"%s\" has %d coordinates per point, not %d.")
+				% __func__ % fileName % getDimension() % point.size()).template raise<std::logic_error>();
+	}
+	typename Derived::PlainObject p = point;
+	add(s, p.data());
+}
+
+template<typename T>
+void TrajectoryFileWriter::add(double s, const T& position, const Eigen::Quaterniond& orientation)
+{
+	double point[7] = { position[0], position[1], position[2],
+			orientation.w(), orientation.x(), orientation.y(), orientation.z() };
+	if (getDimension() != 7) {
+		(logMessage("TrajectoryFileWriter::%s(): \"%s\" has %d coordinates per point, not 7.")
+				% __func__ % fileName % getDimension()).template raise<std::logic_error>();
+	}
+	add(s, point);
+}
+
+
+}
+}
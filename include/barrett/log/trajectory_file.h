@@ -0,0 +1,165 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file trajectory_file.h
+ * @date 10/19/2026
+ *
+ */
+
+#ifndef BARRETT_LOG_TRAJECTORY_FILE_H_
+#define BARRETT_LOG_TRAJECTORY_FILE_H_
+
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <Eigen/Geometry>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace log {
+
+
+/** A recorded trajectory (such as a teach and play recording) in a compact
+ * binary file that can be used without parsing.
+ *
+ * The file holds a Header, then the points as floats (one row of
+ * getDimension() floats per knot), then the knots' path parameters (s) as
+ * doubles. Each column is contiguous, so TrajectoryFile maps the file into
+ * memory and hands out pointers into it; opening a file takes the same time
+ * regardless of its length, and pages are only read as they are used. The s
+ * column is strictly increasing, so it doubles as the index used by find().
+ *
+ * Files are written in the host's byte order and rejected on hosts of the
+ * other order.
+ */
+class TrajectoryFile {
+public:
+	enum Space {
+		JOINT_SPACE = 0,  ///< Joint positions
+		POSE_SPACE = 1  ///< Tool position (x, y, z) then orientation (w, x, y, z)
+	};
+
+	struct Header {
+		char magic[8];
+		boost::uint32_t version;
+		boost::uint32_t byteOrder;  // BYTE_ORDER_MARK, as written by the host
+		boost::uint32_t space;
+		boost::uint32_t dimension;  // Floats per point
+		double samplePeriod;  // Nominal; 0.0 if unknown
+		boost::uint64_t knotCount;
+		boost::uint64_t pointsOffset;  // In bytes, from the start of the file
+		boost::uint64_t sOffset;
+	};
+
+	static const char MAGIC[8];
+	static const boost::uint32_t VERSION = 1;
+	static const boost::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+	/// Maps fileName into memory. Throws std::runtime_error if it isn't a valid trajectory file.
+	explicit TrajectoryFile(const std::string& fileName);
+	~TrajectoryFile();
+
+	/// True if fileName starts with a trajectory file's magic number.
+	static bool isTrajectoryFile(const std::string& fileName);
+
+	Space getSpace() const { return static_cast<Space>(header->space); }
+	size_t getDimension() const { return header->dimension; }
+	double getSamplePeriod() const { return header->samplePeriod; }
+	size_t size() const { return header->knotCount; }
+
+	double initialS() const { return s[0]; }
+	double finalS() const { return s[size() - 1]; }
+
+	double getS(size_t i) const { return s[i]; }
+	const float* getPoint(size_t i) const { return points + i * getDimension(); }
+	/// Copies knot i into point, which must be a fixed-size vector of getDimension() elements.
+	template<typename T> void getPoint(size_t i, T* point) const;
+	/// Splits knot i of a POSE_SPACE file into position and orientation.
+	template<typename T> void getPose(size_t i, T* position, Eigen::Quaterniond* orientation) const;
+
+	/// The index of the last knot at or before s, or 0 if s precedes the first knot.
+	size_t find(double s) const;
+
+protected:
+	std::string fileName;
+	void* data;
+	size_t length;
+
+	const Header* header;
+	const float* points;
+	const double* s;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TrajectoryFile);
+};
+
+
+/// Writes a TrajectoryFile, one knot at a time.
+class TrajectoryFileWriter {
+public:
+	TrajectoryFileWriter(const std::string& fileName, TrajectoryFile::Space space,
+			size_t dimension, double samplePeriod = 0.0);
+	~TrajectoryFileWriter();
+
+	/// s must increase from one knot to the next. point must have getDimension() elements.
+	void add(double s, const double* point);
+	template<typename Derived> void add(double s, const Eigen::MatrixBase<Derived>& point);
+	/// For POSE_SPACE files
+	template<typename T> void add(double s, const T& position, const Eigen::Quaterniond& orientation);
+
+	size_t getDimension() const { return header.dimension; }
+	size_t size() const { return s.size(); }
+
+	/// Writes the s column and the final Header. Called by the destructor if necessary.
+	void close();
+
+protected:
+	std::string fileName;
+	std::ofstream file;
+	TrajectoryFile::Header header;
+	std::vector<double> s;
+	std::vector<float> row;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TrajectoryFileWriter);
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/log/detail/trajectory_file-inl.h>
+
+
+#endif /* BARRETT_LOG_TRAJECTORY_FILE_H_ */
@@ -44,10 +44,16 @@
 #include <barrett/math/first_order_filter.h>
 
 #include <barrett/math/spline.h>
+#include <barrett/math/streaming_spline.h>
 #include <barrett/math/trapezoidal_velocity_profile.h>
+#include <barrett/math/jerk_limited_profile.h>
+
+#include <barrett/math/aabb_tree.h>
+#include <barrett/math/triangle_mesh.h>
 
 #include <barrett/math/kinematics.h>
 #include <barrett/math/dynamics.h>
+#include <barrett/math/trajectory_validator.h>
 
 
 #endif /* BARRETT_MATH_H_ */
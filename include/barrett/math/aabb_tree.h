@@ -0,0 +1,134 @@
+/*
+ * aabb_tree.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_AABB_TREE_H_
+#define BARRETT_MATH_AABB_TREE_H_
+
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Core>
+
+
+namespace barrett {
+namespace math {
+
+
+/** A static bounding volume hierarchy of axis-aligned boxes in 3-space.
+ *
+ * The tree indexes items (segments, triangles, haptic primitives...) by their
+ * bounding boxes. It is built once, by recursively splitting the items at the
+ * median of their centers along the longest axis, so its depth is logarithmic
+ * in the number of items. Queries only read the tree, don't allocate, and can
+ * be made from any number of threads.
+ */
+class AabbTree {
+public:
+	typedef Eigen::Vector3d vector_type;
+
+	struct Box {
+		/// An empty Box. Extending it by any point or Box yields that point or Box.
+		Box() :
+			min(vector_type::Constant(std::numeric_limits<double>::infinity())),
+			max(vector_type::Constant(-std::numeric_limits<double>::infinity())) {}
+		/// The smallest Box containing both points.
+		Box(const vector_type& a, const vector_type& b) :
+			min(a.cwiseMin(b)), max(a.cwiseMax(b)) {}
+
+		void extend(const vector_type& p) {
+			min = min.cwiseMin(p);
+			max = max.cwiseMax(p);
+		}
+		void extend(const Box& b) {
+			min = min.cwiseMin(b.min);
+			max = max.cwiseMax(b.max);
+		}
+		/// Grows the Box by margin in every direction.
+		void inflate(double margin) {
+			min.array() -= margin;
+			max.array() += margin;
+		}
+
+		vector_type center() const { return (min + max) / 2.0; }
+		bool contains(const vector_type& p) const {
+			return (p.array() >= min.array()).all()  &&  (p.array() <= max.array()).all();
+		}
+		bool intersects(const Box& b) const {
+			return (b.max.array() >= min.array()).all()  &&  (b.min.array() <= max.array()).all();
+		}
+		/// Zero if p is inside the Box.
+		double squaredDistance(const vector_type& p) const {
+			return (min - p).cwiseMax(p - max).cwiseMax(0.0).squaredNorm();
+		}
+
+		vector_type min, max;
+	};
+
+	/// Returned by queries that find nothing.
+	static const size_t NONE = static_cast<size_t>(-1);
+
+	AabbTree() {}
+	/// Item i is bounded by boxes[i].
+	explicit AabbTree(const std::vector<Box>& boxes) { build(boxes); }
+
+	void build(const std::vector<Box>& boxes);
+
+	size_t size() const { return items.size(); }
+	bool empty() const { return items.empty(); }
+	/// Only valid if the tree isn't empty.
+	const Box& getBounds() const { return nodes[0].box; }
+
+	/** Finds the item nearest to p.
+	 *
+	 * squaredDistance(i, p) must return the squared distance from item i to p,
+	 * which can't be less than the squared distance from p to item i's Box.
+	 * Subtrees that can't contain anything closer than the best item so far are
+	 * skipped, so passing the previous result as hint (when p moves
+	 * continuously) usually limits the search to a handful of items.
+	 *
+	 * Returns NONE if the tree is empty. Otherwise returns the index of the
+	 * nearest item and sets *minSquaredDistance to its squared distance.
+	 */
+	template<typename Function>
+	size_t nearest(const vector_type& p, const Function& squaredDistance,
+			double* minSquaredDistance, size_t hint = NONE) const;
+
+	/// Calls f(i) for each item i whose Box intersects box.
+	template<typename Function>
+	void forEachIntersecting(const Box& box, Function& f) const;
+
+protected:
+	static const size_t MAX_LEAF_SIZE = 4;
+	static const size_t MAX_DEPTH = 64;  // Far more than a median split can need
+
+	struct Node {
+		Box box;
+		size_t right;  // Internal nodes only; the left child immediately follows its parent
+		size_t begin, count;  // Leaves only (count != 0): a range of items
+	};
+
+	void buildNode(size_t begin, size_t end, const std::vector<vector_type>& centers, size_t depth);
+
+	std::vector<Node> nodes;
+	std::vector<size_t> items;  // Item indices, grouped by leaf
+	std::vector<Box> itemBoxes;  // In the same order as items
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/aabb_tree-inl.h>
+
+
+#endif /* BARRETT_MATH_AABB_TREE_H_ */
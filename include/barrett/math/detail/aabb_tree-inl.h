@@ -0,0 +1,121 @@
+/*
+ * aabb_tree-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <limits>
+#include <algorithm>
+
+
+namespace barrett {
+namespace math {
+
+
+template<typename Function>
+size_t AabbTree::nearest(const vector_type& p, const Function& squaredDistance,
+		double* minSquaredDistance, size_t hint) const
+{
+	if (empty()) {
+		return NONE;
+	}
+
+	size_t best = NONE;
+	double bestD = std::numeric_limits<double>::infinity();
+	if (hint != NONE) {
+		best = hint;
+		bestD = squaredDistance(hint, p);
+	}
+
+	// Depth-first, nearer child first. Only the farther child of each visited
+	// node is ever pushed, so the stack never exceeds the depth of the tree.
+	struct Entry {
+		size_t node;
+		double d;
+	} stack[MAX_DEPTH];
+	size_t top = 0;
+
+	size_t n = 0;
+	double d = nodes[0].box.squaredDistance(p);
+	while (true) {
+		if (d < bestD  ||  best == NONE) {
+			const Node& node = nodes[n];
+			if (node.count != 0) {
+				for (size_t i = node.begin; i < node.begin + node.count; ++i) {
+					if (items[i] != hint  &&  (best == NONE  ||  itemBoxes[i].squaredDistance(p) < bestD)) {
+						double di = squaredDistance(items[i], p);
+						if (di < bestD  ||  best == NONE) {
+							best = items[i];
+							bestD = di;
+						}
+					}
+				}
+			} else {
+				size_t near = n + 1, far = node.right;
+				double dNear = nodes[near].box.squaredDistance(p);
+				double dFar = nodes[far].box.squaredDistance(p);
+				if (dFar < dNear) {
+					std::swap(near, far);
+					std::swap(dNear, dFar);
+				}
+
+				stack[top].node = far;
+				stack[top].d = dFar;
+				++top;
+
+				n = near;
+				d = dNear;
+				continue;
+			}
+		}
+
+		if (top == 0) {
+			break;
+		}
+		--top;
+		n = stack[top].node;
+		d = stack[top].d;
+	}
+
+	*minSquaredDistance = bestD;
+	return best;
+}
+
+template<typename Function>
+void AabbTree::forEachIntersecting(const Box& box, Function& f) const
+{
+	if (empty()) {
+		return;
+	}
+
+	size_t stack[MAX_DEPTH];
+	size_t top = 0;
+
+	size_t n = 0;
+	while (true) {
+		const Node& node = nodes[n];
+		if (node.box.intersects(box)) {
+			if (node.count != 0) {
+				for (size_t i = node.begin; i < node.begin + node.count; ++i) {
+					if (itemBoxes[i].intersects(box)) {
+						f(items[i]);
+					}
+				}
+			} else {
+				stack[top++] = node.right;
+				n = n + 1;
+				continue;
+			}
+		}
+
+		if (top == 0) {
+			break;
+		}
+		n = stack[--top];
+	}
+}
+
+
+}
+}
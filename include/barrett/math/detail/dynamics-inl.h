@@ -36,6 +36,23 @@ const typename units::JointTorques<DOF>::type& Dynamics<DOF>::evalInverse(const
 	return jt;
 }
 
+template<size_t DOF>
+void Dynamics<DOF>::setGravity(const ca_type& g)
+{
+	// The RNEA accounts for gravity by accelerating the base upwards.
+	for (size_t i = 0; i < 3; ++i) {
+		gsl_vector_set(impl->base->a, i, -g[i]);
+	}
+}
+
+template<size_t DOF>
+const typename Dynamics<DOF>::sqm_type& Dynamics<DOF>::evalJsim(const Kinematics<DOF>& kin)
+{
+	bt_dynamics_eval_jsim(impl, kin.impl);
+	jsim.copyFrom(impl->jsim);
+	return jsim;
+}
+
 //template<size_t DOF>
 //const units::JointTorques<DOF>::type& Dynamics<DOF>::operator() (const boost::tuple<jv_type, ja_type>& jointState)
 //{
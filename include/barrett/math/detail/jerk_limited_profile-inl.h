@@ -0,0 +1,154 @@
+/*
+ * jerk_limited_profile-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cmath>
+#include <limits>
+
+
+namespace barrett {
+namespace math {
+
+
+template<typename T>
+SynchronizedJerkLimitedProfile<T>::SynchronizedJerkLimitedProfile(
+		double velocity, double acceleration, double jerk) :
+	tf(0.0)
+{
+	setLimits(unitless_type(velocity), unitless_type(acceleration), unitless_type(jerk));
+}
+
+template<typename T>
+SynchronizedJerkLimitedProfile<T>::SynchronizedJerkLimitedProfile(
+		const unitless_type& velocity, const unitless_type& acceleration,
+		const unitless_type& jerk) :
+	tf(0.0)
+{
+	setLimits(velocity, acceleration, jerk);
+}
+
+template<typename T>
+void SynchronizedJerkLimitedProfile<T>::setLimits(const unitless_type& velocity,
+		const unitless_type& acceleration, const unitless_type& jerk)
+{
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		profiles[i].setLimits(velocity[i], acceleration[i], jerk[i]);
+	}
+
+	vMax = velocity;
+	aMax = acceleration;
+	jMax = jerk;
+}
+
+template<typename T>
+bool SynchronizedJerkLimitedProfile<T>::plan(const T& p0,
+		const unitless_type& v0, const unitless_type& a0, const T& pf)
+{
+	if (v0.isZero(0.0)  &&  a0.isZero(0.0)) {
+		planFromRest(p0, pf);
+		return true;
+	}
+
+	tf = 0.0;
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		profiles[i].setLimits(vMax[i], aMax[i], jMax[i]);
+		profiles[i].plan(p0[i], v0[i], a0[i], pf[i]);
+		if (profiles[i].finalT() > tf) {
+			tf = profiles[i].finalT();
+		}
+	}
+
+	// Slow the other axes down to match the slowest one. An axis that can't
+	// be slowed to exactly tf raises tf to a duration it can always reach, and
+	// every axis is re-planned. Each axis can raise tf only once.
+	for (size_t pass = 0; pass <= T::SIZE; ++pass) {
+		const double target = tf;
+		bool synchronized = true;
+		for (size_t i = 0; i < T::SIZE; ++i) {
+			if (profiles[i].finalT() == target  ||
+					(v0[i] == 0.0  &&  a0[i] == 0.0  &&  pf[i] == p0[i])) {  // not moving
+				continue;
+			}
+
+			if (profiles[i].plan(p0[i], v0[i], a0[i], pf[i], target)) {
+				if (profiles[i].finalT() > tf) {  // round-off
+					tf = profiles[i].finalT();
+				}
+			} else {
+				synchronized = false;
+				const double t = profiles[i].shortestSlowedDuration(p0[i], v0[i], a0[i], pf[i]);
+				if (t > tf  &&  t != std::numeric_limits<double>::infinity()) {
+					tf = t;
+				}
+			}
+		}
+
+		if (synchronized) {
+			return true;
+		}
+		if (tf == target) {  // Nothing left to try
+			break;
+		}
+	}
+	return false;
+}
+
+// A rest-to-rest profile scales exactly with its limits and distance, so
+// giving every axis the same limits per unit distance keeps the axes in
+// phase and the path a straight line.
+template<typename T>
+void SynchronizedJerkLimitedProfile<T>::planFromRest(const T& p0, const T& pf)
+{
+	double v = 0.0, a = 0.0, j = 0.0;
+	bool first = true;
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		double d = std::fabs(pf[i] - p0[i]);
+		if (d > 0.0) {
+			if (first  ||  vMax[i] / d < v) v = vMax[i] / d;
+			if (first  ||  aMax[i] / d < a) a = aMax[i] / d;
+			if (first  ||  jMax[i] / d < j) j = jMax[i] / d;
+			first = false;
+		}
+	}
+
+	tf = 0.0;
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		double d = std::fabs(pf[i] - p0[i]);
+		if (d > 0.0) {
+			profiles[i].setLimits(v * d, a * d, j * d);
+		} else {
+			profiles[i].setLimits(vMax[i], aMax[i], jMax[i]);
+		}
+		profiles[i].plan(p0[i], 0.0, 0.0, pf[i]);
+
+		if (profiles[i].finalT() > tf) {
+			tf = profiles[i].finalT();
+		}
+	}
+}
+
+template<typename T>
+inline T SynchronizedJerkLimitedProfile<T>::eval(double t) const
+{
+	T p;
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		p[i] = profiles[i].eval(t);
+	}
+	return p;
+}
+
+template<typename T>
+void SynchronizedJerkLimitedProfile<T>::eval(double t, T* p,
+		unitless_type* v, unitless_type* a) const
+{
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		profiles[i].eval(t, &(*p)[i], &(*v)[i], &(*a)[i]);
+	}
+}
+
+
+}
+}
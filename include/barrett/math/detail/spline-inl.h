@@ -30,7 +30,9 @@
 
 
 #include <iostream>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <gsl/gsl_interp.h>
 
@@ -45,7 +47,7 @@ namespace math {
 template<typename T>
 template<template<typename, typename> class Container, typename Allocator>
 Spline<T>::Spline(const Container<tuple_type, Allocator>& samples, bool saturateS) :
-	impl(NULL), sat(saturateS), s_0(0.0), s_f(0.0)
+	impl(NULL), sat(saturateS), s_0(0.0), s_f(0.0), dimension(0)
 {
 	s_0 = boost::get<0>(samples[0]);
 
@@ -58,12 +60,13 @@ Spline<T>::Spline(const Container<tuple_type, Allocator>& samples, bool saturate
 
 	bt_spline_init(impl, NULL, NULL);
 	s_f = s_0 + changeInS();
+	computeCoefficients();
 }
 
 template<typename T>
 template<template<typename, typename> class Container, typename Allocator>
 Spline<T>::Spline(const Container<T, Allocator>& points, /*const typename T::unitless_type& initialDirection,*/ bool saturateS) :
-	impl(NULL), sat(saturateS), s_0(0.0), s_f(0.0)
+	impl(NULL), sat(saturateS), s_0(0.0), s_f(0.0), dimension(0)
 {
 	bt_spline_create(&impl, points[0].asGslType(), BT_SPLINE_MODE_ARCLEN);
 
@@ -80,6 +83,7 @@ Spline<T>::Spline(const Container<T, Allocator>& points, /*const typename T::uni
 	bt_spline_init(impl, NULL, NULL);
 
 	s_f = s_0 + changeInS();
+	computeCoefficients();
 }
 
 template<typename T>
@@ -95,54 +99,140 @@ inline double Spline<T>::changeInS() const
 	return impl->length;
 }
 
+// Reads the polynomial for each segment back out of the interpolators. The
+// second derivative of a cubic spline is continuous, so the cubic coefficient
+// follows from its values at either end of the segment.
 template<typename T>
-inline T Spline<T>::eval(double s) const
+void Spline<T>::computeCoefficients()
 {
-	if (sat) {
-		s = saturate(s, s_0, s_f);
+	dimension = impl->dimension;
+	const int numKnots = impl->npoints;
+	const int numSegments = math::max(numKnots - 1, 1);
+
+	knots.assign(impl->ss, impl->ss + numKnots);
+	coefficients.assign(numSegments * 4 * dimension, 0.0);
+
+	if (numKnots < 2) {  // Constant
+		for (int j = 0; j < dimension; ++j) {
+			coefficients[j] = impl->points[j][0];
+		}
+		return;
+	}
+
+	for (int i = 0; i < numSegments; ++i) {
+		double* c = &coefficients[i * 4 * dimension];
+		const double h = knots[i+1] - knots[i];
+
+		for (int j = 0; j < dimension; ++j) {
+			const double d2Start = gsl_interp_eval_deriv2(impl->interps[j], impl->ss, impl->points[j], knots[i], impl->acc);
+			const double d2End = gsl_interp_eval_deriv2(impl->interps[j], impl->ss, impl->points[j], knots[i+1], impl->acc);
+
+			c[0*dimension + j] = gsl_interp_eval(impl->interps[j], impl->ss, impl->points[j], knots[i], impl->acc);
+			c[1*dimension + j] = gsl_interp_eval_deriv(impl->interps[j], impl->ss, impl->points[j], knots[i], impl->acc);
+			c[2*dimension + j] = d2Start / 2.0;
+			c[3*dimension + j] = (d2End - d2Start) / (6.0 * h);
+		}
 	}
+}
+
+// Returns the coefficients of the segment containing s (relative to s_0) and
+// sets ds to the offset into that segment. Outside of the knots, the first or
+// last segment is extrapolated.
+template<typename T>
+inline const double* Spline<T>::findSegment(double s, double* ds) const
+{
+	size_t i = 0;
+	if (knots.size() > 2) {
+		i = std::upper_bound(knots.begin() + 1, knots.end() - 1, s) - (knots.begin() + 1);
+	}
+
+	*ds = s - knots[i];
+	return &coefficients[i * 4 * dimension];
+}
+
+template<typename T>
+inline T Spline<T>::eval(double s) const
+{
+	double ds;
+	const double* c = findSegment(clampS(s) - s_0, &ds);
 
 	T result;
-	bt_spline_get(impl, result.asGslType(), s - s_0);
+	result = coefficient_map_type(c, dimension) + ds * (coefficient_map_type(c + dimension, dimension)
+			+ ds * (coefficient_map_type(c + 2*dimension, dimension) + ds * coefficient_map_type(c + 3*dimension, dimension)));
 	return result;
 }
 
 template<typename T>
 inline T Spline<T>::evalDerivative(double s) const
 {
-	if (sat) {
-		s = saturate(s, s_0, s_f);
-	}
+	double ds;
+	const double* c = findSegment(clampS(s) - s_0, &ds);
 
 	T result;
-	for (int i = 0; i < impl->dimension; ++i) {
-		result[i] = gsl_interp_eval_deriv(impl->interps[i], impl->ss, impl->points[i], s - s_0, impl->acc);
-	}
+	result = coefficient_map_type(c + dimension, dimension)
+			+ ds * (2.0 * coefficient_map_type(c + 2*dimension, dimension) + (3.0 * ds) * coefficient_map_type(c + 3*dimension, dimension));
+	return result;
+}
+
+template<typename T>
+inline T Spline<T>::evalSecondDerivative(double s) const
+{
+	double ds;
+	const double* c = findSegment(clampS(s) - s_0, &ds);
+
+	T result;
+	result = 2.0 * coefficient_map_type(c + 2*dimension, dimension) + (6.0 * ds) * coefficient_map_type(c + 3*dimension, dimension);
 	return result;
 }
 
+template<typename T>
+void Spline<T>::eval(double s, T* value, T* derivative, T* secondDerivative) const
+{
+	double ds;
+	const double* c = findSegment(clampS(s) - s_0, &ds);
+
+	coefficient_map_type c0(c, dimension);
+	coefficient_map_type c1(c + dimension, dimension);
+	coefficient_map_type c2(c + 2*dimension, dimension);
+	coefficient_map_type c3(c + 3*dimension, dimension);
+
+	*value = c0 + ds * (c1 + ds * (c2 + ds * c3));
+	if (derivative != NULL) {
+		*derivative = c1 + ds * (2.0 * c2 + (3.0 * ds) * c3);
+	}
+	if (secondDerivative != NULL) {
+		*secondDerivative = 2.0 * c2 + (6.0 * ds) * c3;
+	}
+}
+
 
 // Specialization for Eigen::Quaternion  types
 template<typename Scalar>
 template<template<typename, typename> class Container, typename Allocator>
 Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<tuple_type, Allocator>& samples, bool saturateS) :
-	data(samples.begin(), samples.end()), sat(saturateS), index(0), rate(-1.0)
+	knots(), points(), segments(), sat(saturateS)
 {
-	// Make sure s is monotonic.
-	for (size_t i = 0; i < data.size() - 1; ++i) {
-		assert(boost::get<0>(data[i]) < boost::get<0>(data[i+1]));
+	knots.reserve(samples.size());
+	points.reserve(samples.size());
+
+	typename Container<tuple_type, Allocator>::const_iterator i;
+	for (i = samples.begin(); i != samples.end(); ++i) {
+		knots.push_back(boost::get<0>(*i));
+		points.push_back(boost::get<1>(*i));
 	}
+
+	init();
 }
 
 template<typename Scalar>
 template<template<typename, typename> class Container, typename Allocator>
-Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<data_type, Allocator>& points, bool saturateS) :
-	data(points.size()), sat(saturateS), index(0), rate(-1.0)
+Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<data_type, Allocator>& points_, bool saturateS) :
+	knots(points_.size()), points(points_.begin(), points_.end()), segments(), sat(saturateS)
 {
 	double s = 0.0;
-	for (size_t i = 0; i < data.size(); ++i) {
+	for (size_t i = 0; i < knots.size(); ++i) {
 		if (i > 0) {
-			double ad = points.at(i).angularDistance(points.at(i-1));
+			double ad = points[i].angularDistance(points[i-1]);
 			assert(ad >= 0.0);
 
 			// If the points are too close together, enforce an artificial
@@ -150,42 +240,100 @@ Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<data_type, Allocator>
 			s += math::max(ad, 1e-4);
 		}
 
-		boost::get<0>(data[i]) = s;
-		boost::get<1>(data[i]) = points.at(i);
+		knots[i] = s;
 	}
 
+	init();
+}
+
+// Fills the slerp table. Each Segment reproduces
+// points[i].slerp(t, points[i+1]) without the per-call acos().
+template<typename Scalar>
+void Spline<Eigen::Quaternion<Scalar> >::init()
+{
 	// Make sure s is monotonic.
-	for (size_t i = 0; i < data.size() - 1; ++i) {
-		assert(boost::get<0>(data[i]) < boost::get<0>(data[i+1]));
+	for (size_t i = 0; i < knots.size() - 1; ++i) {
+		assert(knots[i] < knots[i+1]);
+	}
+
+	segments.resize(knots.size() - 1);
+	for (size_t i = 0; i < segments.size(); ++i) {
+		Segment& seg = segments[i];
+		seg.q0 = points[i];
+		seg.q1 = points[i+1];
+		seg.rate = 1.0 / (knots[i+1] - knots[i]);
+
+		Scalar d = seg.q0.dot(seg.q1);
+		if (d < Scalar(0)) {
+			seg.q1.coeffs() = -seg.q1.coeffs();
+			d = -d;
+		}
+
+		seg.linear = d >= Scalar(1) - Eigen::NumTraits<Scalar>::epsilon();
+		seg.theta = seg.linear ? Scalar(0) : std::acos(d);
+		seg.invSinTheta = seg.linear ? Scalar(0) : Scalar(1) / std::sin(seg.theta);
 	}
 }
 
 template<typename Scalar>
-typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::eval(double s) const
+inline size_t Spline<Eigen::Quaternion<Scalar> >::findSegment(double s) const
 {
-	s = saturate(s, initialS(), finalS());
-
-	while (index > 0  &&  s < boost::get<0>(data[index])) {
-		--index;
-		rate = -1.0;
+	if (segments.size() <= 1) {
+		return 0;
 	}
-	while (index < data.size()-1  &&  s >= boost::get<0>(data[index+1])) {
-		++index;
-		rate = -1.0;
+	return std::upper_bound(knots.begin() + 1, knots.end() - 1, s) - (knots.begin() + 1);
+}
+
+// s must already be saturated.
+template<typename Scalar>
+inline typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::evalSegment(size_t i, double s) const
+{
+	if (segments.size() == 0  ||  s >= knots.back()) {
+		return points.back();
 	}
-	assert(index < data.size());
 
-	if (index == data.size()-1) {
-		return boost::get<1>(data[index]);
-	} else {
-		if (rate < 0.0) {
-			rate = 1.0 / (boost::get<0>(data[index+1]) - boost::get<0>(data[index]));
-		}
+	const Segment& seg = segments[i];
+	const Scalar t = seg.rate * (s - knots[i]);
 
-		return boost::get<1>(data[index]).slerp(rate * (s - boost::get<0>(data[index])), boost::get<1>(data[index+1]));
+	Scalar scale0, scale1;
+	if (seg.linear) {
+		scale0 = Scalar(1) - t;
+		scale1 = t;
+	} else {
+		scale0 = std::sin((Scalar(1) - t) * seg.theta) * seg.invSinTheta;
+		scale1 = std::sin(t * seg.theta) * seg.invSinTheta;
 	}
+
+	data_type result;
+	result.coeffs() = scale0 * seg.q0.coeffs() + scale1 * seg.q1.coeffs();
+	return result;
+}
+
+template<typename Scalar>
+typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::eval(double s) const
+{
+	s = saturate(s, initialS(), finalS());
+	return evalSegment(findSegment(s), s);
 }
 
+template<typename Scalar>
+typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::eval(double s, Cursor* cursor) const
+{
+	s = saturate(s, initialS(), finalS());
+
+	size_t i = cursor->index;
+	if (i >= segments.size()) {
+		i = findSegment(s);
+	} else if (s < knots[i]) {
+		// Check the previous segment before giving up on the hint.
+		i = (i > 0  &&  s >= knots[i-1]) ? i-1 : findSegment(s);
+	} else if (i + 1 < segments.size()  &&  s >= knots[i+1]) {
+		i = (i + 2 >= segments.size()  ||  s < knots[i+2]) ? i+1 : findSegment(s);
+	}
+
+	cursor->index = i;
+	return evalSegment(i, s);
+}
 
 }
 }
@@ -0,0 +1,249 @@
+/*
+ * streaming_spline-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cassert>
+#include <stdexcept>
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace math {
+
+
+template<typename T>
+StreamingSpline<T>::StreamingSpline(size_t capacity, size_t lookahead_, bool saturateS) :
+	lookahead(lookahead_), sat(saturateS), s_0(0.0),
+	window(lookahead_ + 2), numWindowKnots(0), v0(0.0),
+	m(lookahead_ + 2), dPrime(lookahead_ + 2), cPrime(lookahead_ + 2),
+	segments(capacity), head(0), tail(0), s_available(0.0), finished(false)
+{
+	if (capacity < 1  ||  lookahead < 1) {
+		(logMessage("StreamingSpline::%s(): capacity and lookahead must be at least 1. "
+				"(Given: capacity = %d, lookahead = %d.)")
+				% __func__ % capacity % lookahead).template raise<std::logic_error>();
+	}
+}
+
+template<typename T>
+bool StreamingSpline<T>::add(double s, const T& point)
+{
+	if (isFinished()) {
+		(logMessage("StreamingSpline::%s(): finish() has already been called.")
+				% __func__).template raise<std::logic_error>();
+	}
+	if (numWindowKnots > 0  &&  s <= window[numWindowKnots - 1].s) {
+		(logMessage("StreamingSpline::%s(): s must be strictly increasing. (Given: %f after %f.)")
+				% __func__ % s % window[numWindowKnots - 1].s).template raise<std::logic_error>();
+	}
+
+	if (numWindowKnots == lookahead + 1) {
+		// The window will be full, so the oldest segment can be finalized.
+		if (head.load(boost::memory_order_relaxed) - tail.load(boost::memory_order_acquire) >= segments.size()) {
+			return false;
+		}
+
+		window[numWindowKnots].s = s;
+		window[numWindowKnots].y = point;
+		++numWindowKnots;
+
+		solveWindow(numWindowKnots, false);
+		pushSegment(window[0], window[1], m[0], m[1]);
+		dropKnot();
+	} else {
+		if (numWindowKnots == 0  &&  head.load(boost::memory_order_relaxed) == 0) {
+			s_0 = s;
+		}
+
+		window[numWindowKnots].s = s;
+		window[numWindowKnots].y = point;
+		++numWindowKnots;
+	}
+
+	return true;
+}
+
+template<typename T>
+bool StreamingSpline<T>::finish()
+{
+	if (isFinished()) {
+		return true;
+	}
+
+	// A lone sample still needs a (constant) segment.
+	const size_t needed = (numWindowKnots > 1) ? numWindowKnots - 1 : numWindowKnots;
+	if (head.load(boost::memory_order_relaxed) + needed - tail.load(boost::memory_order_acquire) > segments.size()) {
+		return false;
+	}
+
+	if (needed == 1  &&  numWindowKnots == 1) {
+		// A single sample: the spline is constant.
+		m[0].setZero();
+		pushSegment(window[0], window[0], m[0], m[0]);
+	} else if (needed > 0) {
+		solveWindow(numWindowKnots, true);
+		for (size_t i = 0; i < numWindowKnots - 1; ++i) {
+			pushSegment(window[i], window[i+1], m[i], m[i+1]);
+		}
+	}
+
+	finished.store(true, boost::memory_order_release);
+	return true;
+}
+
+template<typename T>
+void StreamingSpline<T>::clear()
+{
+	numWindowKnots = 0;
+	v0.setZero();
+	head.store(0, boost::memory_order_release);
+	tail.store(0, boost::memory_order_release);
+	s_available.store(0.0, boost::memory_order_release);
+	finished.store(false, boost::memory_order_release);
+}
+
+// Solves for the second derivatives at the first n knots of the window. At
+// the end of the stream, the right end is natural. Otherwise the samples
+// beyond the window are unknown, and assuming a constant second derivative
+// over the last interval (rather than zero) disturbs the finalized segment
+// much less. The left end is natural for the first segment and is
+// clamped to the slope of the previous segment after that, which keeps the
+// spline C1 continuous no matter how the window changes.
+template<typename T>
+void StreamingSpline<T>::solveWindow(size_t n, bool naturalEnd)
+{
+	// Thomas algorithm. The matrix is the same for every coordinate, so only
+	// the right-hand side is a vector.
+	if (head.load(boost::memory_order_relaxed) == 0) {
+		cPrime[0] = 0.0;
+		dPrime[0].setZero();
+	} else {
+		const double h0 = window[1].s - window[0].s;
+		cPrime[0] = 0.5;
+		dPrime[0] = (3.0 / h0) * ((window[1].y - window[0].y) / h0 - v0);
+	}
+
+	for (size_t i = 1; i < n-1; ++i) {
+		const double h0 = window[i].s - window[i-1].s;
+		const double h1 = window[i+1].s - window[i].s;
+
+		const double b = 2.0 * (h0 + h1) - h0 * cPrime[i-1];
+		cPrime[i] = h1 / b;
+		dPrime[i] = (6.0 * ((window[i+1].y - window[i].y) / h1 - (window[i].y - window[i-1].y) / h0)
+				- h0 * dPrime[i-1]) / b;
+	}
+
+	if (naturalEnd) {
+		m[n-1].setZero();
+	} else {
+		m[n-1] = dPrime[n-2] / (1.0 + cPrime[n-2]);
+	}
+	for (size_t i = n-1; i-- > 0; ) {
+		m[i] = dPrime[i] - cPrime[i] * m[i+1];
+	}
+}
+
+template<typename T>
+void StreamingSpline<T>::pushSegment(const Knot& k0, const Knot& k1, const T& m0, const T& m1)
+{
+	const size_t h = head.load(boost::memory_order_relaxed);
+	Segment& seg = segments[h % segments.size()];
+
+	seg.start = k0.s;
+	seg.end = k1.s;
+	seg.c[0] = k0.y;
+	if (k1.s > k0.s) {
+		const double dt = k1.s - k0.s;
+		seg.c[1] = (k1.y - k0.y) / dt - (dt / 6.0) * (2.0 * m0 + m1);
+		seg.c[2] = 0.5 * m0;
+		seg.c[3] = (m1 - m0) / (6.0 * dt);
+
+		v0 = seg.c[1] + dt * (2.0 * seg.c[2] + (3.0 * dt) * seg.c[3]);
+	} else {
+		seg.c[1].setZero();
+		seg.c[2].setZero();
+		seg.c[3].setZero();
+	}
+
+	head.store(h + 1, boost::memory_order_release);
+	s_available.store(k1.s, boost::memory_order_release);
+}
+
+template<typename T>
+inline void StreamingSpline<T>::dropKnot()
+{
+	for (size_t i = 1; i < numWindowKnots; ++i) {
+		window[i-1] = window[i];
+	}
+	--numWindowKnots;
+}
+
+// Advances past (and releases) segments that end before s.
+template<typename T>
+inline const typename StreamingSpline<T>::Segment& StreamingSpline<T>::findSegment(double s, double* ds)
+{
+	const size_t h = head.load(boost::memory_order_acquire);
+	assert(h != 0);
+
+	size_t i = tail.load(boost::memory_order_relaxed);
+	while (i + 1 < h  &&  s >= segments[(i + 1) % segments.size()].start) {
+		++i;
+	}
+	tail.store(i, boost::memory_order_release);
+
+	const Segment& seg = segments[i % segments.size()];
+	if (sat  &&  s < seg.start) {
+		s = seg.start;
+	}
+	if (i + 1 == h  &&  s > seg.end  &&  (sat  ||  !isFinished())) {
+		s = seg.end;
+	}
+
+	*ds = s - seg.start;
+	return seg;
+}
+
+template<typename T>
+inline T StreamingSpline<T>::eval(double s)
+{
+	double ds;
+	const Segment& seg = findSegment(s, &ds);
+
+	T result;
+	result = seg.c[0] + ds * (seg.c[1] + ds * (seg.c[2] + ds * seg.c[3]));
+	return result;
+}
+
+template<typename T>
+inline T StreamingSpline<T>::evalDerivative(double s)
+{
+	double ds;
+	const Segment& seg = findSegment(s, &ds);
+
+	T result;
+	result = seg.c[1] + ds * (2.0 * seg.c[2] + (3.0 * ds) * seg.c[3]);
+	return result;
+}
+
+template<typename T>
+void StreamingSpline<T>::eval(double s, T* value, T* derivative, T* secondDerivative)
+{
+	double ds;
+	const Segment& seg = findSegment(s, &ds);
+
+	*value = seg.c[0] + ds * (seg.c[1] + ds * (seg.c[2] + ds * seg.c[3]));
+	if (derivative != NULL) {
+		*derivative = seg.c[1] + ds * (2.0 * seg.c[2] + (3.0 * ds) * seg.c[3]);
+	}
+	if (secondDerivative != NULL) {
+		*secondDerivative = 2.0 * seg.c[2] + (6.0 * ds) * seg.c[3];
+	}
+}
+
+
+}
+}
@@ -0,0 +1,268 @@
+/*
+ * trajectory_validator-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <boost/thread/thread.hpp>
+
+#include <barrett/os.h>
+#include <barrett/cdlbt/kinematics.h>
+#include <barrett/math/utils.h>
+
+
+namespace barrett {
+namespace math {
+
+
+template<size_t DOF>
+const double TrajectoryValidator<DOF>::DIFFERENCE_STEP = 1e-4;
+
+
+template<size_t DOF>
+TrajectoryValidator<DOF>::Limits::Limits() :
+	lowerJointLimit(-std::numeric_limits<double>::infinity()),
+	upperJointLimit(std::numeric_limits<double>::infinity()),
+	velocityLimit(0.0), torqueTransform(sqm_type::Identity()), torqueLimit(0.0)
+{
+}
+
+template<size_t DOF>
+TrajectoryValidator<DOF>::Report::Report() :
+	violation(NO_VIOLATION), time(0.0), index(0),
+	maxSpeed(0.0), maxTorqueRatio(0.0), timeScale(1.0)
+{
+}
+
+template<size_t DOF>
+TrajectoryValidator<DOF>::Worker::Worker(const libconfig::Setting& kinematicsSetting,
+		const libconfig::Setting& dynamicsSetting, const ca_type& gravity) :
+	kin(kinematicsSetting), dyn(dynamicsSetting)
+{
+	dyn.setGravity(gravity);
+}
+
+
+template<size_t DOF>
+TrajectoryValidator<DOF>::TrajectoryValidator(const libconfig::Setting& kinematicsSetting,
+		const libconfig::Setting& dynamicsSetting, const Limits& limits_,
+		double samplePeriod_, size_t threads, const ca_type& gravity) :
+	limits(limits_), samplePeriod(samplePeriod_)
+{
+	init(kinematicsSetting, dynamicsSetting, threads, gravity);
+}
+
+template<size_t DOF>
+TrajectoryValidator<DOF>::TrajectoryValidator(const libconfig::Setting& setting,
+		const Limits& limits_, double samplePeriod_, size_t threads,
+		const ca_type& gravity) :
+	limits(limits_), samplePeriod(samplePeriod_)
+{
+	init(setting["kinematics"], setting["dynamics"], threads, gravity);
+}
+
+template<size_t DOF>
+TrajectoryValidator<DOF>::~TrajectoryValidator()
+{
+	for (size_t i = 0; i < workers.size(); ++i) {
+		delete workers[i];
+	}
+}
+
+template<size_t DOF>
+void TrajectoryValidator<DOF>::init(const libconfig::Setting& kinematicsSetting,
+		const libconfig::Setting& dynamicsSetting, size_t threads,
+		const ca_type& gravity)
+{
+	if (samplePeriod <= 0.0) {
+		(logMessage("math::TrajectoryValidator::%s(): samplePeriod must be positive (got %f).")
+				% __func__ % samplePeriod).template raise<std::logic_error>();
+	}
+
+	if (threads == 0) {
+		threads = std::max(boost::thread::hardware_concurrency(), 1u);
+	}
+
+	// Kinematics and Dynamics keep their intermediate results internally, so
+	// each thread needs its own.
+	for (size_t i = 0; i < threads; ++i) {
+		workers.push_back(new Worker(kinematicsSetting, dynamicsSetting, gravity));
+	}
+}
+
+
+template<size_t DOF>
+typename TrajectoryValidator<DOF>::Report TrajectoryValidator<DOF>::validate(
+		const trajectory_type& trajectory, double duration)
+{
+	if (duration < 0.0) {
+		(logMessage("math::TrajectoryValidator::%s(): duration must not be negative (got %f).")
+				% __func__ % duration).template raise<std::logic_error>();
+	}
+
+	// Sample every samplePeriod, and at the end.
+	size_t n = static_cast<size_t>(std::ceil(duration / samplePeriod)) + 1;
+
+	// Each thread checks a contiguous range of samples, so the first violation
+	// a thread finds is the earliest in its range.
+	std::vector<Report> reports(workers.size());
+	size_t chunk = (n + workers.size() - 1) / workers.size();
+	if (workers.size() == 1) {
+		validateSamples(workers[0], &trajectory, duration, 0, n, &reports[0]);
+	} else {
+		boost::thread_group threads;
+		for (size_t i = 0; i < workers.size(); ++i) {
+			size_t begin = std::min(i * chunk, n);
+			threads.create_thread(boost::bind(&TrajectoryValidator::validateSamples, this,
+					workers[i], &trajectory, duration, begin, std::min(begin + chunk, n), &reports[i]));
+		}
+		threads.join_all();
+	}
+
+	Report report;
+	for (size_t i = 0; i < reports.size(); ++i) {
+		if (report.ok()  &&  !reports[i].ok()) {
+			report.violation = reports[i].violation;
+			report.time = reports[i].time;
+			report.index = reports[i].index;
+		}
+		report.maxSpeed = std::max(report.maxSpeed, reports[i].maxSpeed);
+		report.maxTorqueRatio = std::max(report.maxTorqueRatio, reports[i].maxTorqueRatio);
+		report.timeScale = std::max(report.timeScale, reports[i].timeScale);
+	}
+	return report;
+}
+
+template<size_t DOF>
+typename TrajectoryValidator<DOF>::trajectory_type TrajectoryValidator<DOF>::timeScaled(
+		const trajectory_type& trajectory, double timeScale)
+{
+	return boost::bind(trajectory, boost::bind(std::divides<double>(), _1, timeScale));
+}
+
+
+template<size_t DOF>
+void TrajectoryValidator<DOF>::validateSamples(Worker* worker,
+		const trajectory_type* trajectory, double duration, size_t begin,
+		size_t end, Report* report) const
+{
+	const double inf = std::numeric_limits<double>::infinity();
+
+	// Derivatives are taken from a 3-point stencil, [t0, t0 + h, t0 + 2h],
+	// that is centered on t unless that would leave [0, duration].
+	const double h = std::min(DIFFERENCE_STEP, duration / 2.0);
+
+	jp_type q[3];
+	cp_type positions[3][DOF + 1];  // Each link's origin, then the tool's
+
+	for (size_t i = begin; i < end; ++i) {
+		double t = std::min(i * samplePeriod, duration);
+		jp_type jp = (*trajectory)(t);
+		jv_type jv(0.0);
+		ja_type ja(0.0);
+		double speed = 0.0;
+		size_t fastest = 0;
+
+		if (h > 0.0) {
+			double t0 = saturate(t - h, 0.0, duration - 2.0 * h);
+			for (size_t k = 0; k < 3; ++k) {
+				q[k] = (*trajectory)(t0 + k * h);
+				evalLinkPositions(worker, q[k], positions[k]);
+			}
+
+			// Weights of the derivative of the quadratic through the stencil
+			double u = (t - t0) / h;
+			double c0 = (u - 1.5) / h;
+			double c1 = (2.0 - 2.0 * u) / h;
+			double c2 = (u - 0.5) / h;
+
+			jv = c0 * q[0] + c1 * q[1] + c2 * q[2];
+			ja = (q[0] - 2.0 * q[1] + q[2]) / (h * h);
+
+			for (size_t l = 0; l < DOF + 1; ++l) {
+				double s = (c0 * positions[0][l] + c1 * positions[1][l] + c2 * positions[2][l]).norm();
+				if (s > speed) {
+					speed = s;
+					fastest = l;
+				}
+			}
+		}
+
+
+		// Joint limits
+		for (size_t j = 0; j < DOF; ++j) {
+			if (jp[j] < limits.lowerJointLimit[j]  ||  jp[j] > limits.upperJointLimit[j]) {
+				if (report->ok()) {
+					report->violation = JOINT_LIMIT;
+					report->time = t;
+					report->index = j;
+				}
+				report->timeScale = inf;
+			}
+		}
+
+		// Velocity limit
+		report->maxSpeed = std::max(report->maxSpeed, speed);
+		if (limits.velocityLimit > 0.0  &&  speed > limits.velocityLimit) {
+			if (report->ok()) {
+				report->violation = VELOCITY_LIMIT;
+				report->time = t;
+				report->index = fastest;
+			}
+			report->timeScale = std::max(report->timeScale, speed / limits.velocityLimit);
+		}
+
+		// Torque limit
+		if (limits.torqueLimit > 0.0) {
+			worker->kin.eval(jp, jv);
+			jt_type jt = worker->dyn.evalInverse(worker->kin, jv, ja);
+			jt_type gravity = worker->dyn.evalInverse(worker->kin, jv_type(0.0), ja_type(0.0));
+
+			// Slowing the trajectory down by k scales the torque at this
+			// sample to a + b/k^2.
+			v_type a = limits.torqueTransform * gravity;
+			v_type b = limits.torqueTransform * (jt - gravity);
+			double minX = 1.0;  // The largest allowable 1/k^2
+			for (size_t p = 0; p < DOF; ++p) {
+				double ratio = std::abs(a[p] + b[p]) / limits.torqueLimit;
+				report->maxTorqueRatio = std::max(report->maxTorqueRatio, ratio);
+				if (ratio > 1.0  &&  report->ok()) {
+					report->violation = TORQUE_LIMIT;
+					report->time = t;
+					report->index = p;
+				}
+
+				if (std::abs(a[p]) >= limits.torqueLimit) {
+					minX = 0.0;
+				} else if (b[p] > 0.0) {
+					minX = std::min(minX, (limits.torqueLimit - a[p]) / b[p]);
+				} else if (b[p] < 0.0) {
+					minX = std::min(minX, (limits.torqueLimit + a[p]) / -b[p]);
+				}
+			}
+			report->timeScale = std::max(report->timeScale, minX > 0.0 ? 1.0 / std::sqrt(minX) : inf);
+		}
+	}
+}
+
+template<size_t DOF>
+void TrajectoryValidator<DOF>::evalLinkPositions(Worker* worker, const jp_type& jp,
+		cp_type* positions) const
+{
+	worker->kin.eval(jp, jv_type(0.0));
+	for (size_t l = 0; l < DOF; ++l) {
+		positions[l].copyFrom(worker->kin.impl->link[l]->origin_pos);
+	}
+	positions[DOF].copyFrom(worker->kin.impl->tool->origin_pos);
+}
+
+
+}
+}
@@ -35,12 +35,28 @@ public:
 
 	const jt_type& evalInverse(const Kinematics<DOF>& kin, const jv_type& jv, const ja_type& ja);
 
+	/** Sets the gravitational acceleration included by evalInverse(), in base
+	 * frame coordinates (for a WAM mounted upright, (0, 0, -9.81)).
+	 *
+	 * The default is zero, so that evalInverse() returns only the torques due
+	 * to the arm's motion.
+	 */
+	void setGravity(const ca_type& g);
+
+	/** Computes the joint-space inertia matrix (JSIM) at the configuration
+	 * last evaluated by \c kin.
+	 *
+	 * The result is symmetric and positive-definite.
+	 */
+	const sqm_type& evalJsim(const Kinematics<DOF>& kin);
+
 //	typedef const jt_type& result_type;  ///< For use with boost::bind().
 //	result_type operator() (const boost::tuple<jv_type, ja_type>& jointState);
 
 protected:
 	struct bt_dynamics* impl;
 	jt_type jt;
+	sqm_type jsim;
 
 private:
 	DISALLOW_COPY_AND_ASSIGN(Dynamics);
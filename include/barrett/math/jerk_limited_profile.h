@@ -0,0 +1,196 @@
+/*
+ * jerk_limited_profile.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_JERK_LIMITED_PROFILE_H_
+#define BARRETT_MATH_JERK_LIMITED_PROFILE_H_
+
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** A one-dimensional S-curve (jerk-limited) motion profile.
+ *
+ * Moves from an arbitrary initial state (position, velocity, and
+ * acceleration) to rest at a target position while respecting velocity,
+ * acceleration, and jerk limits. The profile is a sequence of at most seven
+ * constant-jerk segments: a velocity change to a peak (or cruise) velocity, an
+ * optional cruise, and a velocity change back to rest.
+ *
+ * Every velocity change is computed in closed form. When the move is too
+ * short to reach the velocity limit, the peak velocity is found by
+ * fixed-length golden-section and bisection searches. plan() therefore runs in
+ * bounded time and never
+ * allocates, so a move can be retargeted from within the real-time thread.
+ *
+ * Unlike TrapezoidalVelocityProfile, this class is copyable and does not
+ * depend on cdlbt.
+ */
+class JerkLimitedProfile {
+public:
+	/// Limits must be set with setLimits() before calling plan().
+	JerkLimitedProfile();
+	JerkLimitedProfile(double velocity, double acceleration, double jerk);
+	/// Equivalent to TrapezoidalVelocityProfile(velocity, acceleration, initialVelocity, pathLength) with a jerk limit.
+	JerkLimitedProfile(double velocity, double acceleration, double jerk,
+			double initialVelocity, double pathLength);
+
+	/// All limits must be strictly positive.
+	void setLimits(double velocity, double acceleration, double jerk);
+	double getVelocityLimit() const { return vMax; }
+	double getAccelerationLimit() const { return aMax; }
+	double getJerkLimit() const { return jMax; }
+
+	/** Plans the fastest move from (p0, v0, a0) to rest at pf.
+	 *
+	 * If |a0| exceeds the acceleration limit, the profile first brings the
+	 * acceleration back within the limit. Likewise, if a0 will carry the
+	 * velocity past its limit, the limit is exceeded only until the
+	 * acceleration can be brought to zero.
+	 */
+	void plan(double p0, double v0, double a0, double pf);
+	/** Plans a move from (p0, v0, a0) to rest at pf that takes duration seconds.
+	 *
+	 * The move is slowed by lowering its peak velocity, reversing its
+	 * direction if the initial state would otherwise carry it past pf.
+	 * Returns false if the move can't be made to last exactly duration
+	 * seconds, in which case the fastest move is planned and finalT() will be
+	 * less than duration (or greater, if duration is shorter than the fastest
+	 * move). Durations of at least shortestSlowedDuration() always succeed;
+	 * some shorter ones may not.
+	 */
+	bool plan(double p0, double v0, double a0, double pf, double duration);
+	/** The shortest duration such that plan(p0, v0, a0, pf, duration) succeeds for it and all longer ones.
+	 *
+	 * Returns infinity if the move can't be slowed at all because the axis
+	 * comes to rest exactly at pf on its own.
+	 */
+	double shortestSlowedDuration(double p0, double v0, double a0, double pf) const;
+
+	double finalT() const { return tf; }
+
+	double eval(double t) const;
+	void eval(double t, double* p, double* v, double* a) const;
+
+	typedef double result_type;  ///< For use with boost::bind().
+	result_type operator() (double t) const {
+		return eval(t);
+	}
+
+protected:
+	static const size_t MAX_SEGMENTS = 7;
+
+	// Start time, start state, and (constant) jerk of one segment
+	struct Segment {
+		double t, p, v, a, j;
+	};
+
+	struct VelocityChange {
+		double t[3];
+		double j[3];
+		double duration;
+		double displacement;
+	};
+
+	void planVelocityChange(double v0, double a0, double v1, VelocityChange* vc) const;
+	double peakDisplacement(double v0, double a0, double vPeak, double* duration) const;
+	double findPeakVelocity(double v0, double a0, double distance) const;
+	void findMonotonicPieces(double v0, double a0, double bounds[4]) const;
+	double findSlowPeakVelocity(double v0, double a0, double distance, double sign) const;
+	double findTurningPoint(double v0, double a0, double lo, double hi, double sign) const;
+	bool findRoot(double v0, double a0, double distance, double lo, double hi,
+			double* v, double* duration) const;
+	bool stretch(double p0, double v0, double a0, double pf, double duration,
+			double sign, double limit);
+	bool slowerThan(double v0, double a0, double distance, double peakVelocity,
+			double duration, double* cruiseTime) const;
+	double endPosition() const;
+	void build(double p0, double v0, double a0, double pf, double vPeak, double cruiseTime);
+
+	double vMax, aMax, jMax;
+
+	Segment segments[MAX_SEGMENTS];
+	size_t numSegments;
+	double vPeak, tf, p_f;
+};
+
+
+/** Time-synchronized JerkLimitedProfile%s for each coefficient of a math::Vector.
+ *
+ * Each axis follows its own S-curve, but all axes start and finish at the same
+ * time: the axis that needs the most time moves as fast as its limits allow
+ * and the others are slowed to match. If an axis's initial state leaves no
+ * slower move of exactly that duration, the whole move is lengthened until
+ * every axis has one. Moves that start at rest follow a straight line.
+ *
+ * @tparam T A fixed-size math::Vector type, such as units::JointPositions<DOF>::type.
+ */
+template<typename T>
+class SynchronizedJerkLimitedProfile {
+public:
+	typedef typename T::unitless_type unitless_type;
+
+	/// The same limits are used for every axis.
+	SynchronizedJerkLimitedProfile(double velocity, double acceleration, double jerk);
+	SynchronizedJerkLimitedProfile(const unitless_type& velocity,
+			const unitless_type& acceleration, const unitless_type& jerk);
+
+	void setLimits(const unitless_type& velocity,
+			const unitless_type& acceleration, const unitless_type& jerk);
+
+	/** Plans a synchronized move from (p0, v0, a0) to rest at pf.
+	 *
+	 * Returns false if some axis still couldn't be slowed to match (because
+	 * it comes to rest exactly on target by itself). That axis finishes early.
+	 */
+	bool plan(const T& p0, const unitless_type& v0, const unitless_type& a0, const T& pf);
+
+	double finalT() const { return tf; }
+
+	T eval(double t) const;
+	void eval(double t, T* p, unitless_type* v, unitless_type* a) const;
+
+	typedef T result_type;  ///< For use with boost::bind().
+	result_type operator() (double t) const {
+		return eval(t);
+	}
+
+	const unitless_type& getVelocityLimit() const { return vMax; }
+	const unitless_type& getAccelerationLimit() const { return aMax; }
+	const unitless_type& getJerkLimit() const { return jMax; }
+	const JerkLimitedProfile& getProfile(size_t i) const { return profiles[i]; }
+
+protected:
+	void planFromRest(const T& p0, const T& pf);
+
+	unitless_type vMax, aMax, jMax;
+	JerkLimitedProfile profiles[T::SIZE];
+	double tf;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SynchronizedJerkLimitedProfile);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/jerk_limited_profile-inl.h>
+
+
+#endif /* BARRETT_MATH_JERK_LIMITED_PROFILE_H_ */
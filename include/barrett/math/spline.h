@@ -42,6 +42,7 @@
 #include <Eigen/Geometry>
 
 #include <barrett/detail/ca_macro.h>
+#include <barrett/math/utils.h>
 #include <barrett/math/detail/spline-helper.h>
 
 
@@ -72,8 +73,13 @@ public:
 	double finalS() const { return s_f; }
 	double changeInS() const;
 
+	// Evaluation only reads the precomputed coefficient table, so it is
+	// thread-safe and doesn't allocate.
 	T eval(double s) const;
 	T evalDerivative(double s) const;
+	T evalSecondDerivative(double s) const;
+	/// Evaluates the spline and its derivatives with a single segment lookup. Pass NULL to skip a derivative.
+	void eval(double s, T* value, T* derivative, T* secondDerivative = NULL) const;
 
 	typedef T result_type;  ///< For use with boost::bind().
 	result_type operator() (double s) const {
@@ -84,10 +90,22 @@ public:
 	struct bt_spline* getImplementation() { return impl; }
 
 protected:
+	typedef Eigen::Map<const typename T::Base> coefficient_map_type;
+
+	void computeCoefficients();
+	double clampS(double s) const { return sat ? saturate(s, s_0, s_f) : s; }
+	const double* findSegment(double s, double* ds) const;
+
 	struct bt_spline* impl;
 	bool sat;
 	double s_0, s_f;
 
+	int dimension;
+	std::vector<double> knots;  // Relative to s_0
+	// Per-segment cubic coefficients in powers of (s - knot), laid out as
+	// [segment][power][coordinate] so each power is a contiguous vector.
+	std::vector<double> coefficients;
+
 private:
 	// TODO(dc): write a real copy constructor and assignment operator?
 	DISALLOW_COPY_AND_ASSIGN(Spline);
@@ -101,6 +119,20 @@ public:
 	typedef Eigen::Quaternion<Scalar> data_type;
 	typedef boost::tuple<double, data_type> tuple_type;
 
+	/** Remembers the segment of the most recent evaluation.
+	 *
+	 * Evaluation is const and thread-safe. Each thread that evaluates the
+	 * Spline at nearby values of s (for instance, during playback) can keep its
+	 * own Cursor to skip the binary search.
+	 */
+	class Cursor {
+	public:
+		Cursor() : index(0) {}
+	protected:
+		size_t index;
+		friend class Spline;
+	};
+
 	template<template<typename, typename> class Container, typename Allocator>
 	Spline(const Container<tuple_type, Allocator>& samples, bool saturateS = true);
 
@@ -108,11 +140,14 @@ public:
 	template<template<typename, typename> class Container, typename Allocator>
 	Spline(const Container<data_type, Allocator>& points, bool saturateS = true);
 
-	double initialS() const { return boost::get<0>(data.front()); }
-	double finalS() const { return boost::get<0>(data.back()); }
+	double initialS() const { return knots.front(); }
+	double finalS() const { return knots.back(); }
 	double changeInS() const { return finalS() - initialS(); }
 
+	/// O(log n) in the number of samples.
 	data_type eval(double s) const;
+	/// Amortized O(1) when successive values of s are close together.
+	data_type eval(double s, Cursor* cursor) const;
 
 	typedef data_type result_type;  ///< For use with boost::bind().
 	result_type operator() (double s) const {
@@ -120,12 +155,25 @@ public:
 	}
 
 protected:
-	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > data;
+	// Precomputed parameters for Eigen::Quaternion::slerp() between two samples
+	struct Segment {
+		data_type q0, q1;  // q1's sign is chosen to take the shorter path
+		double rate;  // 1 / (change in s)
+		Scalar theta, invSinTheta;
+		bool linear;  // q0 and q1 are too close to use the sine formula
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	void init();
+	size_t findSegment(double s) const;
+	data_type evalSegment(size_t i, double s) const;
+
+	std::vector<double> knots;
+	std::vector<data_type, Eigen::aligned_allocator<data_type> > points;
+	std::vector<Segment, Eigen::aligned_allocator<Segment> > segments;
 	bool sat;
 
-	mutable size_t index;
-	mutable double rate;
-
 private:
 	// TODO(dc): write a real copy constructor and assignment operator?
 	DISALLOW_COPY_AND_ASSIGN(Spline);
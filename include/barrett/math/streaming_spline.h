@@ -0,0 +1,147 @@
+/*
+ * streaming_spline.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_STREAMING_SPLINE_H_
+#define BARRETT_MATH_STREAMING_SPLINE_H_
+
+
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#define EIGEN_USE_NEW_STDVECTOR
+#include <Eigen/StdVector>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** A cubic spline that is built from a stream of samples and evaluated while it is being built.
+ *
+ * math::Spline solves for the whole curve at once, so every sample must be
+ * loaded before the first evaluation. StreamingSpline instead finalizes each
+ * segment as soon as lookahead more samples have arrived, by solving for a
+ * spline over just that window whose left end is clamped to the slope of the
+ * previous segment. The result is C1 continuous. Because the influence of
+ * later samples decays geometrically, its second derivative is continuous to
+ * within a small tolerance and it differs negligibly from the global natural
+ * spline for the default lookahead.
+ *
+ * Finalized segments are kept in a fixed-capacity ring. One thread may add()
+ * samples while another evaluates the spline; segments behind the most recent
+ * evaluation are released for reuse, so memory use does not depend on the
+ * length of the stream. add() returns false (and should be retried later) if
+ * the ring is full. Evaluation never blocks and doesn't allocate, but s must
+ * not decrease between calls.
+ *
+ * Before finish() is called, evaluation beyond availableS() holds the last
+ * finalized position.
+ *
+ * @tparam T A fixed-size math::Vector type, such as units::JointPositions<DOF>::type.
+ */
+template<typename T>
+class StreamingSpline {
+public:
+	typedef T data_type;
+	typedef boost::tuple<double, T> tuple_type;
+
+	static const size_t DEFAULT_CAPACITY = 1024;  ///< Segments
+	static const size_t DEFAULT_LOOKAHEAD = 8;  ///< Samples
+
+	explicit StreamingSpline(size_t capacity = DEFAULT_CAPACITY,
+			size_t lookahead = DEFAULT_LOOKAHEAD, bool saturateS = true);
+
+	/// Appends a sample. s must be strictly increasing. Returns false if the sample couldn't be accepted yet.
+	bool add(double s, const T& point);
+	bool add(const tuple_type& sample) {
+		return add(boost::get<0>(sample), boost::get<1>(sample));
+	}
+	/// Finalizes the remaining segments with a natural end. Returns false if there wasn't room yet.
+	bool finish();
+	bool isFinished() const { return finished.load(boost::memory_order_acquire); }
+
+	/// Discards all samples. Must not be called concurrently with add() or eval().
+	void clear();
+
+	/// True once at least one segment can be evaluated.
+	bool isReady() const { return head.load(boost::memory_order_acquire) != 0; }
+
+	// Only valid once isReady() returns true
+	double initialS() const { return s_0; }
+	double availableS() const { return s_available.load(boost::memory_order_acquire); }
+	/// Only valid once isFinished() returns true.
+	double finalS() const { return availableS(); }
+
+	// Must only be called from one thread at a time, with non-decreasing s,
+	// once isReady() returns true.
+	T eval(double s);
+	T evalDerivative(double s);
+	void eval(double s, T* value, T* derivative, T* secondDerivative = NULL);
+
+	typedef T result_type;  ///< For use with boost::bind().
+	result_type operator() (double s) {
+		return eval(s);
+	}
+
+protected:
+	struct Knot {
+		double s;
+		T y;
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	// A cubic in powers of (s - start)
+	struct Segment {
+		double start, end;
+		T c[4];
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	void solveWindow(size_t numKnots, bool naturalEnd);
+	void pushSegment(const Knot& k0, const Knot& k1, const T& m0, const T& m1);
+	void dropKnot();
+	const Segment& findSegment(double s, double* ds);
+
+	const size_t lookahead;
+	bool sat;
+	double s_0;
+
+	// Producer side
+	std::vector<Knot, Eigen::aligned_allocator<Knot> > window;
+	size_t numWindowKnots;
+	T v0;  // Slope at window[0], fixed by the previous segment
+	std::vector<T, Eigen::aligned_allocator<T> > m, dPrime;
+	std::vector<double> cPrime;
+
+	std::vector<Segment, Eigen::aligned_allocator<Segment> > segments;
+	boost::atomic<size_t> head;  // Segments published
+	boost::atomic<size_t> tail;  // Segments released by the consumer
+	boost::atomic<double> s_available;
+	boost::atomic<bool> finished;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(StreamingSpline);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/streaming_spline-inl.h>
+
+
+#endif /* BARRETT_MATH_STREAMING_SPLINE_H_ */
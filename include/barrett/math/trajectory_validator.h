@@ -0,0 +1,190 @@
+/*
+ * trajectory_validator.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_TRAJECTORY_VALIDATOR_H_
+#define BARRETT_MATH_TRAJECTORY_VALIDATOR_H_
+
+
+#include <vector>
+
+#include <libconfig.h++>
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/kinematics.h>
+#include <barrett/math/dynamics.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** Checks a joint-space trajectory against the WAM's limits before it is
+ * executed.
+ *
+ * The trajectory is sampled every samplePeriod seconds. At each sample, the
+ * validator checks:
+ *   - the joint positions against Limits::lowerJointLimit and
+ *     Limits::upperJointLimit;
+ *   - the speed of the origin of every link and of the tool against
+ *     Limits::velocityLimit, the limit given to
+ *     SafetyModule::setVelocityLimit();
+ *   - the torque the arm's inverse dynamics (including gravity) requires,
+ *     mapped through Limits::torqueTransform, against Limits::torqueLimit.
+ *
+ * Joint velocities and accelerations are found by differentiating the
+ * trajectory numerically, so any function of time can be validated. The
+ * samples are divided among several threads, each with its own Kinematics
+ * and Dynamics, so the trajectory must be safe to evaluate from many threads
+ * at once. (math::Spline, JerkLimitedProfile, and TrapezoidalVelocityProfile
+ * are.)
+ *
+ * Besides the earliest violation, the Report gives the smallest factor by
+ * which the trajectory can be slowed down to remove its velocity and torque
+ * violations. Slowing a trajectory by k divides its velocities by k and the
+ * non-gravitational part of its torques by k^2. timeScaled() applies the
+ * factor.
+ *
+ * Example:
+ *   math::TrajectoryValidator<DOF>::Limits limits;
+ *   limits.velocityLimit = 1.5;
+ *   limits.torqueTransform = wam.llww.getLowLevelWam().getJointToPuckTorqueTransform();
+ *   limits.torqueLimit = MotorPuck::MAX_PUCK_TORQUE;
+ *   math::TrajectoryValidator<DOF> validator(
+ *       pm.getConfig().lookup(pm.getWamDefaultConfigPath()), limits);
+ *
+ *   math::TrajectoryValidator<DOF>::Report report = validator.validate(spline, profile);
+ *   if (report.timeScale == std::numeric_limits<double>::infinity()) {
+ *       ... the trajectory can't be executed ...
+ *   }
+ *
+ * The torques are those needed to follow the trajectory exactly; the
+ * controller's corrections aren't included, so limits should leave a margin.
+ */
+template<size_t DOF>
+class TrajectoryValidator {
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+public:
+	typedef boost::function<jp_type (double)> trajectory_type;
+
+	struct Limits {
+		/// Joint limits default to +/- infinity, and the other limits to 0.0 (unchecked).
+		Limits();
+
+		jp_type lowerJointLimit, upperJointLimit;  // rad
+		double velocityLimit;  // m/s
+		sqm_type torqueTransform;  // Maps joint torques to the units of torqueLimit. Defaults to identity.
+		double torqueLimit;
+	};
+
+	enum Violation {
+		NO_VIOLATION,
+		JOINT_LIMIT,  ///< index is the joint
+		VELOCITY_LIMIT,  ///< index is the link (DOF for the tool)
+		TORQUE_LIMIT  ///< index is the row of torqueTransform (the Puck)
+	};
+
+	struct Report {
+		Report();
+
+		bool ok() const { return violation == NO_VIOLATION; }
+
+		Violation violation;  // The earliest violation
+		double time;
+		size_t index;
+
+		double maxSpeed;  // m/s
+		double maxTorqueRatio;  // The largest |torque| / torqueLimit
+
+		/** The smallest factor (>= 1) by which to slow the trajectory down to
+		 * remove its velocity and torque violations, or infinity if slowing it
+		 * down can't help (a joint limit is exceeded, or gravity alone exceeds
+		 * the torque limit).
+		 */
+		double timeScale;
+	};
+
+
+	/** kinematicsSetting and dynamicsSetting are the WAM's "kinematics" and
+	 * "dynamics" configuration groups. threads defaults to the number of cores.
+	 */
+	TrajectoryValidator(const libconfig::Setting& kinematicsSetting,
+			const libconfig::Setting& dynamicsSetting, const Limits& limits,
+			double samplePeriod = 0.002, size_t threads = 0,
+			const ca_type& gravity = ca_type(0.0, 0.0, -9.81));
+	/// setting is the WAM's configuration group (containing "kinematics" and "dynamics").
+	TrajectoryValidator(const libconfig::Setting& setting, const Limits& limits,
+			double samplePeriod = 0.002, size_t threads = 0,
+			const ca_type& gravity = ca_type(0.0, 0.0, -9.81));
+	~TrajectoryValidator();
+
+	const Limits& getLimits() const { return limits; }
+	void setLimits(const Limits& newLimits) { limits = newLimits; }
+	double getSamplePeriod() const { return samplePeriod; }
+	size_t getThreadCount() const { return workers.size(); }
+
+	/// Validates trajectory(t) for t from 0.0 to duration.
+	Report validate(const trajectory_type& trajectory, double duration);
+
+	/// Validates spline(profile(t)) for t from 0.0 to profile.finalT().
+	template<typename ProfileType>
+	Report validate(const Spline<jp_type>& spline, const ProfileType& profile) {
+		return validate(
+				boost::bind(boost::cref(spline), boost::bind(boost::cref(profile), _1)),
+				profile.finalT());
+	}
+
+	/// The trajectory slowed down by timeScale. Its duration is timeScale times the original's.
+	static trajectory_type timeScaled(const trajectory_type& trajectory, double timeScale);
+
+	/// The step used to differentiate trajectories numerically (s)
+	static const double DIFFERENCE_STEP;
+
+protected:
+	struct Worker {
+		Worker(const libconfig::Setting& kinematicsSetting,
+				const libconfig::Setting& dynamicsSetting, const ca_type& gravity);
+
+		Kinematics<DOF> kin;
+		Dynamics<DOF> dyn;
+	};
+
+	void init(const libconfig::Setting& kinematicsSetting,
+			const libconfig::Setting& dynamicsSetting, size_t threads,
+			const ca_type& gravity);
+
+	// Checks samples [begin, end) and stores the results in report.
+	void validateSamples(Worker* worker, const trajectory_type* trajectory,
+			double duration, size_t begin, size_t end, Report* report) const;
+	// Finds the link and tool positions of jp.
+	void evalLinkPositions(Worker* worker, const jp_type& jp, cp_type* positions) const;
+
+	Limits limits;
+	double samplePeriod;
+	std::vector<Worker*> workers;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TrajectoryValidator);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/trajectory_validator-inl.h>
+
+
+#endif /* BARRETT_MATH_TRAJECTORY_VALIDATOR_H_ */
@@ -0,0 +1,99 @@
+/*
+ * triangle_mesh.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_TRIANGLE_MESH_H_
+#define BARRETT_MATH_TRIANGLE_MESH_H_
+
+
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <barrett/math/aabb_tree.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** A closed triangle mesh that can be queried for penetration.
+ *
+ * Meshes are loaded from STL (ASCII or binary) or Wavefront OBJ files, or
+ * built from vertex and triangle lists. Coincident vertices are merged, and
+ * angle-weighted pseudonormals are computed for every face, edge, and vertex
+ * so that the inside of the mesh can be told from the outside by looking only
+ * at the nearest triangle. The triangles are indexed by an AabbTree.
+ *
+ * The mesh should be closed and consistently wound with counterclockwise
+ * (outward-facing) triangles, as CAD exporters produce.
+ */
+class TriangleMesh {
+public:
+	typedef AabbTree::vector_type vector_type;
+
+	struct Triangle {
+		Triangle() {}
+		Triangle(size_t a, size_t b, size_t c) { v[0] = a; v[1] = b; v[2] = c; }
+
+		size_t v[3];  // Vertex indices
+	};
+
+	TriangleMesh() {}
+	/** Loads an .stl or .obj file, multiplying its coordinates by scale.
+	 *
+	 * STL files from CAD packages are usually in millimeters, so a scale of
+	 * 0.001 is often needed. Throws std::runtime_error if the file can't be
+	 * read.
+	 */
+	explicit TriangleMesh(const std::string& fileName, double scale = 1.0) { load(fileName, scale); }
+	TriangleMesh(const std::vector<vector_type>& vertices, const std::vector<Triangle>& triangles) {
+		build(vertices, triangles);
+	}
+
+	void load(const std::string& fileName, double scale = 1.0);
+	void build(const std::vector<vector_type>& vertices, const std::vector<Triangle>& triangles);
+
+	const std::vector<vector_type>& getVertices() const { return vertices; }
+	const std::vector<Triangle>& getTriangles() const { return triangles; }
+	/// Only valid if the mesh isn't empty.
+	const AabbTree::Box& getBounds() const { return tree.getBounds(); }
+	bool empty() const { return triangles.empty(); }
+
+	/** If p is inside the mesh, and no more than maxDepth from its surface,
+	 * sets depth and the unit direction towards the nearest point on the
+	 * surface, and returns true.
+	 *
+	 * Only the triangles with bounds within maxDepth of p are examined, so the
+	 * cost depends on the local density of the mesh rather than on its size.
+	 * Doesn't allocate, and may be called from any number of threads.
+	 */
+	bool penetration(const vector_type& p, double maxDepth, double* depth, vector_type* direction) const;
+
+protected:
+	struct Nearest;
+
+	/// Returns the point of triangle t nearest to p, and the pseudonormal of the
+	/// face, edge, or vertex it lies on.
+	vector_type closestPoint(size_t t, const vector_type& p, const vector_type** normal) const;
+
+	std::vector<vector_type> vertices;
+	std::vector<Triangle> triangles;
+
+	// Pseudonormals
+	std::vector<vector_type> faceNormals;
+	std::vector<vector_type> edgeNormals;  // 3 per triangle: edge i is from v[i] to v[(i+1)%3]
+	std::vector<vector_type> vertexNormals;
+
+	AabbTree tree;
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_MATH_TRIANGLE_MESH_H_ */
@@ -67,7 +67,7 @@ LowLevelWam<DOF>::LowLevelWam(const std::vector<Puck*>& _pucks, SafetyModule* _s
 	safetyModule(_safetyModule), torqueGroups(),
 	home(setting["home"]), j2mp(setting["j2mp"]),
 	noJointEncoders(true), positionSensor(PS_MOTOR_ENCODER),
-	lastUpdate(0.0), torquePropId(group.getPropertyId(Puck::T))
+	lastUpdate(0.0), updateRequested(false), positionPropId(group.getPropertyId(Puck::P)), torquePropId(group.getPropertyId(Puck::T))
 {
 	logMessage("  Config setting: %s => \"%s\"") % setting.getSourceFile() % setting.getPath();
 
@@ -285,27 +285,56 @@ void LowLevelWam<DOF>::setPositionSensor(enum PositionSensor sensor)
 }
 
 
+template<size_t DOF>
+void LowLevelWam<DOF>::requestUpdate()
+{
+	BARRETT_SCOPED_LOCK(bus.getMutex());
+	if ( !updateRequested ) {
+		group.sendGetPropertyRequest(positionPropId);
+		updateRequested = true;
+	}
+}
+
 template<size_t DOF>
 void LowLevelWam<DOF>::update()
 {
+	// Use the time at which the replies arrived, if the bus records it, so that
+	// scheduling jitter doesn't show up in the velocity estimate.
 	double now = highResolutionSystemTime();
+	double receiveTime;
 
 	if (noJointEncoders) {
 		// Changing realtime to false. If this thread never yields, there is a chance the CAN request will never go out.
 		//group.getProperty<MotorPuck::MotorPositionParser<double> >(Puck::P, pp.data(), true);
-		group.getProperty<MotorPuck::MotorPositionParser<double> >(Puck::P, pp.data(), false);
+		{
+			BARRETT_SCOPED_LOCK(bus.getMutex());
+			if ( !updateRequested ) {
+				group.sendGetPropertyRequest(positionPropId);
+			}
+			updateRequested = false;
+			group.receiveGetPropertyReply<MotorPuck::MotorPositionParser<double> >(positionPropId, pp.data(), false);
+			receiveTime = bus.getLastReceiveTime();
+		}
 		jp_motorEncoder = p2jp * pp;  // Convert from Puck positions to joint positions
 		jp_best = jp_motorEncoder;
 	} else {
 		// Make sure the reinterpret_cast below makes sense.
 		BOOST_STATIC_ASSERT(sizeof(MotorPuck::CombinedPositionParser<double>::result_type) == 2*sizeof(double));
 
-		// PuckGroup::getProperty() will fill pp_jep.data() with 2*DOF doubles:
+		// PuckGroup::receiveGetPropertyReply() will fill pp_jep.data() with 2*DOF doubles:
 		// Primary Encoder 1, Secondary Encoder 1, Primary Encoder 2, Secondary Encoder 2, ...
-		group.getProperty<MotorPuck::CombinedPositionParser<double> >(
-				Puck::P,
-				reinterpret_cast<MotorPuck::CombinedPositionParser<double>::result_type*>(pp_jep.data()),
-				false);
+		{
+			BARRETT_SCOPED_LOCK(bus.getMutex());
+			if ( !updateRequested ) {
+				group.sendGetPropertyRequest(positionPropId);
+			}
+			updateRequested = false;
+			group.receiveGetPropertyReply<MotorPuck::CombinedPositionParser<double> >(
+					positionPropId,
+					reinterpret_cast<MotorPuck::CombinedPositionParser<double>::result_type*>(pp_jep.data()),
+					false);
+			receiveTime = bus.getLastReceiveTime();
+		}
 		jp_motorEncoder = p2jp * pp_jep.col(0);
 
 		for (size_t i = 0; i < DOF; ++i) {
@@ -323,6 +352,9 @@ void LowLevelWam<DOF>::update()
 		}
 	}
 
+	if (receiveTime != 0.0) {
+		now = receiveTime;
+	}
 	jv_best = (jp_best - jp_best_1) / (now - lastUpdate);
 	// TODO(dc): Detect unreasonably large velocities
 
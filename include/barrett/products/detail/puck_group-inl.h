@@ -30,6 +30,8 @@
  * 
  */
 
+#include <stdexcept>
+
 #include <barrett/os.h>
 #include <boost/thread/locks.hpp>
 
@@ -84,4 +86,51 @@ void PuckGroup::receiveGetPropertyReply(int propId, typename Parser::result_type
 }
 
 
+template<typename Parser>
+void PuckGroup::PropertyBatch::add(enum Puck::Property prop, typename Parser::result_type results_[])
+{
+	if (numProperties == MAX_PROPERTIES) {
+		const size_t MP = MAX_PROPERTIES;  // Reserve storage for static const.
+		(logMessage("PuckGroup::PropertyBatch::%s(): Too many properties. "
+				"A PropertyBatch holds at most %d.")
+				% __func__ % MP).template raise<std::logic_error>();
+	}
+
+	propIds[numProperties] = group.getPropertyId(prop);
+	results[numProperties] = results_;
+	receiveFunctions[numProperties] = &receiveHelper<Parser>;
+	++numProperties;
+}
+
+inline void PuckGroup::PropertyBatch::update(bool realtime) const
+{
+	BARRETT_SCOPED_LOCK(group.bus.getMutex());
+
+	send();
+	receive(realtime);
+}
+
+inline void PuckGroup::PropertyBatch::send() const
+{
+	for (size_t i = 0; i < numProperties; ++i) {
+		group.sendGetPropertyRequest(propIds[i]);
+	}
+}
+
+inline void PuckGroup::PropertyBatch::receive(bool realtime) const
+{
+	for (size_t i = 0; i < numProperties; ++i) {
+		receiveFunctions[i](group, propIds[i], results[i], realtime);
+	}
+}
+
+template<typename Parser>
+void PuckGroup::PropertyBatch::receiveHelper(const PuckGroup& group, int propId,
+		void* results, bool realtime)
+{
+	group.receiveGetPropertyReply<Parser>(propId,
+			static_cast<typename Parser::result_type*>(results), realtime);
+}
+
+
 }
@@ -51,7 +51,7 @@ public:
 	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
 
 	/** ForceTorqueSensor Constructor */
-	ForceTorqueSensor(Puck* puck = NULL) : SpecialPuck(/* TODO(dc): Puck::PT_ForceTorque */), bus(NULL) { setPuck(puck); }
+	ForceTorqueSensor(Puck* puck = NULL) : SpecialPuck(/* TODO(dc): Puck::PT_ForceTorque */), bus(NULL), forceReceived(false) { setPuck(puck); }
 	/** ForceTorqueSensor Destructor */
 	~ForceTorqueSensor() {}
 	
@@ -61,6 +61,14 @@ public:
 	void tare() { Puck::setProperty(*bus, id, propId, 0); }
 	/** update Method establishes new force and torque values from the sensor */
 	void update(bool realtime = false);
+	/** requestUpdate Method asks the sensor for new force and torque values without waiting for them */
+	void requestUpdate();
+	/** receiveUpdate Method collects the values asked for by requestUpdate(). If blocking is false and they
+	 * haven't all arrived, returns false instead of waiting; call it again later to collect the rest. */
+	bool receiveUpdate(bool blocking = true, bool realtime = false);
+	/** cancelUpdate Method abandons the values asked for by requestUpdate() and discards any of their replies that
+	 * have already arrived, so a later receiveUpdate() doesn't pair a stale reply with a new one. */
+	void cancelUpdate(bool realtime = false);
 	/** getForce Method returns cartesian force values for each axis in n/m */
 	const cf_type& getForce() const { return cf; }
 	/** getTorque Method returns cartesian torque values for each axis in torque units */
@@ -112,6 +120,7 @@ protected:
 	const bus::CommunicationsBus* bus;
 	int id;
 	int propId;
+	bool forceReceived;
 
 	cf_type cf;
 	ct_type ct;
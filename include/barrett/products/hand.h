@@ -113,6 +113,10 @@ public:
 	static const unsigned int S_ALL = S_POSITION | S_FINGERTIP_TORQUE | S_TACT_FULL;
 	/** update Method */
 	void update(unsigned int sensors = S_ALL, bool realtime = false);
+	typedef MotorPuck::CombinedPositionParser<int>::result_type encoder_type;
+	/** updatePosition Method converts one Puck::P reading per Puck into link positions. update() calls this; it is
+	 *  public for code that requests P itself, such as systems::HandSensors. */
+	void updatePosition(const encoder_type encoders[]);
 	/** getInnerLinkPosition Method */
 	const jp_type& getInnerLinkPosition() const { return innerJp; }
 	/** getOuterLinkPosition Method */
@@ -160,7 +164,7 @@ protected:
 	v_type j2pp, j2pt;
 	mutable v_type pt;
 
-	std::vector<MotorPuck::CombinedPositionParser<int>::result_type> encoderTmp;
+	std::vector<encoder_type> encoderTmp;
 	std::vector<int> primaryEncoder, secondaryEncoder;
 	jp_type innerJp, outerJp;
 	std::vector<int> ftt;
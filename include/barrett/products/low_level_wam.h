@@ -66,6 +66,8 @@ public:
 	enum PositionSensor { PS_BEST, PS_MOTOR_ENCODER, PS_JOINT_ENCODER };
 	const jp_type& getJointPositions(enum PositionSensor sensor = PS_BEST) const;
 	const jv_type& getJointVelocities() const { return jv_best; }
+	/// The highResolutionSystemTime() at which the current joint positions were received (see CommunicationsBus::getLastReceiveTime()).
+	double getLastUpdateTime() const { return lastUpdate; }
 
 
 	bool hasJointEncoders() const { return !noJointEncoders; }
@@ -86,6 +88,13 @@ public:
 	const v_type& getJointEncoderToJointPositionTransform() const { return jointEncoder2jp; }
 
 
+	/** Sends the position request that the next update() would otherwise send itself.
+	 *
+	 * update() then only has to collect the replies. Used to overlap the round
+	 * trips of several buses (see MultiProductManager). Does nothing if a
+	 * request is already outstanding.
+	 */
+	void requestUpdate();
 	void update();
 	void setTorques(const jt_type& jt);
 	void definePosition(const jp_type& jp);
@@ -107,6 +116,8 @@ protected:
 	enum PositionSensor positionSensor;
 
 	double lastUpdate;
+	bool updateRequested;
+	int positionPropId;
 	v_type pp;
 	math::Matrix<DOF,2> pp_jep;
 	jp_type jp_motorEncoder, jp_jointEncoder;
@@ -0,0 +1,94 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file multi_product_manager.h
+ * @date 10/19/2026
+ *
+ */
+
+#ifndef BARRETT_PRODUCTS_MULTI_PRODUCT_MANAGER_H_
+#define BARRETT_PRODUCTS_MULTI_PRODUCT_MANAGER_H_
+
+
+#include <string>
+#include <vector>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/products/product_manager.h>
+
+
+namespace barrett {
+
+/** Manages the Products on several buses from one process.
+ *
+ * There is one ProductManager per bus, and they all share one
+ * RealTimeExecutionManager, so the Systems connected to every bus's Products
+ * form a single graph that is executed once per cycle.
+ *
+ * Most of a WAM's execution cycle is spent waiting for the replies to its
+ * position request. At the start of each cycle, before any other System
+ * runs, the position requests for every bus's WAM are sent (see
+ * ProductManager::requestWamUpdate()). Each bus then only has to collect its
+ * replies, so the round trips happen in parallel rather than one after the
+ * other and the cycle takes about as long as it would with a single bus.
+ *
+ * Use the ProductManagers as usual (waitForWam(), getWam4(), getHand(), ...),
+ * but call cleanUpAfterEstop() and startExecutionManager() here rather than
+ * on the individual ProductManagers.
+ */
+class MultiProductManager {
+public:
+	/// One ProductManager per entry in configFiles. An empty string selects ProductManager::DEFAULT_CONFIG_FILE.
+	explicit MultiProductManager(const std::vector<std::string>& configFiles,
+			double period_s = ProductManager::DEFAULT_LOOP_PERIOD, int rt_priority = 50);
+	~MultiProductManager();
+
+	size_t size() const { return pms.size(); }
+	ProductManager& getProductManager(size_t i);
+	ProductManager& operator[] (size_t i) { return getProductManager(i); }
+
+	systems::RealTimeExecutionManager* getExecutionManager() { return rtem; }
+	void startExecutionManager();
+
+	/// Stops the execution manager, then calls ProductManager::cleanUpAfterEstop() on each bus.
+	void cleanUpAfterEstop();
+
+protected:
+	class Prefetcher;
+
+	std::vector<ProductManager*> pms;
+	systems::RealTimeExecutionManager* rtem;
+	Prefetcher* prefetcher;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(MultiProductManager);
+};
+
+
+}
+
+
+#endif /* BARRETT_PRODUCTS_MULTI_PRODUCT_MANAGER_H_ */
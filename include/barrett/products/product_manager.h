@@ -43,6 +43,7 @@
 #include <barrett/thread/abstract/mutex.h>
 #include <barrett/bus/abstract/communications_bus.h>
 #include <barrett/products/puck.h>
+#include <barrett/products/puck_cache.h>
 #include <barrett/products/hand.h>
 #include <barrett/products/gimbals_hand_controller.h>
 #include <barrett/products/safety_module.h>
@@ -64,6 +65,8 @@ class RealTimeExecutionManager;
 class ProductManager {
 public:
 	static const std::string DEFAULT_CONFIG_FILE;  // = "/etc/barrett/default.conf"
+	/// Used unless the config file gives "bus.puck_cache". Buses with different Pucks need different files.
+	static const std::string DEFAULT_PUCK_CACHE_FILE;  // = "/etc/barrett/puck_cache"
 
 	explicit ProductManager(const char* configFile = NULL, bus::CommunicationsBus* bus = NULL);
 	virtual ~ProductManager();
@@ -92,6 +95,19 @@ public:
 	systems::RealTimeExecutionManager* getExecutionManager(
 			double period_s = DEFAULT_LOOP_PERIOD, int rt_priority = 50);
 	void startExecutionManager();
+	/** Makes getExecutionManager() return em instead of creating its own.
+	 *
+	 * The ProductManager won't delete em. Call before creating any Products
+	 * that use the execution manager. Used by MultiProductManager to run the
+	 * Products of several buses in one execution cycle.
+	 */
+	void setExecutionManager(systems::RealTimeExecutionManager* em);
+	/** Calls LowLevelWam::requestUpdate() on the WAM, if one has been created.
+	 *
+	 * Call with the execution manager's mutex held (e.g. from a System's
+	 * operate()); the WAM pointers are published under that mutex.
+	 */
+	void requestWamUpdate();
 
 	bool foundForceTorqueSensor() const;
 	ForceTorqueSensor* getForceTorqueSensor();
@@ -106,6 +122,8 @@ public:
 	const std::vector<Puck*>& getPucks() const { return pucks; }
 	Puck* getPuck(int id) const;
 	void deletePuck(Puck* p);
+	/// Remembers static Puck properties between runs. See PuckCache.
+	PuckCache& getPuckCache() { return *puckCache; }
 
 	libconfig::Config& getConfig() { return config; }
 	const bus::CommunicationsBus& getBus() const { return *bus; }
@@ -118,6 +136,8 @@ public:
 	static const int FIRST_WAM_ID = 1;
 	static const int FIRST_HAND_ID = 11;
 	static const int FORCE_TORQUE_SENSOR_ID = 8;
+	/// How long enumerate() waits for all of the Pucks to reply (seconds)
+	static constexpr double ENUMERATION_TIMEOUT = 0.02;
 
 protected:
 	void destroyEstopProducts();
@@ -131,9 +151,11 @@ protected:
 	std::vector<Puck*> pucks;
 	std::vector<Puck*> wamPucks;
 	std::vector<Puck*> handPucks;
+	PuckCache* puckCache;
 
 	SafetyModule* sm;
 	systems::RealTimeExecutionManager* rtem;
+	bool deleteRtem;
 	systems::Wam<3>* wam3;
 	systems::Wam<4>* wam4;
 	systems::Wam<7>* wam7;
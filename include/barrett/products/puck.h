@@ -43,6 +43,9 @@
 namespace barrett {
 
 
+class PuckCache;
+
+
 class Puck {
 
 public:
@@ -71,7 +74,8 @@ public:
 
 
 public:
-	Puck(const bus::CommunicationsBus& bus, int id);
+	/// If update is false, the Puck's role and status are unknown until updateRoleAndStatus() is called.
+	Puck(const bus::CommunicationsBus& bus, int id, bool update = true);
 	~Puck();
 
 	void wake();
@@ -100,6 +104,15 @@ public:
 	void updateRole();
 	void updateStatus();
 
+	/** Like getProperty(), but for properties that only change when the Puck
+	 * is reconfigured (CTS, IPNM, POLES, ...). If the Puck has a PuckCache,
+	 * the property is read from the bus at most once and then kept there.
+	 */
+	int getCachedProperty(enum Property prop) const;
+	bool isPropertyCached(enum Property prop) const;
+	PuckCache* getCache() const { return cache; }
+	void setCache(PuckCache* newCache) { cache = newCache; }
+
 	const bus::CommunicationsBus& getBus() const { return bus; }
 	int getId() const { return id; }
 	int getVers() const { return vers; }
@@ -110,6 +123,14 @@ public:
 
 
 	static void wake(std::vector<Puck*> pucks);
+	/** Equivalent to calling updateRole() and updateStatus() on each Puck.
+	 *
+	 * Each property is requested from all of the Pucks before any of the
+	 * replies are read, so the cost is a few bus round trips rather than a few
+	 * per Puck. The Pucks must share a bus. ROLE and VERS are taken from the
+	 * Pucks' PuckCache, if they have one, and added to it otherwise.
+	 */
+	static void updateRoleAndStatus(const std::vector<Puck*>& pucks);
 
 	static int getProperty(const bus::CommunicationsBus& bus, int id, int propId, bool realtime = false);
 	template<typename Parser> static void getProperty(
@@ -119,6 +140,18 @@ public:
 	template<typename Parser> static int tryGetProperty(
 			const bus::CommunicationsBus& bus, int id, int propId, typename Parser::result_type* result,
 			double timeout_s = 0.005);
+	/** Like tryGetProperty(), but for many Pucks at once.
+	 *
+	 * Requests propId from every Puck in ids, waits timeout_s, then collects
+	 * the replies, so absent Pucks cost a single timeout between them. The
+	 * requests are sent in batches of MAX_OUTSTANDING_REQUESTS, separated by
+	 * TX_QUEUE_DRAIN_TIME. Returns what tryGetProperty() would have for each
+	 * ID (0 if the Puck replied, 1 if not). The timeout should allow for every
+	 * request and reply to cross the bus.
+	 */
+	static std::vector<int> tryGetProperty(const bus::CommunicationsBus& bus,
+			const std::vector<int>& ids, int propId, std::vector<int>* results,
+			double timeout_s = 0.005);
 	static void setProperty(const bus::CommunicationsBus& bus, int id, int propId,
 			int value, bool blocking = false);
 
@@ -165,6 +198,15 @@ public:
 	static const int SET_MASK = 0x80;
 	static const int PROPERTY_MASK = 0x7f;
 
+	// Functions that request a property from many Pucks send at most this
+	// many requests before collecting their replies or waiting
+	// TX_QUEUE_DRAIN_TIME. SocketCAN's default txqueuelen is 10, and a longer
+	// burst fails with ENOBUFS.
+	static const size_t MAX_OUTSTANDING_REQUESTS = 8;
+	// Long enough for MAX_OUTSTANDING_REQUESTS requests and their replies to
+	// cross a 1 Mbit/s bus.
+	static constexpr double TX_QUEUE_DRAIN_TIME = 0.002;  // seconds
+
 	static constexpr double WAKE_UP_TIME = 1.0;  // seconds
 	static constexpr double TURN_OFF_TIME = 0.01;  // seconds
 
@@ -194,12 +236,23 @@ protected:
 	};
 
 
+	// Set role and type from a ROLE value
+	void setRole(int newRole);
+	// Set effectiveType from a STAT value
+	void setStat(int stat);
+
+
 	const bus::CommunicationsBus& bus;
 	int id;
 	int vers, role;
 	enum PuckType type, effectiveType;
+	PuckCache* cache;
 
 private:
+	// Requests prop from every Puck, then receives each reply, MAX_OUTSTANDING_REQUESTS at a time.
+	static void getPropertyFromAll(const std::vector<Puck*>& pucks, enum Property prop,
+			std::vector<int>* results);
+
 	template<typename Parser>
 	static int getPropertyHelper(const bus::CommunicationsBus& bus,
 			int id, int propId, typename Parser::result_type* result, bool blocking, bool realtime, double timeout_s);
@@ -0,0 +1,111 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file puck_cache.h
+ * @date 10/19/2026
+ *
+ */
+
+#ifndef BARRETT_PRODUCTS_PUCK_CACHE_H_
+#define BARRETT_PRODUCTS_PUCK_CACHE_H_
+
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/products/puck.h>
+
+
+namespace barrett {
+
+
+/** Remembers Puck properties that only change when a Puck is reconfigured
+ * (ROLE, VERS, CTS, IPNM, POLES, ...), so they don't have to be read from the
+ * bus every time a program starts.
+ *
+ * Entries are kept per Node ID and tagged with the serial number (SN) and
+ * firmware version (VERS) of the Puck they were read from. validate() reads SN
+ * and VERS from each Puck, requesting them from all of the Pucks before any
+ * of the replies are read, and throws away the entries that don't match. A
+ * replaced or reflashed Puck is therefore read afresh. Changing a Puck's ROLE,
+ * CTS, etc. (with btutil, for example) doesn't change its fingerprint: delete
+ * the file, or call clear(), afterwards.
+ *
+ * Pucks use the cache once it is attached with Puck::setCache() (validate()
+ * does this): see Puck::updateRoleAndStatus() and Puck::getCachedProperty().
+ *
+ * The file is plain text, with one line per Puck:
+ *   <ID> <SN> <VERS> <property>=<value> ...
+ * Errors reading or writing it are logged and otherwise ignored; the cache
+ * only ever saves time.
+ */
+class PuckCache {
+public:
+	/// Loads fileName, if it exists. An empty fileName gives a cache that isn't saved.
+	explicit PuckCache(const std::string& fileName = "");
+	~PuckCache();
+
+	const std::string& getFileName() const { return fileName; }
+
+	/** Reads the fingerprint of each Puck, discards stale entries, and
+	 * attaches the cache to the Pucks. The Pucks must share a bus.
+	 */
+	void validate(const std::vector<Puck*>& pucks);
+
+	bool hasProperty(int id, enum Puck::Property prop) const;
+	/// Returns false, and leaves value alone, if prop isn't cached for Puck id.
+	bool getProperty(int id, enum Puck::Property prop, int* value) const;
+	/// Ignored if Puck id hasn't been validated.
+	void setProperty(int id, enum Puck::Property prop, int value);
+
+	/// Discards every entry.
+	void clear();
+	/// Writes the file if the cache has changed since it was loaded or last saved.
+	void save();
+
+protected:
+	struct Entry {
+		int sn;
+		std::map<enum Puck::Property, int> props;  // Always includes VERS
+	};
+
+	void load();
+
+	std::string fileName;
+	std::map<int, Entry> entries;
+	bool changed;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(PuckCache);
+};
+
+
+}
+
+
+#endif /* BARRETT_PRODUCTS_PUCK_CACHE_H_ */
@@ -73,6 +73,62 @@ public:
 			int propId, typename Parser::result_type results[], bool realtime = false) const;
 
 
+	/** Reads several properties from the group in a single bus round trip.
+	 *
+	 * add() each property along with the array that receives its results (one
+	 * per Puck, as for getProperty()). update() then sends every request
+	 * before it reads any of the replies. Replies to different properties are
+	 * sorted by the bus as they arrive, so the cost is close to that of
+	 * reading one property.
+	 *
+	 * A PropertyBatch holds at most MAX_PROPERTIES properties and doesn't
+	 * allocate memory, so it can be built and used in real time. The result
+	 * arrays must outlive it.
+	 *
+	 * Example:
+	 *   PuckGroup::PropertyBatch batch(group);
+	 *   batch.add<MotorPuck::CombinedPositionParser<int> >(Puck::P, positions);
+	 *   batch.add(Puck::SG, strain);
+	 *   batch.update(true);
+	 */
+	class PropertyBatch {
+	public:
+		explicit PropertyBatch(const PuckGroup& _group) :
+			group(_group), numProperties(0) {}
+
+		void add(enum Puck::Property prop, int results[]) {
+			add<Puck::StandardParser>(prop, results);
+		}
+		template<typename Parser> void add(enum Puck::Property prop,
+				typename Parser::result_type results[]);
+		void clear() { numProperties = 0; }
+		size_t size() const { return numProperties; }
+
+		/// Locks the bus, then calls send() and receive().
+		void update(bool realtime = false) const;
+
+		/// Requests every property. The caller must hold the bus's mutex until receive() returns.
+		void send() const;
+		/// Receives every reply, in the order the properties were added.
+		void receive(bool realtime = false) const;
+
+		static const size_t MAX_PROPERTIES = 8;
+
+	protected:
+		typedef void (*receive_function_type)(const PuckGroup& group, int propId,
+				void* results, bool realtime);
+
+		template<typename Parser> static void receiveHelper(const PuckGroup& group,
+				int propId, void* results, bool realtime);
+
+		const PuckGroup& group;
+		size_t numProperties;
+		int propIds[MAX_PROPERTIES];
+		void* results[MAX_PROPERTIES];
+		receive_function_type receiveFunctions[MAX_PROPERTIES];
+	};
+
+
 	enum BroadcastGroup {
 		BGRP_WHOLE_BUS = Puck::GROUP_MASK | 0,  // Everything but the Safety Puck
 
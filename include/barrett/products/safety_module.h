@@ -36,6 +36,8 @@
 
 #include <string>
 
+#include <boost/atomic.hpp>
+
 #include <barrett/products/puck.h>
 #include <barrett/products/abstract/special_puck.h>
 
@@ -139,10 +141,35 @@ public:
  *	Method will update the current button, mode and parameter status values.
  */
 	void getPendantState(PendantState* ps, bool realtime = false) const;
+/** decodePendantState Method fills ps from a PEN property value
+ *
+ *	Returns false, leaving ps partially filled, if pen is not a valid PEN value.
+ */
+	static bool decodePendantState(int pen, PendantState* ps);
+
+/** StateSource supplies MODE and PEN values that are read elsewhere
+ *
+ *	See systems::SafetyMonitor. The methods return false if no recent value is available.
+ */
+	class StateSource {
+	public:
+		virtual ~StateSource() {}
+		virtual bool getMode(enum SafetyMode* mode) const = 0;
+		virtual bool getPendantState(PendantState* ps) const = 0;
+	};
+/** setStateSource Method routes getMode() and getPendantState() through source
+ *
+ *	While source has recent values, getMode() and getPendantState() (and so waitForMode() and waitForModeChange())
+ *	return them instead of reading MODE and PEN from the bus. Pass NULL to read from the bus again.
+ */
+	void setStateSource(const StateSource* source) { stateSource.store(source); }
+	const StateSource* getStateSource() const { return stateSource.load(); }
 
 protected:
 	static const int VELOCITY_FAULT_HISTORY_BUFFER_SIZE = 5;
 
+	boost::atomic<const StateSource*> stateSource;
+
 private:
 	static const char safetyModeStrs[][15];
 };
@@ -40,6 +40,10 @@
 
 #include <barrett/systems/wam.h>
 #include <barrett/systems/low_level_wam_wrapper.h>
+#include <barrett/systems/hand_sensors.h>
+#include <barrett/systems/tactile_processor.h>
+#include <barrett/systems/force_torque_source.h>
+#include <barrett/systems/safety_monitor.h>
 
 // other -- these operate on Systems, but are not Systems themselves
 #include <barrett/systems/helpers.h>
@@ -53,6 +57,8 @@
 #include <barrett/systems/exposed_output.h>
 
 #include <barrett/systems/ramp.h>
+#include <barrett/systems/playback_clock.h>
+#include <barrett/systems/online_trajectory.h>
 
 // sinks
 #include <barrett/systems/print_to_stream.h>
@@ -69,10 +75,16 @@
 #include <barrett/systems/tool_force_to_joint_torques.h>
 #include <barrett/systems/tool_torque_to_joint_torques.h>
 #include <barrett/systems/tool_orientation_controller.h>
+#include <barrett/systems/operational_space_controller.h>
+#include <barrett/systems/cartesian_impedance.h>
+#include <barrett/systems/admittance.h>
 
 #include <barrett/systems/haptic_ball.h>
 #include <barrett/systems/haptic_box.h>
+#include <barrett/systems/haptic_loop.h>
+#include <barrett/systems/haptic_mesh.h>
 #include <barrett/systems/haptic_path.h>
+#include <barrett/systems/haptic_scene.h>
 
 #include <barrett/systems/summer.h>
 #include <barrett/systems/gain.h>
@@ -0,0 +1,247 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * admittance.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_ADMITTANCE_H_
+#define BARRETT_SYSTEMS_ADMITTANCE_H_
+
+
+#include <cassert>
+#include <stdexcept>
+
+#include <Eigen/Core>
+#include <libconfig.h++>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/math/kinematics.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+#include <barrett/systems/kinematics_base.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Turns the force measured at the tool into a motion of the tool.
+ *
+ * The output is a Cartesian position reference that moves like a mass-spring-
+ * damper pushed by forceInput:
+ *     M a + D v + K (output - anchor) = R f
+ * with the diagonal M, D and K given in the world frame, f the force in the
+ * tool frame (for instance, ForceTorqueSource::forceOutput), and R the tool's
+ * rotation to the world frame from kinInput. With K = 0, the tool drifts
+ * wherever it is pushed; a positive K pulls it back to the anchor. Forces
+ * smaller than the dead band (see setDeadBand()) are ignored, so sensor noise
+ * doesn't make the tool creep, and the speed is limited to maxVelocity.
+ *
+ * The output is undefined until reset() sets the anchor and the starting
+ * position. Typical use:
+ *     admittance.reset(wam.getToolPosition());
+ *     wam.trackReferenceSignal(admittance.output);
+ *
+ * The state is integrated with semi-implicit Euler every execution cycle.
+ * All values are fixed-size; operate() does not allocate.
+ */
+template<size_t DOF>
+class Admittance : public System, public KinematicsInput<DOF>,
+				   public SingleOutput<units::CartesianPosition::type> {
+
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+// IO
+public:		Input<cf_type> forceInput;
+
+
+public:
+	typedef math::Vector<3>::type cartesian_gain_type;
+
+	explicit Admittance(ExecutionManager* em, const cartesian_gain_type& mass = cartesian_gain_type(1.0),
+			const cartesian_gain_type& damping = cartesian_gain_type(50.0),
+			const cartesian_gain_type& stiffness = cartesian_gain_type(0.0),
+			double maxVelocity = 0.1, const std::string& sysName = "Admittance") :
+		System(sysName), KinematicsInput<DOF>(this), SingleOutput<cp_type>(this),
+		forceInput(this),
+		T_s(0.0), maxVelocity(0.0), deadBand(0.0), anchored(false),
+		anchor(0.0), cp(0.0), cv(0.0), f(0.0), R()
+	{
+		setParameters(mass, damping, stiffness);
+		setMaxVelocity(maxVelocity);
+
+		// The state must be integrated every execution cycle.
+		if (em != NULL) {
+			em->startManaging(*this);
+		}
+
+		getSamplePeriodFromEM();
+	}
+	Admittance(ExecutionManager* em, const libconfig::Setting& setting,
+			const std::string& sysName = "Admittance") :
+		System(sysName), KinematicsInput<DOF>(this), SingleOutput<cp_type>(this),
+		forceInput(this),
+		T_s(0.0), maxVelocity(0.0), deadBand(0.0), anchored(false),
+		anchor(0.0), cp(0.0), cv(0.0), f(0.0), R()
+	{
+		setFromConfig(setting);
+
+		if (em != NULL) {
+			em->startManaging(*this);
+		}
+
+		getSamplePeriodFromEM();
+	}
+	virtual ~Admittance() { this->mandatoryCleanUp(); }
+
+
+	void setFromConfig(const libconfig::Setting& setting) {
+		setParameters(cartesian_gain_type(setting["mass"]),
+				cartesian_gain_type(setting["damping"]),
+				cartesian_gain_type(setting["stiffness"]));
+		setMaxVelocity(setting["max_velocity"]);
+		if (setting.exists("dead_band")) {
+			setDeadBand(setting["dead_band"]);
+		}
+	}
+
+	/// mass in kg, damping in N*s/m and stiffness in N/m, along the world frame's x, y and z axes. mass must be positive; damping and stiffness may not be negative.
+	void setParameters(const cartesian_gain_type& mass, const cartesian_gain_type& damping,
+			const cartesian_gain_type& stiffness) {
+		if ((mass.array() <= 0.0).any()  ||  (damping.array() < 0.0).any()  ||  (stiffness.array() < 0.0).any()) {
+			(logMessage("systems::Admittance::%s(): mass must be positive and "
+					"damping and stiffness must be non-negative.")
+					% __func__).template raise<std::invalid_argument>();
+		}
+
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		invMass = mass.cwiseInverse();
+		this->damping = damping;
+		this->stiffness = stiffness;
+	}
+	/// m/s
+	void setMaxVelocity(double v) {
+		if (v <= 0.0) {
+			(logMessage("systems::Admittance::%s(): maxVelocity must be positive (got %f).")
+					% __func__ % v).template raise<std::invalid_argument>();
+		}
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		maxVelocity = v;
+	}
+	/// N. Forces smaller than this are ignored, and larger ones are reduced by it.
+	void setDeadBand(double f) {
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		deadBand = f;
+	}
+
+	/// Moves the anchor and the output to position, at rest.
+	void reset(const cp_type& position) {
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		anchor = position;
+		cp = position;
+		cv.setZero();
+		anchored = true;
+	}
+	/// Moves the anchor without moving the output.
+	void setAnchor(const cp_type& position) {
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		anchor = position;
+	}
+
+	const cp_type& getAnchor() const { return anchor; }
+	double getMaxVelocity() const { return maxVelocity; }
+	double getDeadBand() const { return deadBand; }
+	/// The output's velocity, as of the last execution cycle
+	const cv_type& getVelocity() const { return cv; }
+
+protected:
+	virtual bool inputsValid() {
+		return anchored  &&  forceInput.valueDefined()  &&  this->kinInput.valueDefined();
+	}
+	virtual void onExecutionManagerChanged() {
+		System::onExecutionManagerChanged();  // First, call super
+		getSamplePeriodFromEM();
+	}
+	void getSamplePeriodFromEM() {
+		if (this->hasExecutionManager()) {
+			assert(this->getExecutionManager()->getPeriod() > 0.0);
+			T_s = this->getExecutionManager()->getPeriod();
+		} else {
+			T_s = 0.0;
+		}
+	}
+
+	/// Copies R from kinInput.
+	virtual void readKinematics() {
+		R.copyFrom(this->kinInput.getValue().impl->tool->rot_to_world);
+	}
+
+	virtual void operate() {
+		readKinematics();
+
+		f = R * forceInput.getValue();
+		double norm = f.norm();
+		if (norm <= deadBand) {
+			f.setZero();
+		} else if (deadBand > 0.0) {
+			f *= (norm - deadBand) / norm;
+		}
+
+		cv += T_s * invMass.cwiseProduct(f - damping.cwiseProduct(cv) - stiffness.cwiseProduct(cp - anchor));
+		double speed = cv.norm();
+		if (speed > maxVelocity) {
+			cv *= maxVelocity / speed;
+		}
+		cp += T_s * cv;
+
+		this->outputValue->setData(&cp);
+	}
+
+	double T_s;
+	cartesian_gain_type invMass, damping, stiffness;
+	double maxVelocity, deadBand;
+	bool anchored;
+	cp_type anchor, cp;
+	cv_type cv;
+	cf_type f;
+	math::Matrix<3,3> R;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(Admittance);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_ADMITTANCE_H_ */
@@ -0,0 +1,161 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * cartesian_impedance.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_CARTESIAN_IMPEDANCE_H_
+#define BARRETT_SYSTEMS_CARTESIAN_IMPEDANCE_H_
+
+
+#include <stdexcept>
+
+#include <Eigen/Core>
+#include <libconfig.h++>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/math/kinematics.h>
+#include <barrett/systems/abstract/controller.h>
+#include <barrett/systems/kinematics_base.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Cartesian impedance controller: makes the tool behave like a spring and
+ * damper attached to the reference position.
+ *
+ * The stiffness and damping are diagonal in the tool frame, so the tool can be
+ * stiff along some of its axes and compliant along others (for instance,
+ * compliant along the insertion axis of a peg). The commanded joint torques are
+ *     J^T R (K R^T (reference - feedback) - D R^T v)
+ * where J is the linear tool Jacobian, R the tool's rotation to the world frame
+ * and v the tool velocity, all from kinInput.
+ *
+ * feedbackInput takes the tool position (Wam::toolPosition.output) and
+ * kinInput the WAM's kinematics (Wam::kinematicsBase.kinOutput). Once
+ * registered with Wam::supervisoryController.registerConversion(), it is used
+ * instead of Wam::tpController when Wam::trackReferenceSignal() is given a
+ * Cartesian position.
+ *
+ * All matrices are fixed-size; operate() does not allocate.
+ */
+template<size_t DOF>
+class CartesianImpedance : public Controller<units::CartesianPosition::type,
+											 typename units::JointTorques<DOF>::type>,
+						   public KinematicsInput<DOF> {
+
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+public:
+	typedef math::Vector<3>::type cartesian_gain_type;
+
+	explicit CartesianImpedance(const std::string& sysName = "CartesianImpedance") :
+		Controller<cp_type, jt_type>(sysName), KinematicsInput<DOF>(this),
+		stiffness(0.0), damping(0.0) {}
+	CartesianImpedance(const libconfig::Setting& setting,
+			const std::string& sysName = "CartesianImpedance") :
+		Controller<cp_type, jt_type>(sysName), KinematicsInput<DOF>(this),
+		stiffness(0.0), damping(0.0)
+	{
+		setFromConfig(setting);
+	}
+	virtual ~CartesianImpedance() { this->mandatoryCleanUp(); }
+
+
+	void setFromConfig(const libconfig::Setting& setting) {
+		setStiffness(cartesian_gain_type(setting["stiffness"]));
+		setDamping(cartesian_gain_type(setting["damping"]));
+	}
+
+	/// N/m along the tool frame's x, y and z axes. May not be negative.
+	void setStiffness(const cartesian_gain_type& k) {
+		if ((k.array() < 0.0).any()) {
+			(logMessage("systems::CartesianImpedance::%s(): stiffness must be non-negative.")
+					% __func__).template raise<std::invalid_argument>();
+		}
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		stiffness = k;
+	}
+	/// N*s/m along the tool frame's x, y and z axes. May not be negative.
+	void setDamping(const cartesian_gain_type& d) {
+		if ((d.array() < 0.0).any()) {
+			(logMessage("systems::CartesianImpedance::%s(): damping must be non-negative.")
+					% __func__).template raise<std::invalid_argument>();
+		}
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		damping = d;
+	}
+
+	const cartesian_gain_type& getStiffness() const { return stiffness; }
+	const cartesian_gain_type& getDamping() const { return damping; }
+
+protected:
+	/// Copies J, R and cv from kinInput.
+	virtual void readKinematics() {
+		const math::Kinematics<DOF>& kin = this->kinInput.getValue();
+		J.copyFrom(kin.impl->tool_jacobian_linear);
+		R.copyFrom(kin.impl->tool->rot_to_world);
+		cv.copyFrom(kin.impl->tool_velocity);
+	}
+
+	virtual void operate() {
+		readKinematics();
+
+		// Spring and damper in the tool frame
+		e = R.transpose() * (this->referenceInput.getValue() - this->feedbackInput.getValue());
+		vTool = R.transpose() * cv;
+		cf = R * (stiffness.cwiseProduct(e) - damping.cwiseProduct(vTool));
+		jt = J.transpose() * cf;
+
+		this->controlOutputValue->setData(&jt);
+	}
+
+	cartesian_gain_type stiffness, damping;
+
+	math::Matrix<3,DOF> J;
+	math::Matrix<3,3> R;
+	cv_type cv, vTool;
+	cp_type e;
+	cf_type cf;
+	jt_type jt;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(CartesianImpedance);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_CARTESIAN_IMPEDANCE_H_ */
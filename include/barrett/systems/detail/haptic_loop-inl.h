@@ -0,0 +1,139 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * haptic_loop-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+template<size_t DOF>
+HapticLoop<DOF>::HapticLoop(ExecutionManager* em, Wam<DOF>& wam_, double maxAge_,
+		const std::string& sysName) :
+	toolPosition(source.toolPosition), toolVelocity(source.toolVelocity), toolForceInput(sink.input),
+	kinematicsBase(wam_.kinematicsBase), llww(&wam_.llww),
+	maxAge(maxAge_), haveSnapshot(false), fresh(false), mailbox(jt_type(0.0)),
+	source(this, em, sysName + "::Source"), sink(this, em, sysName + "::Sink")
+{
+	llww->setTorqueMailbox(&mailbox);
+}
+
+template<size_t DOF>
+HapticLoop<DOF>::HapticLoop(ExecutionManager* em, const KinematicsBase<DOF>& kinematicsBase_,
+		double maxAge_, const std::string& sysName) :
+	toolPosition(source.toolPosition), toolVelocity(source.toolVelocity), toolForceInput(sink.input),
+	kinematicsBase(kinematicsBase_), llww(NULL),
+	maxAge(maxAge_), haveSnapshot(false), fresh(false), mailbox(jt_type(0.0)),
+	source(this, em, sysName + "::Source"), sink(this, em, sysName + "::Sink")
+{
+}
+
+template<size_t DOF>
+HapticLoop<DOF>::~HapticLoop()
+{
+	if (llww != NULL) {
+		llww->setTorqueMailbox(NULL);
+	}
+}
+
+template<size_t DOF>
+const int HapticLoop<DOF>::MAX_SNAPSHOT_READ_ATTEMPTS;
+
+template<size_t DOF>
+bool HapticLoop<DOF>::updateSnapshot()
+{
+	// Don't spin if we preempted the main execution cycle mid-write: keep the
+	// previous snapshot and let maxAge decide whether it can still be used.
+	if (kinematicsBase.tryGetSnapshot(&pendingSnapshot, MAX_SNAPSHOT_READ_ATTEMPTS)) {
+		snapshot = pendingSnapshot;
+		haveSnapshot = true;
+	}
+	fresh = haveSnapshot  &&  highResolutionSystemTime() - snapshot.timestamp <= maxAge;
+	return fresh;
+}
+
+
+template<size_t DOF>
+HapticLoop<DOF>::Source::Source(HapticLoop* parent_, ExecutionManager* em, const std::string& sysName) :
+	System(sysName),
+	toolPosition(this, &toolPositionValue), toolVelocity(this, &toolVelocityValue),
+	parent(parent_), tp(0.0), tv(0.0)
+{
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+template<size_t DOF>
+void HapticLoop<DOF>::Source::operate()
+{
+	if (parent->updateSnapshot()) {
+		tv = parent->snapshot.toolVelocity;
+		tp = parent->snapshot.toolPosition + (highResolutionSystemTime() - parent->snapshot.timestamp) * tv;
+
+		toolPositionValue->setData(&tp);
+		toolVelocityValue->setData(&tv);
+	} else {
+		// Without a recent snapshot, the haptic graph shouldn't run.
+		toolPositionValue->setUndefined();
+		toolVelocityValue->setUndefined();
+	}
+}
+
+
+template<size_t DOF>
+HapticLoop<DOF>::Sink::Sink(HapticLoop* parent_, ExecutionManager* em, const std::string& sysName) :
+	System(sysName),
+	SingleInput<cf_type>(this),
+	parent(parent_)
+{
+	// Update every execution cycle because this is a sink.
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+template<size_t DOF>
+void HapticLoop<DOF>::Sink::operate()
+{
+	// Only publish torques computed from a recent snapshot. When nothing is
+	// published, LowLevelWamWrapper stops applying the last torque.
+	const cf_type& force = this->input.getValue();
+	if (parent->fresh) {
+		jt_type& jt = parent->mailbox.beginWrite();
+		jt = parent->snapshot.toolJacobian.template topRows<3>().transpose() * force;
+		parent->mailbox.endWrite();
+	}
+}
+
+
+}
+}
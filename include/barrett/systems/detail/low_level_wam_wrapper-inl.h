@@ -58,10 +58,26 @@ LowLevelWamWrapper<DOF>::LowLevelWamWrapper(
 {
 }
 
+template<size_t DOF>
+const int LowLevelWamWrapper<DOF>::MAX_STALE_CYCLES;
+
+template<size_t DOF>
+void LowLevelWamWrapper<DOF>::setTorqueMailbox(const thread::SeqLock<jt_type>* mailbox)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+
+	sink.mailbox.setSource(mailbox);
+}
+
 template<size_t DOF>
 void LowLevelWamWrapper<DOF>::Sink::operate()
 {
-	parent->llw.setTorques(this->input.getValue());
+	if (mailbox.update()) {
+		jt = mailbox.getValue() + this->input.getValue();
+		parent->llw.setTorques(jt);
+	} else {
+		parent->llw.setTorques(this->input.getValue());
+	}
 }
 
 template<size_t DOF>
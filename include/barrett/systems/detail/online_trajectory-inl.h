@@ -0,0 +1,238 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+/*
+ * online_trajectory-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/thread/locks.hpp>
+
+#include <barrett/os.h>
+#include <barrett/thread/abstract/mutex.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+template<typename T>
+const double OnlineTrajectory<T>::MIN_LIMIT_SCALE = 1e-6;
+template<typename T>
+const double OnlineTrajectory<T>::WAIT_POLL_PERIOD = 0.001;
+
+
+template<typename T>
+OnlineTrajectory<T>::OnlineTrajectory(ExecutionManager* em, const std::string& sysName) :
+	System(sysName), SingleOutput<T>(this),
+	T_s(0.0), profile(1.0, 1.0, 1.0), p(0.0), v(0.0), a(0.0), t(0.0),
+	active(false), activeGoal(0), pathLimits(false),
+	queuedGoal(0), reachedGoal(0)
+{
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+
+	getSamplePeriodFromEM();
+}
+
+template<typename T>
+void OnlineTrajectory<T>::reset(const T& position, const unitless_type& velocity)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+
+	// Discard goals that haven't started yet
+	Command c;
+	while (commands.pop(c)) {}
+
+	p = position;
+	v = velocity;
+	a.setZero();
+	t = 0.0;
+	active = false;
+	reachedGoal.store(queuedGoal.load());
+}
+
+template<typename T>
+typename OnlineTrajectory<T>::goal_id_type OnlineTrajectory<T>::setGoal(
+		const T& destination, double velocity, double acceleration, double jerk)
+{
+	return setGoal(destination, unitless_type(velocity),
+			unitless_type(acceleration), unitless_type(jerk));
+}
+
+template<typename T>
+typename OnlineTrajectory<T>::goal_id_type OnlineTrajectory<T>::setGoal(
+		const T& destination, const unitless_type& velocity,
+		const unitless_type& acceleration, const unitless_type& jerk)
+{
+	// Check here so that planning can't throw in the execution cycle.
+	if ((velocity.array() <= 0.0).any()  ||
+			(acceleration.array() <= 0.0).any()  ||
+			(jerk.array() <= 0.0).any()) {
+		(logMessage("OnlineTrajectory::%s(): Limits must be positive.")
+				% __func__).template raise<std::logic_error>();
+	}
+
+	boost::lock_guard<boost::mutex> lg(producerMutex);
+
+	Command c;
+	c.destination = destination;
+	c.velocity = velocity;
+	c.acceleration = acceleration;
+	c.jerk = jerk;
+	c.id = queuedGoal.load(boost::memory_order_relaxed) + 1;
+
+	if ( !commands.push(c) ) {
+		(logMessage("OnlineTrajectory::%s(): Goal queue is full. "
+				"Is the ExecutionManager running?")
+				% __func__).template raise<std::runtime_error>();
+	}
+	queuedGoal.store(c.id, boost::memory_order_release);
+
+	return c.id;
+}
+
+template<typename T>
+void OnlineTrajectory<T>::setPathLimits(bool pathLimits_)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	pathLimits = pathLimits_;
+}
+
+template<typename T>
+bool OnlineTrajectory<T>::waitUntilDone(goal_id_type goal) const
+{
+	// Polled rather than signaled: under Xenomai, waking a Linux thread from
+	// the execution cycle would switch the real-time thread to secondary mode.
+	while ( !isDone(goal) ) {
+		if ( !this->hasExecutionManager() ) {
+			break;
+		}
+		btsleep(WAIT_POLL_PERIOD);
+	}
+
+	return isDone(goal);
+}
+
+template<typename T>
+void OnlineTrajectory<T>::onExecutionManagerChanged()
+{
+	System::onExecutionManagerChanged();  // First, call super
+	getSamplePeriodFromEM();
+}
+
+template<typename T>
+void OnlineTrajectory<T>::getSamplePeriodFromEM()
+{
+	if (this->hasExecutionManager()) {
+		assert(this->getExecutionManager()->getPeriod() > 0.0);
+		T_s = this->getExecutionManager()->getPeriod();
+	} else {
+		T_s = 0.0;
+	}
+}
+
+template<typename T>
+void OnlineTrajectory<T>::operate()
+{
+	// Only the newest goal matters.
+	Command c;
+	bool newGoal = false;
+	while (commands.pop(c)) {
+		newGoal = true;
+	}
+
+	if (newGoal) {
+		if (pathLimits) {
+			scaleLimits(&c);
+		}
+		profile.setLimits(c.velocity, c.acceleration, c.jerk);
+		profile.plan(p, v, a, c.destination);
+		t = 0.0;
+		active = true;
+		activeGoal = c.id;
+	}
+
+	if (active) {
+		t += T_s;
+		profile.eval(t, &p, &v, &a);
+
+		if (t >= profile.finalT()) {
+			active = false;
+			reachedGoal.store(activeGoal, boost::memory_order_release);
+		}
+	}
+
+	this->outputValue->setData(&p);
+}
+
+template<typename T>
+void OnlineTrajectory<T>::scaleLimits(Command* c) const
+{
+	double dNorm = 0.0, vNorm = 0.0, aNorm = 0.0;
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		const double d = c->destination[i] - p[i];
+		dNorm += d * d;
+		vNorm += v[i] * v[i];
+		aNorm += a[i] * a[i];
+	}
+	dNorm = std::sqrt(dNorm);
+	vNorm = std::sqrt(vNorm);
+	aNorm = std::sqrt(aNorm);
+
+	unitless_type scale;
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		scale[i] = (dNorm > 0.0) ? std::fabs(c->destination[i] - p[i]) / dNorm : 1.0;
+		if (vNorm > 0.0) {
+			scale[i] = std::max(scale[i], std::fabs(v[i]) / vNorm);
+		}
+		if (aNorm > 0.0) {
+			scale[i] = std::max(scale[i], std::fabs(a[i]) / aNorm);
+		}
+		scale[i] = std::max(scale[i], MIN_LIMIT_SCALE);
+	}
+
+	// When blending, a coefficient can take its share from the velocity while
+	// another takes its share from the displacement. Normalizing keeps the
+	// magnitude of the scaled limits from growing past the given ones.
+	scale /= scale.norm();
+
+	for (size_t i = 0; i < T::SIZE; ++i) {
+		c->velocity[i] *= scale[i];
+		c->acceleration[i] *= scale[i];
+		c->jerk[i] *= scale[i];
+	}
+}
+
+
+}
+}
@@ -0,0 +1,122 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * wam-helper.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <vector>
+
+#define EIGEN_USE_NEW_STDVECTOR
+#include <Eigen/StdVector>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/jerk_limited_profile.h>
+
+
+namespace barrett {
+namespace systems {
+namespace detail {
+
+
+// Wam::moveTo() limits jerk so that the acceleration limit is reached in
+// this many seconds.
+const double MOVE_TO_JERK_TIME = 0.1;
+
+
+// Follows a straight-line Spline from currentPos to destination. The Spline's
+// path parameter follows a JerkLimitedProfile that starts at currentVel.
+template<typename T>
+class MoveToProfile {
+public:
+	typedef double velocity_type;  ///< Initial speed along the path
+	typedef T result_type;
+
+	MoveToProfile(const T& currentPos, velocity_type currentVel,
+			const T& destination, double velocity, double acceleration) :
+		spline(makePoints(currentPos, destination)),
+		profile(velocity, acceleration, acceleration / MOVE_TO_JERK_TIME,
+				currentVel, spline.changeInS()) {}
+
+	double finalT() const { return profile.finalT(); }
+
+	result_type operator() (double t) const {
+		return spline.eval(profile.eval(t));
+	}
+
+protected:
+	typedef std::vector<T, Eigen::aligned_allocator<T> > points_type;
+
+	static points_type makePoints(const T& currentPos, const T& destination) {
+		points_type points;
+		points.push_back(currentPos);
+		points.push_back(destination);
+		return points;
+	}
+
+	math::Spline<T> spline;
+	math::JerkLimitedProfile profile;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(MoveToProfile);
+};
+
+
+// Joint-space moves: each joint follows its own S-curve, starting from the
+// current joint velocity, and all joints arrive at the same time.
+template<int R>
+class MoveToProfile<math::Matrix<R,1, units::JointPositions<R> > > {
+public:
+	typedef math::Matrix<R,1, units::JointPositions<R> > jp_type;
+	typedef typename jp_type::unitless_type velocity_type;
+	typedef jp_type result_type;
+
+	MoveToProfile(const jp_type& currentPos, const velocity_type& currentVel,
+			const jp_type& destination, double velocity, double acceleration) :
+		profile(velocity, acceleration, acceleration / MOVE_TO_JERK_TIME)
+	{
+		profile.plan(currentPos, currentVel, velocity_type(0.0), destination);
+	}
+
+	double finalT() const { return profile.finalT(); }
+
+	result_type operator() (double t) const {
+		return profile.eval(t);
+	}
+
+protected:
+	math::SynchronizedJerkLimitedProfile<jp_type> profile;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(MoveToProfile);
+};
+
+
+}
+}
+}
@@ -47,8 +47,6 @@
 #include <barrett/products/puck.h>
 #include <barrett/products/safety_module.h>
 #include <barrett/thread/abstract/mutex.h>
-#include <barrett/math/spline.h>
-#include <barrett/math/trapezoidal_velocity_profile.h>
 #include <barrett/systems/abstract/system.h>
 #include <barrett/systems/io_conversion.h>
 #include <barrett/systems/ramp.h>
@@ -93,10 +91,14 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 
 	jtSum(true),
 
+	jpTrajectory(NULL, sysName + "::jpTrajectory"),
+	cpTrajectory(NULL, sysName + "::cpTrajectory"),
+
 	input(jtSum.getInput(JT_INPUT)), jpOutput(llww.jpOutput), jvOutput(jvFilter.output),
 
 	doneMoving(true),
-	kin(setting["kinematics"])
+	kin(setting["kinematics"]),
+	statePublisher(llww.getLowLevelWam(), sysName + "::StatePublisher")
 {
 	connect(llww.jpOutput, kinematicsBase.jpInput);
 	connect(jvOutput, kinematicsBase.jvInput);
@@ -117,11 +119,19 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 	connect(toolPosition.output, toolPose.getInput<0>());
 	connect(toolOrientation.output, toolPose.getInput<1>());
 
+	// Cartesian moveTo()s bound the tool's speed, not each axis's.
+	cpTrajectory.setPathLimits(true);
+
 	connect(llww.jvOutput, jvFilter.input);
 	if (em != NULL) {
 		// Keep the jvFilter updated so it will provide accurate values for
 		// calls to Wam::getJointVelocities().
 		em->startManaging(jvFilter);
+
+		// Evaluate the kinematics once per cycle so that getToolPosition(),
+		// getToolJacobian(), etc. can read the published snapshot instead of
+		// locking the EM mutex or repeating the computation.
+		em->startManaging(kinematicsBase);
 	}
 
 	supervisoryController.registerConversion(makeIOConversion(
@@ -161,6 +171,15 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 
 	connect(supervisoryController.output, jtSum.getInput(SC_INPUT));
 	connect(jtSum.output, llww.input);
+
+	connect(llww.jpOutput, statePublisher.jpInput);
+	connect(jvOutput, statePublisher.jvInput);
+	connect(jtSum.output, statePublisher.jtInput);
+	connect(toolPose.output, statePublisher.poseInput);
+	if (em != NULL) {
+		// Publish a snapshot for getState() every cycle.
+		em->startManaging(statePublisher);
+	}
 }
 
 template<size_t DOF>
@@ -178,6 +197,20 @@ void Wam<DOF>::trackReferenceSignal(System::Output<T>& referenceSignal)
 	supervisoryController.connectInputTo(referenceSignal);
 }
 
+template<size_t DOF>
+void Wam<DOF>::StatePublisher::operate()
+{
+	State& s = stateLock.beginWrite();
+	s.jp = jpInput.getValue();
+	s.jv = jvInput.getValue();
+	s.jt = jtInput.getValue();
+	s.toolPosition = boost::get<0>(poseInput.getValue());
+	s.toolOrientation = boost::get<1>(poseInput.getValue());
+	s.timestamp = llw.getLastUpdateTime();
+	s.cycle = cycle++;
+	stateLock.endWrite();
+}
+
 template<size_t DOF>
 inline const typename Wam<DOF>::jp_type& Wam<DOF>::getHomePosition() const
 {
@@ -187,6 +220,11 @@ inline const typename Wam<DOF>::jp_type& Wam<DOF>::getHomePosition() const
 template<size_t DOF>
 typename Wam<DOF>::jt_type Wam<DOF>::getJointTorques() const
 {
+	State state;
+	if (getState(&state)) {
+		return state.jt;
+	}
+
 	{
 		BARRETT_SCOPED_LOCK(getEmMutex());
 		if (llww.input.valueDefined()) {
@@ -198,14 +236,24 @@ typename Wam<DOF>::jt_type Wam<DOF>::getJointTorques() const
 }
 
 template<size_t DOF>
-inline typename Wam<DOF>::jp_type Wam<DOF>::getJointPositions() const
+typename Wam<DOF>::jp_type Wam<DOF>::getJointPositions() const
 {
+	State state;
+	if (getState(&state)) {
+		return state.jp;
+	}
+
 	return getLowLevelWam().getJointPositions();
 }
 
 template<size_t DOF>
-inline typename Wam<DOF>::jv_type Wam<DOF>::getJointVelocities() const
+typename Wam<DOF>::jv_type Wam<DOF>::getJointVelocities() const
 {
+	State state;
+	if (getState(&state)) {
+		return state.jv;
+	}
+
 	{
 		BARRETT_SCOPED_LOCK(getEmMutex());
 
@@ -222,11 +270,9 @@ inline typename Wam<DOF>::jv_type Wam<DOF>::getJointVelocities() const
 template<size_t DOF>
 typename Wam<DOF>::cp_type Wam<DOF>::getToolPosition() const
 {
-	{
-		BARRETT_SCOPED_LOCK(getEmMutex());
-		if (tpController.feedbackInput.valueDefined()) {
-			return tpController.feedbackInput.getValue();
-		}
+	kinematics_snapshot_type snapshot;
+	if (kinematicsBase.getSnapshot(&snapshot)) {
+		return snapshot.toolPosition;
 	}
 
 	kin.eval(getJointPositions(), getJointVelocities());
@@ -236,6 +282,11 @@ typename Wam<DOF>::cp_type Wam<DOF>::getToolPosition() const
 template<size_t DOF>
 typename Wam<DOF>::cv_type Wam<DOF>::getToolVelocity() const
 {
+	kinematics_snapshot_type snapshot;
+	if (kinematicsBase.getSnapshot(&snapshot)) {
+		return snapshot.toolVelocity;
+	}
+
 	kin.eval(getJointPositions(), getJointVelocities());
 	return cv_type(kin.impl->tool_velocity);
 }
@@ -243,11 +294,9 @@ typename Wam<DOF>::cv_type Wam<DOF>::getToolVelocity() const
 template<size_t DOF>
 Eigen::Quaterniond Wam<DOF>::getToolOrientation() const
 {
-	{
-		BARRETT_SCOPED_LOCK(getEmMutex());
-		if (toController.feedbackInput.valueDefined()) {
-			return toController.feedbackInput.getValue();
-		}
+	kinematics_snapshot_type snapshot;
+	if (kinematicsBase.getSnapshot(&snapshot)) {
+		return snapshot.toolOrientation;
 	}
 
 	kin.eval(getJointPositions(), getJointVelocities());
@@ -256,14 +305,25 @@ Eigen::Quaterniond Wam<DOF>::getToolOrientation() const
 }
 
 template<size_t DOF>
-inline typename Wam<DOF>::pose_type Wam<DOF>::getToolPose() const
+typename Wam<DOF>::pose_type Wam<DOF>::getToolPose() const
 {
+	// Take position and orientation from the same cycle.
+	kinematics_snapshot_type snapshot;
+	if (kinematicsBase.getSnapshot(&snapshot)) {
+		return boost::make_tuple(snapshot.toolPosition, snapshot.toolOrientation);
+	}
+
 	return boost::make_tuple(getToolPosition(), getToolOrientation());
 }
 
 template<size_t DOF>
-inline math::Matrix<6,DOF> Wam<DOF>::getToolJacobian() const
+math::Matrix<6,DOF> Wam<DOF>::getToolJacobian() const
 {
+	kinematics_snapshot_type snapshot;
+	if (kinematicsBase.getSnapshot(&snapshot)) {
+		return snapshot.toolJacobian;
+	}
+
 	kin.eval(getJointPositions(), getJointVelocities());
 	return math::Matrix<6,DOF>(kin.impl->tool_jacobian);
 }
@@ -309,14 +369,13 @@ inline void Wam<DOF>::moveHome(bool blocking, double velocity, double accelerati
 template<size_t DOF>
 inline void Wam<DOF>::moveTo(const jp_type& destination, bool blocking, double velocity, double acceleration)
 {
-//	moveTo(currentPosHelper(getJointPositions()), getJointVelocities(), destination, blocking, velocity, acceleration);
-	moveTo(currentPosHelper(getJointPositions()), /*jv_type(0.0),*/ destination, blocking, velocity, acceleration);
+	retarget(jpTrajectory, getJointPositions(), getJointVelocities(), destination, blocking, velocity, acceleration);
 }
 
 template<size_t DOF>
 inline void Wam<DOF>::moveTo(const cp_type& destination, bool blocking, double velocity, double acceleration)
 {
-	moveTo(currentPosHelper(getToolPosition()), /*cv_type(0.0),*/ destination, blocking, velocity, acceleration);
+	retarget(cpTrajectory, getToolPosition(), getToolVelocity(), destination, blocking, velocity, acceleration);
 }
 
 template<size_t DOF>
@@ -333,12 +392,19 @@ inline void Wam<DOF>::moveTo(const pose_type& destination, bool blocking, double
 
 template<size_t DOF>
 template<typename T>
-void Wam<DOF>::moveTo(const T& currentPos, /*const typename T::unitless_type& currentVel,*/ const T& destination, bool blocking, double velocity, double acceleration)
+inline void Wam<DOF>::moveTo(const T& currentPos, const T& destination, bool blocking, double velocity, double acceleration)
+{
+	moveTo(currentPos, typename detail::MoveToProfile<T>::velocity_type(0.0), destination, blocking, velocity, acceleration);
+}
+
+template<size_t DOF>
+template<typename T>
+void Wam<DOF>::moveTo(const T& currentPos, const typename detail::MoveToProfile<T>::velocity_type& currentVel, const T& destination, bool blocking, double velocity, double acceleration)
 {
 	bool started = false;
 	boost::promise<boost::thread*> threadPtrPromise;
 	boost::shared_future<boost::thread*> threadPtrFuture(threadPtrPromise.get_future());
-	boost::thread* threadPtr = new boost::thread(&Wam<DOF>::moveToThread<T>, this, boost::ref(currentPos), /*currentVel,*/ boost::ref(destination), velocity, acceleration, &started, threadPtrFuture);
+	boost::thread* threadPtr = new boost::thread(&Wam<DOF>::moveToThread<T>, this, boost::ref(currentPos), boost::ref(currentVel), boost::ref(destination), velocity, acceleration, &started, threadPtrFuture);
 	mtThreadGroup.add_thread(threadPtr);
 	threadPtrPromise.set_value(threadPtr);
 	
@@ -358,6 +424,11 @@ void Wam<DOF>::moveTo(const T& currentPos, /*const typename T::unitless_type& cu
 template<size_t DOF>
 bool Wam<DOF>::moveIsDone() const
 {
+	if (jpTrajectory.output.isConnected()) {
+		return jpTrajectory.isDone();
+	} else if (cpTrajectory.output.isConnected()) {
+		return cpTrajectory.isDone();
+	}
 	return doneMoving;
 }
 
@@ -389,24 +460,34 @@ T Wam<DOF>::currentPosHelper(const T& currentPos)
 
 template<size_t DOF>
 template<typename T>
-void Wam<DOF>::moveToThread(const T& currentPos, /*const typename T::unitless_type& currentVel,*/ const T& destination, double velocity, double acceleration, bool* started, boost::shared_future<boost::thread*> threadPtrFuture)
+void Wam<DOF>::retarget(OnlineTrajectory<T>& trajectory, const T& currentPos, const typename T::unitless_type& currentVel, const T& destination, bool blocking, double velocity, double acceleration)
+{
+	// If trajectory is already providing the reference signal, the new goal
+	// blends from its current state. Otherwise, start it from where we are now.
+	if ( !trajectory.output.isConnected() ) {
+		trajectory.reset(currentPosHelper(currentPos), currentVel);
+		trackReferenceSignal(trajectory.output);
+	}
+
+	typename OnlineTrajectory<T>::goal_id_type goal = trajectory.setGoal(destination,
+			velocity, acceleration, acceleration / detail::MOVE_TO_JERK_TIME);
+	if (blocking) {
+		trajectory.waitUntilDone(goal);
+	}
+}
+
+template<size_t DOF>
+template<typename T>
+void Wam<DOF>::moveToThread(const T& currentPos, const typename detail::MoveToProfile<T>::velocity_type& currentVel, const T& destination, double velocity, double acceleration, bool* started, boost::shared_future<boost::thread*> threadPtrFuture)
 {
 	// Only remove this thread from mtThreadGroup on orderly exit. (Don't remove on exception.)
 	bool removeThread = false;
 	
 	try {
-		std::vector<T, Eigen::aligned_allocator<T> > vec;
-		vec.push_back(currentPos);
-		vec.push_back(destination);
-
-		// TODO(dc): Use currentVel. Requires changes to math::spline<Eigen::Quaternion<T> > specialization.
-		//math::Spline<T> spline(vec, currentVel);
-		//math::TrapezoidalVelocityProfile profile(velocity, acceleration, currentVel.norm(), spline.changeInS());
-		math::Spline<T> spline(vec);
-		math::TrapezoidalVelocityProfile profile(velocity, acceleration, 0.0, spline.changeInS());
+		detail::MoveToProfile<T> profile(currentPos, currentVel, destination, velocity, acceleration);
 
 		Ramp time(NULL, 1.0);
-		Callback<double, T> trajectory(boost::bind(boost::ref(spline), boost::bind(boost::ref(profile), _1)));
+		Callback<double, T> trajectory(boost::ref(profile));
 
 		connect(time.output, trajectory.input);
 		trackReferenceSignal(trajectory.output);
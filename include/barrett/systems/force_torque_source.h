@@ -0,0 +1,156 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * force_torque_source.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_FORCE_TORQUE_SOURCE_H_
+#define BARRETT_SYSTEMS_FORCE_TORQUE_SOURCE_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math/first_order_filter.h>
+#include <barrett/products/force_torque_sensor.h>
+#include <barrett/systems/abstract/system.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Reads a ForceTorqueSensor every execution cycle and outputs the wrench
+ * applied to the tool.
+ *
+ * Reading the sensor is split in two so the execution cycle never waits on
+ * it: each cycle collects the reply to the request sent during the previous
+ * cycle, then sends the next request. The outputs are therefore one cycle
+ * old. If a reply is late, the previous values are held and
+ * getMissedSampleCount() is incremented; after MAX_MISSED_CYCLES, the request
+ * is abandoned (discarding any partial reply) and sent again.
+ *
+ * Each sample then goes through, in order:
+ *   - tool gravity compensation: if setToolMass() has been called and
+ *     toolOrientationInput has a value, the weight of the tool is removed.
+ *     toolOrientationInput is the rotation from the world frame to the sensor
+ *     frame. If the sensor's axes are aligned with the tool frame, connect
+ *     Wam::toolOrientation.output;
+ *   - the bias recorded by tare(), which is independent of the WAM's pose
+ *     when the tool is compensated;
+ *   - an optional first order low-pass filter (see setLowPass()).
+ * The outputs are undefined until the first sample arrives.
+ */
+class ForceTorqueSource : public System {
+public:
+	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
+
+// IO
+public:		Input<Eigen::Quaterniond> toolOrientationInput;
+public:		Output<cf_type> forceOutput;
+protected:	Output<cf_type>::Value* forceOutputValue;
+public:		Output<ct_type> torqueOutput;
+protected:	Output<ct_type>::Value* torqueOutputValue;
+
+
+public:
+	explicit ForceTorqueSource(ExecutionManager* em, ForceTorqueSensor* fts,
+			double omega_p = 0.0, const std::string& sysName = "ForceTorqueSource");
+	virtual ~ForceTorqueSource();
+
+	/// Subtracts the next sample from all later ones.
+	void tare();
+	void clearTare();
+
+	/// Low-pass filters the outputs with a cutoff of omega_p (rad/s). 0.0 disables the filter.
+	void setLowPass(double omega_p);
+	double getLowPass() const { return omega_p; }
+
+	/// mass is in kg. centerOfMass is in m, in the sensor frame.
+	void setToolMass(double mass, const cp_type& centerOfMass);
+	double getToolMass() const { return toolMass; }
+	const cp_type& getToolCenterOfMass() const { return toolCenterOfMass; }
+
+	/// The number of execution cycles during which the sample hadn't arrived
+	unsigned int getMissedSampleCount() const { return missedSampleCount; }
+
+
+	static const int MAX_MISSED_CYCLES = 10;
+	static constexpr double GRAVITY = 9.805;  ///< m/s^2, as used by GravityCompensator
+
+protected:
+	/// For testing: the sample comes from requestSample() and collectSample() instead of a ForceTorqueSensor.
+	ForceTorqueSource(ExecutionManager* em, double omega_p, const std::string& sysName);
+
+	virtual bool inputsValid() { return true; }  // toolOrientationInput is optional
+	virtual void onExecutionManagerChanged();
+	void getSamplePeriodFromEM();
+	void updateFilters();
+
+	virtual void operate();
+
+	virtual void requestSample();
+	/// Returns false if the sample hasn't arrived yet.
+	virtual bool collectSample(cf_type* force, ct_type* torque);
+	/// Gives up on the outstanding request.
+	virtual void cancelSample();
+
+
+	ForceTorqueSensor* fts;
+	double T_s;
+	double omega_p;
+	double toolMass;
+	cp_type toolCenterOfMass;
+	bool tarePending;
+	cf_type forceBias;
+	ct_type torqueBias;
+
+	bool requested, sampleDefined;
+	int missedCycles;
+	unsigned int missedSampleCount;
+
+	cf_type rawForce, force, toolWeight;
+	ct_type rawTorque, torque;
+	math::FirstOrderFilter<cf_type> forceFilter;
+	math::FirstOrderFilter<ct_type> torqueFilter;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(ForceTorqueSource);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_FORCE_TORQUE_SOURCE_H_ */
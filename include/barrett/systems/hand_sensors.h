@@ -0,0 +1,199 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * hand_sensors.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_HAND_SENSORS_H_
+#define BARRETT_SYSTEMS_HAND_SENSORS_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/matrix.h>
+#include <barrett/thread/seqlock.h>
+#include <barrett/products/hand.h>
+#include <barrett/products/tactile_puck.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/abstract/system.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Reads a Hand's sensors from an execution cycle, each at its own rate.
+ *
+ * Hand::update() reads every requested sensor before it returns, which can
+ * hold the bus for a long time: a FULL tactile read is
+ * TactilePuck::NUM_FULL_MESSAGES frames from each TactilePuck. It also yields
+ * afterward, which an execution cycle must not do. HandSensors instead reads
+ * the Pucks directly, splits the work into small reads (the position, the
+ * fingertip torques, and the TOP10 or FULL tactile data of one TactilePuck),
+ * and does at most maxReadsPerCycle of them each execution cycle. When a
+ * sensor comes due (see setRate()), its reads are queued; queued reads are
+ * served round-robin, so no sensor can starve the others. The bus time taken
+ * per cycle is bounded, and a WAM sharing the bus keeps its deadlines.
+ *
+ * If a sensor comes due again before all of its reads have been served, the
+ * rates ask for more than maxReadsPerCycle allows; getOverrunCount() counts
+ * these.
+ *
+ * The latest values are available on the outputs, which are undefined until
+ * the corresponding sensor is first read, and, from any thread, through
+ * getSnapshot(). TOP10 and FULL reads of a TactilePuck both update its row
+ * of the tactile data.
+ *
+ * Example:
+ *   systems::HandSensors sensors(pm.getExecutionManager(), hand);
+ *   sensors.setRate(Hand::S_POSITION | Hand::S_FINGERTIP_TORQUE, 100.0);
+ *   sensors.setRate(Hand::S_TACT_FULL, 25.0);
+ *
+ * Don't call Hand::update() while a HandSensors is reading the same Hand.
+ */
+class HandSensors : public System {
+public:
+	typedef Hand::jp_type jp_type;
+	typedef Hand::v_type v_type;
+	/// One row per TactilePuck
+	typedef math::Matrix<Hand::DOF, TactilePuck::NUM_SENSORS> tactile_type;
+
+// IO
+public:		Output<jp_type> innerJpOutput;
+protected:	Output<jp_type>::Value* innerJpOutputValue;
+public:		Output<jp_type> outerJpOutput;
+protected:	Output<jp_type>::Value* outerJpOutputValue;
+public:		Output<v_type> fingertipTorqueOutput;
+protected:	Output<v_type>::Value* fingertipTorqueOutputValue;
+public:		Output<tactile_type> tactileOutput;
+protected:	Output<tactile_type>::Value* tactileOutputValue;
+
+
+public:
+	struct Snapshot {
+		Snapshot();
+
+		jp_type innerJp, outerJp;
+		v_type fingertipTorque;
+		tactile_type tactile;
+
+		/// highResolutionSystemTime() of each sensor's latest read, or 0.0 if it hasn't been read
+		double positionTime, fingertipTorqueTime, tactileTime;
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	/// All rates start at 0.0 (not read).
+	HandSensors(ExecutionManager* em, Hand* hand, size_t maxReadsPerCycle = 1,
+			const std::string& sysName = "HandSensors");
+	virtual ~HandSensors();
+
+	/** Reads the sensors in the Hand::S_* mask sensors rate times per second
+	 * (at most once per execution cycle). A rate of 0.0 stops reading them.
+	 */
+	void setRate(unsigned int sensors, double rate);
+	/// sensor is a single Hand::S_* flag.
+	double getRate(unsigned int sensor) const;
+
+	size_t getMaxReadsPerCycle() const { return maxReadsPerCycle; }
+	void setMaxReadsPerCycle(size_t newMaxReadsPerCycle);
+
+	size_t getOverrunCount() const { return overrunCount; }
+
+	/// Wait-free for the execution cycle. Returns false if nothing has been read yet.
+	bool getSnapshot(Snapshot* snapshot) const;
+
+protected:
+	/// For subclasses that read something other than a Hand
+	HandSensors(ExecutionManager* em, bool hasFingertipTorqueSensors,
+			size_t numTactilePucks, size_t maxReadsPerCycle,
+			const std::string& sysName);
+
+	// The reads. Each is called from operate().
+	virtual void readPosition(jp_type* innerJp, jp_type* outerJp);
+	virtual void readFingertipTorque(v_type* fingertipTorque);
+	virtual void readTactTop10(size_t i, TactilePuck::v_type* tactile);
+	virtual void readTactFull(size_t i, TactilePuck::v_type* tactile);
+
+	virtual void onExecutionManagerChanged();
+	void getSamplePeriodFromEM();
+
+	virtual void operate();
+
+
+	// The sensors are numbered by the bit of their Hand::S_* flag.
+	enum Sensor {
+		POSITION = 0,  // Hand::S_POSITION
+		FINGERTIP_TORQUE = 1,  // Hand::S_FINGERTIP_TORQUE
+		TACT_FULL = 2,  // Hand::S_TACT_FULL
+		TACT_TOP10 = 3,  // Hand::S_TACT_TOP10
+		NUM_SENSORS
+	};
+	static const size_t MAX_READS = 2 + 2*Hand::DOF;
+
+	void init(bool hasFingertipTorqueSensors, size_t numTactilePucks);
+	void addRead(enum Sensor sensor, size_t i);
+	void read(size_t r);
+
+	Hand* hand;
+	double T_s;
+	size_t maxReadsPerCycle;
+
+	double rates[NUM_SENSORS];
+	long nextDue[NUM_SENSORS];  // In cycles
+	long cycle;
+	size_t overrunCount;
+
+	// The reads, in round-robin order
+	size_t numReads;
+	enum Sensor readSensor[MAX_READS];
+	size_t readIndex[MAX_READS];  // The TactilePuck, for tactile reads
+	bool pending[MAX_READS];
+	size_t nextRead;
+
+	Snapshot current;
+	bool hasPosition, hasFingertipTorque, hasTactile;
+	TactilePuck::v_type tactileTmp;
+	Hand::encoder_type encoderTmp[Hand::DOF];
+	int fttTmp[Hand::DOF];
+	thread::SeqLock<Snapshot> snapshotLock;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(HandSensors);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_HAND_SENSORS_H_ */
@@ -0,0 +1,183 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * haptic_loop.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_HAPTIC_LOOP_H_
+#define BARRETT_SYSTEMS_HAPTIC_LOOP_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/thread/seqlock.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+#include <barrett/systems/kinematics_base.h>
+#include <barrett/systems/wam.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Runs haptic Systems in their own, faster, ExecutionManager.
+ *
+ * A HapticLoop connects a small graph of haptic Systems to a Wam without
+ * making them part of the Wam's (typically 500 Hz) ExecutionManager. Each
+ * cycle of em, the loop:
+ *   - reads the Wam's latest kinematics snapshot (see KinematicsBase) and
+ *     outputs the tool position, extrapolated to the current time using the
+ *     tool velocity, and the tool velocity;
+ *   - maps the force on toolForceInput to joint torques through the
+ *     translational rows of the tool Jacobian;
+ *   - writes the torques to a thread::SeqLock mailbox, which the Wam's
+ *     LowLevelWamWrapper adds to its input before each setTorques().
+ *
+ * Nothing is shared through a lock, so the haptic graph's cost and jitter
+ * don't affect the main execution cycle, and vice versa. The Pucks still
+ * receive torques once per main cycle, but those torques are computed from
+ * a position at most one haptic period old.
+ *
+ * If em stops, the LowLevelWamWrapper stops applying the mailbox's torque
+ * after a few main cycles. Similarly, the loop stops writing torques if the
+ * kinematics snapshot is older than maxAge.
+ *
+ * Example:
+ *   systems::RealTimeExecutionManager hapticEm(0.00025, 55);  // 4 kHz
+ *   systems::HapticLoop<DOF> loop(&hapticEm, wam);
+ *   systems::HapticScene scene;
+ *   connect(loop.toolPosition, scene.input);
+ *   ... scene.depthOutput and scene.directionOutput to a force ...
+ *   connect(force.output, loop.toolForceInput);
+ *   hapticEm.start();
+ */
+template<size_t DOF>
+class HapticLoop {
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+public:		System::Output<cp_type>& toolPosition;
+public:		System::Output<cv_type>& toolVelocity;
+public:		System::Input<cf_type>& toolForceInput;
+
+
+public:
+	HapticLoop(ExecutionManager* em, Wam<DOF>& wam, double maxAge = 0.005,
+			const std::string& sysName = "HapticLoop");
+	/** Reads snapshots from kinematicsBase instead of a Wam's.
+	 *
+	 * The torques are only written to getTorqueMailbox(); pass it to
+	 * LowLevelWamWrapper::setTorqueMailbox() to apply them.
+	 */
+	HapticLoop(ExecutionManager* em, const KinematicsBase<DOF>& kinematicsBase,
+			double maxAge = 0.005, const std::string& sysName = "HapticLoop");
+	~HapticLoop();
+
+	const thread::SeqLock<jt_type>& getTorqueMailbox() const { return mailbox; }
+
+	static const int MAX_SNAPSHOT_READ_ATTEMPTS = 3;
+
+protected:
+	class Source : public System {
+	// IO
+	public:		Output<cp_type> toolPosition;
+	protected:	typename Output<cp_type>::Value* toolPositionValue;
+	public:		Output<cv_type> toolVelocity;
+	protected:	typename Output<cv_type>::Value* toolVelocityValue;
+
+
+	public:
+		Source(HapticLoop* parent, ExecutionManager* em,
+				const std::string& sysName = "HapticLoop::Source");
+		virtual ~Source() { mandatoryCleanUp(); }
+
+	protected:
+		virtual void operate();
+
+		HapticLoop* parent;
+		cp_type tp;
+		cv_type tv;
+
+	private:
+		DISALLOW_COPY_AND_ASSIGN(Source);
+
+	public:
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	class Sink : public System, public SingleInput<cf_type> {
+	public:
+		Sink(HapticLoop* parent, ExecutionManager* em,
+				const std::string& sysName = "HapticLoop::Sink");
+		virtual ~Sink() { mandatoryCleanUp(); }
+
+	protected:
+		virtual void operate();
+
+		HapticLoop* parent;
+
+	private:
+		DISALLOW_COPY_AND_ASSIGN(Sink);
+	};
+
+
+	// Updates snapshot and fresh. Returns fresh.
+	bool updateSnapshot();
+
+	const KinematicsBase<DOF>& kinematicsBase;
+	LowLevelWamWrapper<DOF>* llww;  // NULL if the caller applies the mailbox
+	double maxAge;
+
+	typename KinematicsBase<DOF>::Snapshot snapshot, pendingSnapshot;
+	bool haveSnapshot;
+	bool fresh;  // True if snapshot is no older than maxAge
+	thread::SeqLock<jt_type> mailbox;
+
+	Source source;
+	Sink sink;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(HapticLoop);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/systems/detail/haptic_loop-inl.h>
+
+
+#endif /* BARRETT_SYSTEMS_HAPTIC_LOOP_H_ */
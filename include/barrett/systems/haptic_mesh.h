@@ -0,0 +1,110 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * haptic_mesh.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_HAPTIC_MESH_H_
+#define BARRETT_SYSTEMS_HAPTIC_MESH_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math/triangle_mesh.h>
+#include <barrett/systems/abstract/haptic_object.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** A solid keep-out volume described by a closed triangle mesh.
+ *
+ * The mesh is loaded from an STL or OBJ file (see math::TriangleMesh) and
+ * indexed when the HapticMesh is constructed. Each cycle, if the tool is
+ * inside the mesh, the depth and direction to the nearest point on its surface
+ * are output. As with HapticBall, a tool that has been pushed through by more
+ * than maxDepth is released; this also bounds the number of triangles examined
+ * each cycle to those within maxDepth of the tool.
+ */
+class HapticMesh : public HapticObject {
+	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
+
+public:
+	/// scale converts the file's units to meters.
+	explicit HapticMesh(const std::string& fileName, double scale = 1.0, double maxDepth = 0.02,
+			const std::string& sysName = "HapticMesh") :
+		HapticObject(sysName), mesh(fileName, scale), md(maxDepth), depth(0.0), dir(0.0) {}
+	explicit HapticMesh(const math::TriangleMesh& triangleMesh, double maxDepth = 0.02,
+			const std::string& sysName = "HapticMesh") :
+		HapticObject(sysName), mesh(triangleMesh), md(maxDepth), depth(0.0), dir(0.0) {}
+	virtual ~HapticMesh() { mandatoryCleanUp(); }
+
+	void setMaxDepth(double maxDepth) {
+		BARRETT_SCOPED_LOCK(getEmMutex());
+		md = maxDepth;
+	}
+	double getMaxDepth() const { return md; }
+
+	const math::TriangleMesh& getMesh() const { return mesh; }
+
+protected:
+	virtual void operate() {
+		math::TriangleMesh::vector_type direction;
+		if (mesh.penetration(input.getValue(), md, &depth, &direction)) {
+			dir = direction;
+		} else {
+			depth = 0.0;
+			dir.setZero();
+		}
+
+		depthOutputValue->setData(&depth);
+		directionOutputValue->setData(&dir);
+	}
+
+	math::TriangleMesh mesh;
+	double md;
+
+	double depth;
+	cf_type dir;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(HapticMesh);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_HAPTIC_MESH_H_ */
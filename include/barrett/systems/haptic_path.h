@@ -35,6 +35,7 @@
 #include <cmath>
 #include <cassert>
 #include <vector>
+#include <algorithm>
 
 #define EIGEN_USE_NEW_STDVECTOR
 #include <Eigen/Core>
@@ -43,6 +44,7 @@
 #include <barrett/detail/ca_macro.h>
 #include <barrett/units.h>
 #include <barrett/math.h>
+#include <barrett/math/aabb_tree.h>
 #include <barrett/systems/abstract/haptic_object.h>
 
 
@@ -50,11 +52,21 @@ namespace barrett {
 namespace systems {
 
 
+/** Guides the tool along a path.
+ *
+ * The nearest point on the path is found each cycle without scanning the
+ * whole path: a math::AabbTree over a polyline approximation of the path's
+ * spline finds the nearest polyline segment (starting from the previous
+ * cycle's segment, which prunes nearly the entire tree), the point is
+ * projected onto that segment in closed form, and a few Newton steps move it
+ * onto the spline itself.
+ */
 class HapticPath : public HapticObject {
 	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
 
 	static constexpr double COARSE_STEP = 0.01;
-	static constexpr double FINE_STEP = 0.0001;
+	static constexpr double POLYLINE_STEP = COARSE_STEP / 4.0;
+	static const int NEWTON_ITERATIONS = 3;
 
 public:		System::Output<cp_type> tangentDirectionOutput;
 protected:	System::Output<cp_type>::Value* tangentDirectionOutputValue;
@@ -64,7 +76,7 @@ public:
 			const std::string& sysName = "HapticPath") :
 		HapticObject(sysName),
 		tangentDirectionOutput(this, &tangentDirectionOutputValue),
-		nearestIndex(0), spline(NULL)
+		nearestIndex(math::AabbTree::NONE), spline(NULL)
 	{
 		// Sample the path
 		cp_type prev = path[0];
@@ -75,6 +87,20 @@ public:
 			}
 		}
 		spline = new math::Spline<cp_type>(coarsePath);
+
+		// Approximate the spline with a polyline and index its segments
+		size_t numSegments = std::max(1, static_cast<int>(std::ceil(spline->changeInS() / POLYLINE_STEP)));
+		double step = spline->changeInS() / numSegments;
+		for (size_t i = 0; i <= numSegments; ++i) {
+			polylineS.push_back(spline->initialS() + i * step);
+			polyline.push_back(spline->eval(polylineS.back()));
+		}
+
+		std::vector<math::AabbTree::Box> boxes;
+		for (size_t i = 0; i < numSegments; ++i) {
+			boxes.push_back(math::AabbTree::Box(polyline[i], polyline[i+1]));
+		}
+		tree.build(boxes);
 	}
 
 	virtual ~HapticPath() {
@@ -83,34 +109,69 @@ public:
 	}
 
 protected:
+	// Closed-form projection onto a polyline segment
+	struct SegmentDistance {
+		explicit SegmentDistance(const HapticPath& hp_) : hp(hp_) {}
+
+		double param(size_t i, const cp_type& p) const {
+			const cp_type& a = hp.polyline[i];
+			cp_type ab = hp.polyline[i+1] - a;
+			double len2 = ab.squaredNorm();
+			return (len2 > 0.0) ? math::saturate((p - a).dot(ab) / len2, 0.0, 1.0) : 0.0;
+		}
+		double operator() (size_t i, const math::AabbTree::vector_type& p) const {
+			double t = param(i, p);
+			return (hp.polyline[i] + t * (hp.polyline[i+1] - hp.polyline[i]) - p).squaredNorm();
+		}
+
+		const HapticPath& hp;
+	};
+
 	virtual void operate() {
 		const cp_type& cp = input.getValue();
 
-		// Coarse search
-		minDist = (coarsePath[nearestIndex] - cp).norm();
-		for (size_t i = 0; i < coarsePath.size(); ++i) {
-			double dist = (coarsePath[i] - cp).norm();
-			if (dist < minDist) {
-				minDist = dist;
-				nearestIndex = i;
+		// Nearest polyline segment, starting from last cycle's
+		SegmentDistance segmentDistance(*this);
+		double d2;
+		nearestIndex = tree.nearest(cp, segmentDistance, &d2, nearestIndex);
+
+		// Project onto the segment, then refine the parameter on the spline
+		double t = segmentDistance.param(nearestIndex, cp);
+		double sLow = polylineS[nearestIndex];
+		double sHigh = polylineS[nearestIndex + 1];
+		double sNearest = sLow + t * (sHigh - sLow);
+
+		// The spline's nearest point is within a chord's length of the polyline's.
+		double chord = sHigh - sLow;
+		sLow = math::max(sLow - chord, spline->initialS());
+		sHigh = math::min(sHigh + chord, spline->finalS());
+
+		spline->eval(sNearest, &p, &v, &a);
+		minDist = (p - cp).norm();
+		for (int i = 0; i < NEWTON_ITERATIONS; ++i) {
+			// Minimize |p(s) - cp|^2
+			double dfds = (p - cp).dot(v);
+			double d2fds2 = v.squaredNorm() + (p - cp).dot(a);
+			if (d2fds2 <= 0.0) {
+				break;
 			}
-		}
 
-		// Fine search
-		// TODO(dc): Can we do this without relying on Spline's implementation?
-		double sNearest = spline->getImplementation()->ss[nearestIndex];
-		double sLow = sNearest - COARSE_STEP;
-		double sHigh = sNearest + COARSE_STEP;
-		for (double s = sLow; s <= sHigh; s += FINE_STEP) {
-			double dist = (spline->eval(s) - cp).norm();
-			if (dist < minDist) {
-				minDist = dist;
-				sNearest = s;
+			double s = math::saturate(sNearest - dfds / d2fds2, sLow, sHigh);
+			spline->eval(s, &pNext, &vNext, &aNext);
+			double dist = (pNext - cp).norm();
+			if (dist >= minDist) {
+				break;
 			}
+
+			sNearest = s;
+			minDist = dist;
+			p = pNext;
+			v = vNext;
+			a = aNext;
 		}
 
-		dir = (spline->eval(sNearest) - cp).normalized();
-		tangentDir = spline->evalDerivative(sNearest).normalized();
+		dir = (p - cp).normalized();
+		tangentDir = v.normalized();
 
 		depthOutputValue->setData(&minDist);
 		directionOutputValue->setData(&dir);
@@ -121,10 +182,15 @@ protected:
 	size_t nearestIndex;
 	cf_type dir;
 	cp_type tangentDir;
+	cp_type p, v, a, pNext, vNext, aNext;
 
 	std::vector<cp_type, Eigen::aligned_allocator<cp_type> > coarsePath;
 	math::Spline<cp_type>* spline;
 
+	std::vector<cp_type, Eigen::aligned_allocator<cp_type> > polyline;
+	std::vector<double> polylineS;
+	math::AabbTree tree;
+
 private:
 	DISALLOW_COPY_AND_ASSIGN(HapticPath);
 
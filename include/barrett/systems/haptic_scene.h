@@ -0,0 +1,374 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * haptic_scene.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_HAPTIC_SCENE_H_
+#define BARRETT_SYSTEMS_HAPTIC_SCENE_H_
+
+
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math.h>
+#include <barrett/math/aabb_tree.h>
+#include <barrett/math/triangle_mesh.h>
+#include <barrett/systems/abstract/haptic_object.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Many solid haptic primitives in a single System.
+ *
+ * Each Primitive is a keep-out volume: when the tool is inside it, the
+ * Primitive reports how deep and in which direction to push the tool back
+ * to its surface. The depth-weighted directions of all touched Primitives are
+ * summed, and the magnitude and direction of that sum are output, so
+ * HapticScene can replace a HapticBall/HapticBox/Summer network.
+ *
+ * Meshes loaded from STL or OBJ files can be added alongside the analytic
+ * Primitives; see HapticMesh.
+ *
+ * Primitives are indexed in a math::AabbTree, so each cycle only evaluates the
+ * handful whose bounds contain the tool. Unbounded Primitives (such as
+ * Planes) are evaluated every cycle.
+ *
+ * Unlike HapticBall and HapticBox, which switch to holding the tool inside once
+ * it has pushed through, HapticScene simply ignores a Primitive while the tool
+ * is more than the maximum depth inside it.
+ *
+ * Primitives may be added while the scene is running, but each add() rebuilds
+ * the tree, so large scenes should be built before they are connected.
+ */
+class HapticScene : public HapticObject {
+	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
+
+public:
+	class Primitive {
+	public:
+		virtual ~Primitive() {}
+
+		/// Must contain the whole volume. Only called by add().
+		virtual math::AabbTree::Box getBounds() const = 0;
+		virtual bool isBounded() const { return true; }
+
+		/** If p is inside the Primitive, sets depth and the unit direction
+		 * that leads back out, and returns true. Called from the execution
+		 * cycle: it must not block or allocate.
+		 */
+		virtual bool penetration(const cp_type& p, double* depth, cf_type* dir) const = 0;
+
+		/** Called when penetration() returned true last cycle but was not
+		 * called or returned false this cycle. Primitives that remember
+		 * where the tool came in reset that state here.
+		 */
+		virtual void leave() const {}
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	class Sphere : public Primitive {
+	public:
+		Sphere(const cp_type& center, double radius) : c(center), r(radius) {}
+
+		virtual math::AabbTree::Box getBounds() const {
+			math::AabbTree::Box b(c, c);
+			b.inflate(r);
+			return b;
+		}
+		virtual bool penetration(const cp_type& p, double* depth, cf_type* dir) const {
+			*dir = p - c;
+			double mag = dir->norm();
+			if (mag >= r  ||  mag == 0.0) {
+				return false;
+			}
+			*depth = r - mag;
+			*dir /= mag;
+			return true;
+		}
+
+	protected:
+		cp_type c;
+		double r;
+	};
+
+	/// Axis-aligned. Like HapticBox, pushes back through the face the tool entered by.
+	class Box : public Primitive {
+	public:
+		Box(const cp_type& center, const math::Vector<3>::type& size) :
+			c(center), halfSize(size / 2.0), index(-1) {}
+
+		virtual math::AabbTree::Box getBounds() const {
+			return math::AabbTree::Box(c - halfSize, c + halfSize);
+		}
+		virtual bool penetration(const cp_type& p, double* depth, cf_type* dir) const {
+			cf_type pos = p - c;
+			math::Vector<3>::type inside = halfSize - pos.cwiseAbs();
+			if ((inside.array() <= 0.0).any()) {
+				index = -1;
+				return false;
+			}
+
+			if (index < 0) {  // if we weren't in the box last time
+				// Find the entry face
+				inside.minCoeff(&index);
+			}
+			*depth = inside[index];
+			*dir = math::sign(pos[index]) * cf_type::Unit(index);
+			return true;
+		}
+		virtual void leave() const { index = -1; }
+
+	protected:
+		cp_type c;
+		math::Vector<3>::type halfSize;
+		mutable int index;
+	};
+
+	/// The points within radius of the segment from a to b
+	class Capsule : public Primitive {
+	public:
+		Capsule(const cp_type& a_, const cp_type& b_, double radius) :
+			a(a_), ab(b_ - a_), r(radius) {}
+
+		virtual math::AabbTree::Box getBounds() const {
+			math::AabbTree::Box b(a, a + ab);
+			b.inflate(r);
+			return b;
+		}
+		virtual bool penetration(const cp_type& p, double* depth, cf_type* dir) const {
+			double len2 = ab.squaredNorm();
+			double t = (len2 > 0.0) ? math::saturate((p - a).dot(ab) / len2, 0.0, 1.0) : 0.0;
+			*dir = p - a - t * ab;
+			double mag = dir->norm();
+			if (mag >= r  ||  mag == 0.0) {
+				return false;
+			}
+			*depth = r - mag;
+			*dir /= mag;
+			return true;
+		}
+
+	protected:
+		cp_type a;
+		cf_type ab;
+		double r;
+	};
+
+	/// The half-space behind the plane through point with outward normal
+	class Plane : public Primitive {
+	public:
+		Plane(const cp_type& point, const cf_type& normal) :
+			p0(point), n(normal.normalized()) {}
+
+		virtual math::AabbTree::Box getBounds() const { return math::AabbTree::Box(); }
+		virtual bool isBounded() const { return false; }
+		virtual bool penetration(const cp_type& p, double* depth, cf_type* dir) const {
+			double d = n.dot(p - p0);
+			if (d >= 0.0) {
+				return false;
+			}
+			*depth = -d;
+			*dir = n;
+			return true;
+		}
+
+	protected:
+		cp_type p0;
+		cf_type n;
+	};
+
+	/// A closed math::TriangleMesh. Only triangles within maxDepth of the tool are examined.
+	class Mesh : public Primitive {
+	public:
+		explicit Mesh(const math::TriangleMesh& triangleMesh, double maxDepth = 0.02) :
+			mesh(triangleMesh), md(maxDepth) {}
+
+		virtual math::AabbTree::Box getBounds() const { return mesh.getBounds(); }
+		virtual bool penetration(const cp_type& p, double* depth, cf_type* dir) const {
+			math::TriangleMesh::vector_type direction;
+			if (mesh.penetration(p, md, depth, &direction)) {
+				*dir = direction;
+				return true;
+			}
+			return false;
+		}
+
+		const math::TriangleMesh& getMesh() const { return mesh; }
+
+	protected:
+		math::TriangleMesh mesh;
+		double md;
+	};
+
+
+	explicit HapticScene(double maxDepth = 0.02, const std::string& sysName = "HapticScene") :
+		HapticObject(sysName), md(maxDepth), depth(0.0), dir(0.0) {}
+	virtual ~HapticScene() {
+		mandatoryCleanUp();
+		for (size_t i = 0; i < primitives.size(); ++i) {
+			delete primitives[i];
+		}
+	}
+
+	/// Takes ownership of primitive. Returns its index.
+	size_t add(Primitive* primitive) {
+		BARRETT_SCOPED_LOCK(getEmMutex());
+
+		primitives.push_back(primitive);
+		inContact.push_back(false);
+		contacts.reserve(primitives.size());
+		lastContacts.reserve(primitives.size());
+		if (primitive->isBounded()) {
+			bounded.push_back(primitives.size() - 1);
+			boxes.push_back(primitive->getBounds());
+			tree.build(boxes);
+		} else {
+			unbounded.push_back(primitives.size() - 1);
+		}
+		return primitives.size() - 1;
+	}
+	size_t addSphere(const cp_type& center, double radius) {
+		return add(new Sphere(center, radius));
+	}
+	size_t addBox(const cp_type& center, const math::Vector<3>::type& size) {
+		return add(new Box(center, size));
+	}
+	size_t addCapsule(const cp_type& a, const cp_type& b, double radius) {
+		return add(new Capsule(a, b, radius));
+	}
+	size_t addPlane(const cp_type& point, const cf_type& normal) {
+		return add(new Plane(point, normal));
+	}
+	/// Searches within the scene's current maximum depth
+	size_t addMesh(const math::TriangleMesh& mesh) {
+		return add(new Mesh(mesh, md));
+	}
+
+	size_t size() const { return primitives.size(); }
+	const Primitive& getPrimitive(size_t i) const { return *primitives[i]; }
+
+	void setMaxDepth(double maxDepth) {
+		BARRETT_SCOPED_LOCK(getEmMutex());
+		md = maxDepth;
+	}
+	double getMaxDepth() const { return md; }
+
+protected:
+	// Accumulates the force from each candidate found by the tree
+	struct Accumulator {
+		Accumulator(HapticScene& scene_, const cp_type& p_, cf_type* force_) :
+			scene(scene_), p(p_), force(force_) {}
+
+		void operator() (size_t i) {
+			scene.accumulate(scene.bounded[i], p, force);
+		}
+
+		HapticScene& scene;
+		const cp_type& p;
+		cf_type* force;
+	};
+
+	void accumulate(size_t i, const cp_type& p, cf_type* force) {
+		double d;
+		cf_type n;
+		if (primitives[i]->penetration(p, &d, &n)) {
+			inContact[i] = true;
+			contacts.push_back(i);  // Never allocates: capacity is reserved by add()
+			if (d <= md) {
+				*force += d * n;
+			}
+		}
+	}
+
+	virtual void operate() {
+		const cp_type& p = input.getValue();
+
+		force.setZero();
+		contacts.clear();
+		for (size_t i = 0; i < unbounded.size(); ++i) {
+			accumulate(unbounded[i], p, &force);
+		}
+		Accumulator acc(*this, p, &force);
+		tree.forEachIntersecting(math::AabbTree::Box(p, p), acc);
+
+		// The tree doesn't visit Primitives the tool has moved away from
+		for (size_t i = 0; i < lastContacts.size(); ++i) {
+			if ( !inContact[lastContacts[i]] ) {
+				primitives[lastContacts[i]]->leave();
+			}
+		}
+		for (size_t i = 0; i < contacts.size(); ++i) {
+			inContact[contacts[i]] = false;
+		}
+		contacts.swap(lastContacts);
+
+		depth = force.norm();
+		if (depth > 0.0) {
+			dir = force / depth;
+		} else {
+			dir.setZero();
+		}
+
+		depthOutputValue->setData(&depth);
+		directionOutputValue->setData(&dir);
+	}
+
+	double md;
+
+	std::vector<Primitive*> primitives;
+	std::vector<size_t> bounded, unbounded;  // Indices into primitives
+	std::vector<math::AabbTree::Box> boxes;  // Of bounded primitives
+	math::AabbTree tree;
+
+	// Primitives the tool was inside during this and the previous cycle
+	std::vector<size_t> contacts, lastContacts;
+	std::vector<bool> inContact;
+
+	cf_type force;
+	double depth;
+	cf_type dir;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(HapticScene);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_HAPTIC_SCENE_H_ */
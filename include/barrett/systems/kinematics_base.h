@@ -32,11 +32,14 @@
 #define BARRETT_SYSTEMS_KINEMATICS_BASE_H_
 
 
+#include <Eigen/Geometry>
 #include <libconfig.h++>
 
 #include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
 #include <barrett/units.h>
 #include <barrett/math/kinematics.h>
+#include <barrett/thread/seqlock.h>
 #include <barrett/systems/abstract/system.h>
 
 
@@ -59,8 +62,17 @@ private:
 };
 
 
+/** Evaluates forward kinematics once per execution cycle.
+ *
+ * In addition to passing the math::Kinematics object down the graph, each
+ * evaluation publishes a Snapshot of the tool pose, velocity, and Jacobian.
+ * Other threads can read the most recent Snapshot with getSnapshot() without
+ * locking the ExecutionManager's mutex or re-evaluating the kinematics.
+ */
 template<size_t DOF>
 class KinematicsBase : public System {
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
 // IO
 public:		Input<typename units::JointPositions<DOF>::type> jpInput;
 public:		Input<typename units::JointVelocities<DOF>::type> jvInput;
@@ -75,16 +87,54 @@ public:
 		kinOutput(this, &kinOutputValue), kin(setting) {}
 	virtual ~KinematicsBase() { mandatoryCleanUp(); }
 
+
+	struct Snapshot {
+		cp_type toolPosition;
+		Eigen::Quaterniond toolOrientation;
+		cv_type toolVelocity;
+		math::Matrix<6,DOF> toolJacobian;
+		double timestamp;  ///< highResolutionSystemTime() at evaluation
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	/// Copies the result of the most recent evaluation into snapshot. Wait-free for the execution cycle. Returns false if operate() has never run.
+	bool getSnapshot(Snapshot* snapshot) const {
+		if ( !snapshotLock.hasBeenWritten() ) {
+			return false;
+		}
+		snapshotLock.read(snapshot);
+		return true;
+	}
+	/// Like getSnapshot(), but gives up after maxAttempts reads interrupted by the execution cycle, so it can be used from a higher-priority real-time thread. *snapshot is unspecified if it returns false.
+	bool tryGetSnapshot(Snapshot* snapshot, int maxAttempts) const {
+		return snapshotLock.hasBeenWritten()  &&  snapshotLock.tryRead(snapshot, maxAttempts);
+	}
+
 protected:
 	virtual void operate() {
 		kin.eval(jpInput.getValue(), jvInput.getValue());
 		kinOutputValue->setData(&kin);
+
+		Snapshot& s = snapshotLock.beginWrite();
+		s.toolPosition.copyFrom(kin.impl->tool->origin_pos);
+		rot.copyFrom(kin.impl->tool->rot_to_world);
+		s.toolOrientation = rot.transpose();
+		s.toolVelocity.copyFrom(kin.impl->tool_velocity);
+		s.toolJacobian.copyFrom(kin.impl->tool_jacobian);
+		s.timestamp = highResolutionSystemTime();
+		snapshotLock.endWrite();
 	}
 
 	math::Kinematics<DOF> kin;
+	math::Matrix<3,3> rot;
+	thread::SeqLock<Snapshot> snapshotLock;
 
 private:
 	DISALLOW_COPY_AND_ASSIGN(KinematicsBase);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
 
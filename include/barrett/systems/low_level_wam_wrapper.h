@@ -42,6 +42,7 @@
 #include <barrett/products/puck.h>
 #include <barrett/products/low_level_wam.h>
 #include <barrett/products/safety_module.h>
+#include <barrett/thread/seqlock.h>
 
 #include <barrett/systems/abstract/execution_manager.h>
 #include <barrett/systems/abstract/system.h>
@@ -74,6 +75,20 @@ public:
 
 	thread::Mutex& getEmMutex() const { return sink.getEmMutex(); }
 
+	/** Adds the latest torque written to mailbox to the input torque before
+	 * each call to LowLevelWam::setTorques().
+	 *
+	 * This lets a loop running outside of the ExecutionManager (see HapticLoop)
+	 * contribute torques without a lock. The mailbox is read with a bounded
+	 * number of attempts (see thread::SeqLockReader), so the execution cycle
+	 * never waits on the writer. If no new torque is read for
+	 * MAX_STALE_CYCLES consecutive cycles, the mailbox's torque is ignored
+	 * until it is written again. Pass NULL to stop reading the mailbox.
+	 */
+	void setTorqueMailbox(const thread::SeqLock<jt_type>* mailbox);
+
+	static const int MAX_STALE_CYCLES = 3;
+
 protected:
 	class Sink : public System, public SingleInput<jt_type> {
 	public:
@@ -81,7 +96,7 @@ protected:
 				const std::string& sysName = "LowLevelWamWrapper::Sink") :
 			System(sysName),
 			SingleInput<jt_type>(this),
-			parent(parent)
+			parent(parent), mailbox(MAX_STALE_CYCLES), jt(0.0)
 		{
 			// Update every execution cycle because this is a sink.
 			if (em != NULL) {
@@ -95,8 +110,16 @@ protected:
 
 		LowLevelWamWrapper* parent;
 
+		thread::SeqLockReader<jt_type> mailbox;
+		jt_type jt;
+
+		friend class LowLevelWamWrapper;
+
 	private:
 		DISALLOW_COPY_AND_ASSIGN(Sink);
+
+	public:
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 	};
 
 
@@ -0,0 +1,183 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * online_trajectory.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_ONLINE_TRAJECTORY_H_
+#define BARRETT_SYSTEMS_ONLINE_TRAJECTORY_H_
+
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/jerk_limited_profile.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Generates a jerk-limited reference signal toward a goal that can be changed at any time.
+ *
+ * Goals are passed to the execution cycle through a lock-free queue. Each
+ * cycle, the newest queued goal (if any) replaces the current one and a new
+ * math::SynchronizedJerkLimitedProfile is planned from the current position,
+ * velocity, and acceleration, so the output blends smoothly into the new
+ * motion. Planning is bounded-time and doesn't allocate.
+ *
+ * Threads can block in waitUntilDone() until a goal is reached. The execution
+ * cycle publishes the ID of each goal it reaches in an atomic, which waiting
+ * threads poll, so operate() never touches a mutex or condition variable.
+ *
+ * Any number of threads may call setGoal().
+ *
+ * By default, limits apply to each coefficient separately. After
+ * setPathLimits(true), they bound the magnitude of the velocity, acceleration,
+ * and jerk vectors instead, which is appropriate for Cartesian positions.
+ *
+ * @tparam T A fixed-size math::Vector type, such as units::JointPositions<DOF>::type.
+ */
+template<typename T>
+class OnlineTrajectory : public System, public SingleOutput<T> {
+public:
+	typedef typename T::unitless_type unitless_type;
+	typedef boost::uint32_t goal_id_type;
+
+	explicit OnlineTrajectory(ExecutionManager* em = NULL,
+			const std::string& sysName = "OnlineTrajectory");
+	virtual ~OnlineTrajectory() { mandatoryCleanUp(); }
+
+	/** Sets the current state, discarding any active goal.
+	 *
+	 * The output holds position until the next goal, which starts at
+	 * velocity. Call this before connecting the output to avoid a jump.
+	 */
+	void reset(const T& position, const unitless_type& velocity = unitless_type(0.0));
+
+	/** Queues a new goal and returns its ID.
+	 *
+	 * Wait-free with respect to the execution cycle. The goal takes effect
+	 * during the next execution cycle.
+	 */
+	goal_id_type setGoal(const T& destination,
+			double velocity, double acceleration, double jerk);
+	goal_id_type setGoal(const T& destination, const unitless_type& velocity,
+			const unitless_type& acceleration, const unitless_type& jerk);
+
+	/** Interprets limits as bounds on vector magnitudes rather than per coefficient.
+	 *
+	 * Each goal's limits are scaled, coefficient by coefficient, by that
+	 * coefficient's share of the remaining displacement, so moves that start
+	 * at rest follow a straight line at no more than the given speed. A
+	 * coefficient that is still moving keeps at least its share of the
+	 * current velocity and acceleration so it can blend into the new goal.
+	 * The shares are then normalized, so the scaled limits have the
+	 * magnitude of the given ones and the velocity stays within the given
+	 * speed while blending.
+	 */
+	void setPathLimits(bool pathLimits);
+	bool getPathLimits() const { return pathLimits; }
+
+	/// A goal that is superseded by a later goal is done when the later goal is reached.
+	bool isDone(goal_id_type goal) const {
+		return reachedGoal.load(boost::memory_order_acquire) >= goal;
+	}
+	/// Returns true if the most recently queued goal has been reached.
+	bool isDone() const { return isDone(queuedGoal.load(boost::memory_order_acquire)); }
+
+	/** Blocks until goal is reached, checking every WAIT_POLL_PERIOD seconds.
+	 *
+	 * Returns false if this System stops being executed first (for instance,
+	 * because its output was disconnected).
+	 */
+	bool waitUntilDone(goal_id_type goal) const;
+	bool waitUntilDone() const { return waitUntilDone(queuedGoal.load(boost::memory_order_acquire)); }
+
+protected:
+	struct Command {
+		T destination;
+		unitless_type velocity, acceleration, jerk;
+		goal_id_type id;
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	// The execution cycle drains the queue every cycle, so it only fills up
+	// if the ExecutionManager isn't running.
+	static const size_t QUEUE_CAPACITY = 16;
+
+	// Keeps scaled limits positive for coefficients that don't move.
+	static const double MIN_LIMIT_SCALE;
+
+	static const double WAIT_POLL_PERIOD;
+
+	virtual void onExecutionManagerChanged();
+	void getSamplePeriodFromEM();
+
+	virtual void operate();
+
+	void scaleLimits(Command* c) const;
+
+	double T_s;
+
+	// Accessed only by the execution cycle (or with the EM mutex held)
+	math::SynchronizedJerkLimitedProfile<T> profile;
+	T p;
+	unitless_type v, a;
+	double t;
+	bool active;
+	goal_id_type activeGoal;
+	bool pathLimits;
+
+	boost::lockfree::spsc_queue<Command, boost::lockfree::capacity<QUEUE_CAPACITY> > commands;
+	boost::mutex producerMutex;  // Serializes calls to setGoal(). Never taken by the execution cycle.
+	boost::atomic<goal_id_type> queuedGoal;
+	boost::atomic<goal_id_type> reachedGoal;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(OnlineTrajectory);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/systems/detail/online_trajectory-inl.h>
+
+
+#endif /* BARRETT_SYSTEMS_ONLINE_TRAJECTORY_H_ */
@@ -0,0 +1,184 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * operational_space_controller.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_OPERATIONAL_SPACE_CONTROLLER_H_
+#define BARRETT_SYSTEMS_OPERATIONAL_SPACE_CONTROLLER_H_
+
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <libconfig.h++>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math/kinematics.h>
+#include <barrett/math/dynamics.h>
+#include <barrett/systems/abstract/controller.h>
+#include <barrett/systems/kinematics_base.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Inertia-weighted Cartesian position controller.
+ *
+ * Computes the task-space inertia matrix Lambda = (J M^-1 J^T)^-1 from the
+ * linear tool Jacobian J and the joint-space inertia matrix M, then commands
+ * joint torques J^T Lambda (kp*e - kd*v). Because the PD law acts on a unit
+ * mass, the gains are far less configuration-dependent than those of the
+ * PIDController<cp_type, cf_type> + ToolForceToJointTorques pair.
+ *
+ * When DOF > 3, a joint-space posture controller (see setPosture()) is
+ * projected into the dynamically consistent null-space of the task so that it
+ * does not disturb the tool position.
+ *
+ * All matrices are fixed-size and factored with Eigen::LDLT; operate() does
+ * not allocate.
+ */
+template<size_t DOF>
+class OperationalSpaceController : public Controller<units::CartesianPosition::type,
+													 typename units::JointTorques<DOF>::type>,
+								   public KinematicsInput<DOF> {
+
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+// IO
+public:		System::Input<jp_type> jpInput;
+public:		System::Input<jv_type> jvInput;
+
+
+public:
+	typedef math::Vector<3>::type cartesian_gain_type;
+
+	explicit OperationalSpaceController(const libconfig::Setting& dynamicsSetting,
+			const std::string& sysName = "OperationalSpaceController") :
+		Controller<cp_type, jt_type>(sysName), KinematicsInput<DOF>(this),
+		jpInput(this), jvInput(this),
+		dyn(dynamicsSetting), kp(0.0), kd(0.0), nullKp(0.0), nullKd(0.0), posture(0.0) {}
+	OperationalSpaceController(const libconfig::Setting& dynamicsSetting,
+			const libconfig::Setting& setting,
+			const std::string& sysName = "OperationalSpaceController") :
+		Controller<cp_type, jt_type>(sysName), KinematicsInput<DOF>(this),
+		jpInput(this), jvInput(this),
+		dyn(dynamicsSetting), kp(0.0), kd(0.0), nullKp(0.0), nullKd(0.0), posture(0.0)
+	{
+		setFromConfig(setting);
+	}
+	virtual ~OperationalSpaceController() { this->mandatoryCleanUp(); }
+
+
+	void setFromConfig(const libconfig::Setting& setting) {
+		setKp(cartesian_gain_type(setting["kp"]));
+		setKd(cartesian_gain_type(setting["kd"]));
+		if (setting.exists("null_space_kp")) {
+			setNullSpaceKp(v_type(setting["null_space_kp"]));
+		}
+		if (setting.exists("null_space_kd")) {
+			setNullSpaceKd(v_type(setting["null_space_kd"]));
+		}
+		if (setting.exists("posture")) {
+			setPosture(jp_type(setting["posture"]));
+		}
+	}
+
+	/// Stiffness per unit task-space mass (1/s^2).
+	void setKp(const cartesian_gain_type& proportionalGains) { kp = proportionalGains; }
+	/// Damping per unit task-space mass (1/s).
+	void setKd(const cartesian_gain_type& derivitiveGains) { kd = derivitiveGains; }
+	void setNullSpaceKp(const v_type& proportionalGains) { nullKp = proportionalGains; }
+	void setNullSpaceKd(const v_type& derivitiveGains) { nullKd = derivitiveGains; }
+	void setPosture(const jp_type& jp) {
+		BARRETT_SCOPED_LOCK(this->getEmMutex());
+		posture = jp;
+	}
+
+	const cartesian_gain_type& getKp() const { return kp; }
+	const cartesian_gain_type& getKd() const { return kd; }
+	const v_type& getNullSpaceKp() const { return nullKp; }
+	const v_type& getNullSpaceKd() const { return nullKd; }
+	const jp_type& getPosture() const { return posture; }
+
+protected:
+	math::Dynamics<DOF> dyn;
+
+	cartesian_gain_type kp, kd;
+	v_type nullKp, nullKd;
+	jp_type posture;
+
+	math::Matrix<3,DOF> J;
+	math::Matrix<DOF,3> MinvJt;
+	Eigen::LDLT<typename sqm_type::Base> jsimLdlt;
+	Eigen::LDLT<Eigen::Matrix3d> lambdaInvLdlt;
+
+	cv_type cv;
+	cf_type fStar, cf;
+	jt_type jt, jtPosture;
+
+	virtual void operate() {
+		const math::Kinematics<DOF>& kin = this->kinInput.getValue();
+
+		J.copyFrom(kin.impl->tool_jacobian_linear);
+		cv.copyFrom(kin.impl->tool_velocity);
+
+		const sqm_type& M = dyn.evalJsim(kin);
+		jsimLdlt.compute(M);
+		MinvJt = jsimLdlt.solve(J.transpose());
+		lambdaInvLdlt.compute(J * MinvJt);
+
+		// Unit-mass PD law in task space, scaled by Lambda
+		fStar = kp.cwiseProduct(this->referenceInput.getValue() - this->feedbackInput.getValue())
+				- kd.cwiseProduct(cv);
+		cf = lambdaInvLdlt.solve(fStar);
+		jt = J.transpose() * cf;
+
+		if (DOF > 3) {
+			jtPosture = M * (nullKp.cwiseProduct(posture - jpInput.getValue())
+					- nullKd.cwiseProduct(jvInput.getValue()));
+
+			// N^T = I - J^T * Jbar^T, with Jbar = M^-1 * J^T * Lambda
+			jt += jtPosture - J.transpose() * lambdaInvLdlt.solve(MinvJt.transpose() * jtPosture);
+		}
+
+		this->controlOutputValue->setData(&jt);
+	}
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(OperationalSpaceController);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_OPERATIONAL_SPACE_CONTROLLER_H_ */
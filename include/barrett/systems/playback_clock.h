@@ -0,0 +1,116 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * playback_clock.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_PLAYBACK_CLOCK_H_
+#define BARRETT_SYSTEMS_PLAYBACK_CLOCK_H_
+
+
+#include <string>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** A Ramp for playing trajectories back at an adjustable speed.
+ *
+ * The output is the time at which to evaluate a trajectory (for instance, the
+ * input of a Callback wrapping a Spline). While running, it advances by
+ * rate * T_s each execution cycle. The rate follows the speed override, a
+ * fraction of the recorded speed between 0.0 and getMaxSpeed() (by default,
+ * 0% to 200%), taken from speedInput if it has a value or from setSpeed()
+ * otherwise.
+ *
+ * The rate never jumps: it moves towards the speed override with its first
+ * derivative limited to maxAcceleration and its second derivative limited to
+ * maxJerk. start() and stop() ramp the rate up and down the same way, so the
+ * trajectory's velocity stays continuous and its acceleration bounded when the
+ * speed is changed mid-motion.
+ *
+ * speedInput may be connected to any System (a slider, a proximity sensor, a
+ * safety monitor, ...). Reading it, and updating the rate, is bounded-time and
+ * doesn't lock or allocate.
+ */
+class PlaybackClock : public System, public SingleOutput<double> {
+// IO
+public:		Input<double> speedInput;
+
+
+public:
+	explicit PlaybackClock(ExecutionManager* em, double maxAcceleration = 1.0,
+			double maxJerk = 5.0, double maxSpeed = 2.0,
+			const std::string& sysName = "PlaybackClock");
+	virtual ~PlaybackClock();
+
+	bool isRunning();
+
+	/// Ramps the rate up to the speed override.
+	void start();
+	/// Ramps the rate down to zero.
+	void stop();
+	/// Stops immediately and sets the output to 0.0.
+	void reset();
+	void setOutput(double newOutput);
+
+	/// The speed override used while speedInput is unconnected or undefined. Saturated to [0.0, getMaxSpeed()].
+	void setSpeed(double newSpeed);
+	double getSpeed() const { return speed; }
+	double getMaxSpeed() const { return maxSpeed; }
+	/// The current rate, as of the last execution cycle
+	double getRate() const { return rate; }
+
+protected:
+	virtual bool inputsValid() { return true; }  // speedInput is optional
+	virtual void onExecutionManagerChanged();
+	void getSamplePeriodFromEM();
+
+	virtual void operate();
+
+
+	double T_s;
+	double maxAcceleration, maxJerk, maxSpeed;
+	bool running;
+	double speed;
+	double rate, acceleration;
+	double y;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(PlaybackClock);
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_PLAYBACK_CLOCK_H_ */
@@ -0,0 +1,197 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * safety_monitor.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_SAFETY_MONITOR_H_
+#define BARRETT_SYSTEMS_SAFETY_MONITOR_H_
+
+
+#include <string>
+
+#include <boost/function.hpp>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/thread/seqlock.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/safety_module.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/abstract/system.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Watches a SafetyModule's mode and pendant state from an execution cycle.
+ *
+ * SafetyModule::getMode() and SafetyModule::getPendantState() hold the bus
+ * until the SafetyModule replies, and SafetyModule::waitForMode() polls them.
+ * SafetyMonitor instead reads MODE and PEN rate times per second without
+ * waiting: the requests are sent during one execution cycle and the replies
+ * collected during the following ones. A reply that doesn't arrive within
+ * MAX_MISSED_CYCLES is given up on, and counted by getErrorCount().
+ *
+ * The SafetyModule's replies all arrive in one queue. They are matched to
+ * MODE and PEN by the property they carry, not by their order, so a late
+ * reply or a reply to someone else's request can't shift the replies of
+ * later reads. Replies to other properties are discarded (and counted by
+ * getErrorCount()).
+ *
+ * The latest values are on modeOutput, so other Systems can react to an
+ * E-stop or Shift-idle during the same execution cycle, and, from any thread,
+ * available through getSnapshot() and waitForMode(), which don't touch the
+ * bus.
+ *
+ * While it is reading, the monitor is also the SafetyModule's StateSource
+ * (see SafetyModule::setStateSource()): SafetyModule::getMode(),
+ * SafetyModule::getPendantState() and SafetyModule::waitForMode() return
+ * its values rather than reading the bus, so they don't take the monitor's
+ * replies. Other SafetyModule calls that read from the bus
+ * (SafetyModule::setMode(), SafetyModule::wamIsZeroed(), ...) may still
+ * receive one of the monitor's replies and throw. Call setRate(0.0), and
+ * wait MAX_MISSED_CYCLES, before making them.
+ *
+ * The callbacks set with setModeChangeCallback() and
+ * setPendantStateChangeCallback() are called from the execution cycle when
+ * the value changes (but not for the first value read). They must be brief
+ * and real-time safe, like the operate() method of a System.
+ *
+ * Example:
+ *   systems::SafetyMonitor monitor(pm.getExecutionManager(), pm.getSafetyModule());
+ *   monitor.waitForMode(SafetyModule::ACTIVE);
+ */
+class SafetyMonitor : public System, public SafetyModule::StateSource {
+// IO
+public:		Output<enum SafetyModule::SafetyMode> modeOutput;
+protected:	Output<enum SafetyModule::SafetyMode>::Value* modeOutputValue;
+
+
+public:
+	struct Snapshot {
+		Snapshot();
+
+		enum SafetyModule::SafetyMode mode;
+		SafetyModule::PendantState pendantState;
+
+		/// highResolutionSystemTime() of the latest reads, or 0.0 if the value hasn't been read
+		double modeTime, pendantStateTime;
+		/// How old the values may get before the next read is overdue (seconds)
+		double maxAge;
+	};
+
+	/// Called with the previous and the new mode
+	typedef boost::function<void (enum SafetyModule::SafetyMode, enum SafetyModule::SafetyMode)> mode_callback_type;
+	typedef boost::function<void (const SafetyModule::PendantState&)> pendant_state_callback_type;
+
+	SafetyMonitor(ExecutionManager* em, SafetyModule* sm, double rate = 10.0,
+			const std::string& sysName = "SafetyMonitor");
+	virtual ~SafetyMonitor();
+
+	/// Reads MODE and PEN rate times per second (at most once per execution cycle). A rate of 0.0 stops reading them.
+	void setRate(double rate);
+	double getRate() const { return rate; }
+
+	void setModeChangeCallback(const mode_callback_type& callback);
+	void setPendantStateChangeCallback(const pendant_state_callback_type& callback);
+
+	/// Wait-free for the execution cycle. Returns false if the mode hasn't been read yet.
+	bool getSnapshot(Snapshot* snapshot) const;
+
+	/** Returns once the mode read is mode, checking every pollingPeriod_s.
+	 * Returns false if timeout_s (if positive) elapses first.
+	 */
+	bool waitForMode(enum SafetyModule::SafetyMode mode, double timeout_s = 0.0,
+			double pollingPeriod_s = 0.01) const;
+
+	/// The number of replies that were missing, invalid or unexpected, and of requests that couldn't be sent
+	size_t getErrorCount() const { return errorCount; }
+
+	// SafetyModule::StateSource. Real-time safe; return false if the values are older than Snapshot::maxAge.
+	virtual bool getMode(enum SafetyModule::SafetyMode* mode) const;
+	virtual bool getPendantState(SafetyModule::PendantState* ps) const;
+
+
+	static const int MAX_MISSED_CYCLES = 10;
+	/// The most replies collected during one execution cycle
+	static const int MAX_REPLIES_PER_CYCLE = 4;
+
+protected:
+	/// For subclasses that read something other than a SafetyModule
+	SafetyMonitor(ExecutionManager* em, double rate, const std::string& sysName);
+
+	// The split-phase reads, called from operate(). requestProperty() returns
+	// the value of Puck::sendGetPropertyRequest(). receiveReply() receives the
+	// next reply, whichever property it is for. It returns 0 and sets prop to
+	// MODE or PEN, 1 if there is no reply waiting, another positive value if
+	// the bus failed, or a negative value if the reply couldn't be parsed or
+	// was for some other property.
+	virtual int requestProperty(enum Puck::Property prop);
+	virtual int receiveReply(enum Puck::Property* prop, int* value);
+
+	virtual void onExecutionManagerChanged();
+	void getSamplePeriodFromEM();
+
+	virtual void operate();
+
+
+	void init();
+	bool updateMode(int value);
+	bool updatePendantState(int value);
+	bool getRecentSnapshot(Snapshot* snapshot) const;
+
+	SafetyModule* safetyModule;
+	Puck* puck;
+	int modePropId, penPropId;
+	double T_s;
+	double rate;
+	long nextDue;  // In cycles
+	long cycle;
+
+	bool modePending, penPending;
+	int missedCycles;
+	size_t errorCount;
+
+	mode_callback_type modeCallback;
+	pendant_state_callback_type pendantStateCallback;
+
+	Snapshot current;
+	int pen;
+	bool hasMode, hasPendantState;
+	SafetyModule::PendantState pendantStateTmp;
+	thread::SeqLock<Snapshot> snapshotLock;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SafetyMonitor);
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_SAFETY_MONITOR_H_ */
@@ -0,0 +1,138 @@
+/*
+	Copyright 2009, 2010 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * tactile_processor.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_TACTILE_PROCESSOR_H_
+#define BARRETT_SYSTEMS_TACTILE_PROCESSOR_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/matrix.h>
+#include <barrett/products/hand.h>
+#include <barrett/products/tactile_puck.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+#include <barrett/systems/hand_sensors.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Turns the raw tactile pressures of a Hand into quantities a grasp
+ * controller can use directly.
+ *
+ * The input holds one row of TactilePuck::NUM_SENSORS pressures (N/cm^2) per
+ * pad, as output by HandSensors::tactileOutput. Each execution cycle:
+ *   - the pad's tare (see tare()) is subtracted, and negative pressures are
+ *     clipped to zero;
+ *   - if enabled, a 3x3 binomial filter smooths each pad spatially, keeping
+ *     its total;
+ *   - totalForceOutput gives the sum of each pad's pressures times cellArea;
+ *   - centroidOutput gives each pad's center of pressure, as (column, row) in
+ *     cell pitches from the center of the pad. Pads whose summed pressure is
+ *     at most contactThreshold have no contact, and a centroid of zero.
+ * The tared and filtered pressures are on output.
+ *
+ * Every step is a product or reduction of fixed-size matrices (the filter is
+ * a precomputed 24x24 matrix), so Eigen vectorizes them and nothing is
+ * allocated or copied beyond the outputs.
+ *
+ * Cells are taken to be in TACT_ROWS rows of TACT_COLUMNS, cell i being in
+ * row i / TACT_COLUMNS. This is the layout of the finger pads; the palm pad's
+ * cells are arranged differently, so its centroid and filtering are only
+ * approximate.
+ */
+class TactileProcessor : public SingleIO<HandSensors::tactile_type, HandSensors::tactile_type> {
+public:
+	typedef HandSensors::tactile_type tactile_type;
+	typedef Hand::v_type v_type;
+	typedef math::Matrix<Hand::DOF, 2> centroid_type;
+
+// IO
+public:		Output<v_type> totalForceOutput;
+protected:	Output<v_type>::Value* totalForceOutputValue;
+public:		Output<centroid_type> centroidOutput;
+protected:	Output<centroid_type>::Value* centroidOutputValue;
+
+
+public:
+	/// cellArea is in cm^2, so that totalForceOutput is in N. The default gives the sum of the pressures.
+	explicit TactileProcessor(double cellArea = 1.0, double contactThreshold = 1.0,
+			bool spatialFilter = false, const std::string& sysName = "TactileProcessor");
+	virtual ~TactileProcessor();
+
+	/** Subtracts the pressures the pads in whichPads (a mask of Hand::F1,
+	 * Hand::F2, Hand::F3, and Hand::SPREAD, the palm) feel during the next
+	 * execution cycle from all later readings.
+	 */
+	void tare(unsigned int whichPads = Hand::WHOLE_HAND);
+	void clearTare();
+	const tactile_type& getTare() const { return tareValue; }
+
+	void setSpatialFilter(bool enable);
+	bool getSpatialFilter() const { return spatialFilter; }
+
+
+	static const int TACT_ROWS = 8;
+	static const int TACT_COLUMNS = 3;
+
+protected:
+	virtual void operate();
+
+	double cellArea, contactThreshold;
+	bool spatialFilter;
+	unsigned int tarePending;
+	tactile_type tareValue;
+
+	// Row i holds the share of cell i's pressure given to each cell.
+	math::Matrix<TactilePuck::NUM_SENSORS, TactilePuck::NUM_SENSORS> filter;
+	// The (column, row) of each cell
+	math::Matrix<TactilePuck::NUM_SENSORS, 2> cellPositions;
+
+	tactile_type pressure;
+	v_type totalForce;
+	centroid_type centroid;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TactileProcessor);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_TACTILE_PROCESSOR_H_ */
@@ -38,6 +38,7 @@
 #include <vector>
 
 #include <boost/thread.hpp>
+#include <boost/cstdint.hpp>
 #include <Eigen/Core>
 #include <libconfig.h++>
 
@@ -47,6 +48,7 @@
 #include <barrett/products/puck.h>
 #include <barrett/products/safety_module.h>
 #include <barrett/math/kinematics.h>
+#include <barrett/thread/seqlock.h>
 
 #include <barrett/systems/low_level_wam_wrapper.h>
 #include <barrett/systems/first_order_filter.h>
@@ -55,6 +57,7 @@
 #include <barrett/systems/gain.h>
 #include <barrett/systems/tuple_grouper.h>
 #include <barrett/systems/tuple_splitter.h>
+#include <barrett/systems/online_trajectory.h>
 
 #include <barrett/systems/kinematics_base.h>
 #include <barrett/systems/gravity_compensator.h>
@@ -67,6 +70,8 @@
 #include <barrett/systems/tool_force_to_joint_torques.h>
 #include <barrett/systems/tool_torque_to_joint_torques.h>
 
+#include <barrett/systems/detail/wam-helper.h>
+
 
 namespace barrett {
 namespace systems {
@@ -76,6 +81,23 @@ template<size_t DOF>
 class Wam {
 public:
 	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+	typedef typename KinematicsBase<DOF>::Snapshot kinematics_snapshot_type;
+
+	/** The state of the WAM as seen by one execution cycle.
+	 *
+	 *  Published once per cycle; see getState().
+	 */
+	struct State {
+		jp_type jp;
+		jv_type jv;  ///< Filtered joint velocities
+		jt_type jt;  ///< Joint torques commanded during this cycle
+		cp_type toolPosition;
+		Eigen::Quaterniond toolOrientation;
+		double timestamp;  ///< highResolutionSystemTime() at which jp was sampled
+		boost::uint64_t cycle;  ///< Number of cycles published before this one
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
 
 
 	// these need to be before the IO references
@@ -109,6 +131,10 @@ public:
 	Summer<jt_type, 3> jtSum;
 	enum {JT_INPUT = 0, GRAVITY_INPUT, SC_INPUT};
 
+	// reference signals for joint-space and Cartesian moveTo()s
+	OnlineTrajectory<jp_type> jpTrajectory;
+	OnlineTrajectory<cp_type> cpTrajectory;
+
 
 /** Input/Output Interface definitions available to developers.
  *
@@ -138,6 +164,13 @@ public:
 	/** getHomePosition() returns home postion of individual joints in Radians
      */
 	const jp_type& getHomePosition() const;
+	/** getState() copies the most recent per-cycle State into state.
+	 *
+	 *  Never blocks the control loop, so it may be polled at a high rate from
+	 *  UI, logging, or network threads. Returns false if no State has been
+	 *  published yet (e.g. there is no ExecutionManager).
+	 */
+	bool getState(State* state) const { return statePublisher.getState(state); }
 	/** getJointTorques() returns joint torques in Newtons per meter
      */
 	jt_type getJointTorques() const;
@@ -190,12 +223,26 @@ public:
      *	blocking Determines whether program should wait for move to finish before continuing
      *	velocity Speed at which to move
      *	acceleration value in radians per second
+     *
+     *  Moves follow jerk-limited S-curves. Joint-space moves limit each joint's velocity and acceleration
+     *  individually, start from the current joint velocities, and bring all joints to rest at the same time.
+     *  Cartesian moves limit the tool's speed and acceleration along the straight line to the destination.
+     *
+     *  Joint-space and Cartesian moves are generated in the control loop by jpTrajectory and cpTrajectory. Calling
+     *  moveTo() again before the move is done retargets it: the WAM blends from its current motion toward the new
+     *  destination. This makes it suitable for streaming targets (teleoperation, visual servoing) at a high rate.
      */
 	void moveTo(const jp_type& destination, bool blocking = true, double velocity = 0.5, double acceleration = 0.5);
 	void moveTo(const cp_type& destination, bool blocking = true, double velocity = 0.1, double acceleration = 0.2);
 	void moveTo(const Eigen::Quaterniond& destination, bool blocking = true, double velocity = 0.5, double acceleration = 0.5);
 	void moveTo(const pose_type& destination, bool blocking = true, double velocity = 0.1, double acceleration = 0.2);
-	template<typename T> void moveTo(const T& currentPos, /*const typename T::unitless_type& currentVel,*/ const T& destination, bool blocking, double velocity, double acceleration);
+	template<typename T> void moveTo(const T& currentPos, const T& destination, bool blocking, double velocity, double acceleration);
+	/** Starts the move from a non-zero velocity so that it blends with the current motion.
+	 *
+	 *  For joint-space moves, currentVel is the joint velocity and each joint follows a time-synchronized S-curve.
+	 *  For other moves, currentVel is the initial speed along the straight-line path to destination.
+	 */
+	template<typename T> void moveTo(const T& currentPos, const typename detail::MoveToProfile<T>::velocity_type& currentVel, const T& destination, bool blocking, double velocity, double acceleration);
 	/** moveIsDone() method returns false while the trajectory controller for the most recent moveTo() command is still active. 
 	 *
 	 *  Only useful if the moveTo() is non-blocking. 
@@ -217,14 +264,56 @@ public:
 
 protected:
 	template<typename T> T currentPosHelper(const T& currentPos);
-	template<typename T> void moveToThread(const T& currentPos, const T& destination, double velocity, double acceleration, bool* started, boost::shared_future<boost::thread*> threadPtrFuture);
+	template<typename T> void retarget(OnlineTrajectory<T>& trajectory, const T& currentPos, const typename T::unitless_type& currentVel, const T& destination, bool blocking, double velocity, double acceleration);
+	template<typename T> void moveToThread(const T& currentPos, const typename detail::MoveToProfile<T>::velocity_type& currentVel, const T& destination, double velocity, double acceleration, bool* started, boost::shared_future<boost::thread*> threadPtrFuture);
 
 	bool doneMoving;
 	boost::thread_group mtThreadGroup;
 
-	// Used to calculate TP and TO if the values aren't already being calculated in the control loop.
+	// Used to calculate TP and TO if kinematicsBase hasn't published a snapshot (e.g. no ExecutionManager).
 	mutable math::Kinematics<DOF> kin;
 
+
+	class StatePublisher : public System {
+	// IO
+	public:		Input<jp_type> jpInput;
+	public:		Input<jv_type> jvInput;
+	public:		Input<jt_type> jtInput;
+	public:		Input<pose_type> poseInput;
+
+
+	public:
+		StatePublisher(const LowLevelWam<DOF>& llw,
+				const std::string& sysName = "Wam::StatePublisher") :
+			System(sysName),
+			jpInput(this), jvInput(this), jtInput(this), poseInput(this),
+			llw(llw), cycle(0) {}
+		virtual ~StatePublisher() { mandatoryCleanUp(); }
+
+		bool getState(State* state) const {
+			if ( !stateLock.hasBeenWritten() ) {
+				return false;
+			}
+			stateLock.read(state);
+			return true;
+		}
+
+	protected:
+		virtual void operate();
+
+		const LowLevelWam<DOF>& llw;
+		boost::uint64_t cycle;
+		thread::SeqLock<State> stateLock;
+
+	private:
+		DISALLOW_COPY_AND_ASSIGN(StatePublisher);
+
+	public:
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	StatePublisher statePublisher;
+
 private:
 	DISALLOW_COPY_AND_ASSIGN(Wam);
 
@@ -0,0 +1,175 @@
+/*
+ * seqlock.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_THREAD_SEQLOCK_H_
+#define BARRETT_THREAD_SEQLOCK_H_
+
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace thread {
+
+
+/** Publishes a value from one writer thread to any number of reader threads
+ * without ever blocking the writer.
+ *
+ * The writer (typically the real-time execution cycle) is wait-free. Readers
+ * never take a lock; if a write happens while they are copying, they simply
+ * retry. This makes SeqLock a good fit for exposing per-cycle state to UI,
+ * logging, and planning threads without contending for the
+ * ExecutionManager's mutex.
+ *
+ * Because a reader may observe a partially written value before discarding it,
+ * T must be safe to copy while torn: fixed-size Eigen/math::Matrix types,
+ * quaternions, and structs of them are fine; types that own heap memory (e.g.
+ * std::vector) are not.
+ *
+ * Only one thread may write at a time.
+ */
+template<typename T>
+class SeqLock {
+public:
+	SeqLock() : seq(0), data() {}
+	explicit SeqLock(const T& initialValue) : seq(0), data(initialValue) {}
+
+	/// Returns a reference to the shared value for in-place modification. Must be paired with endWrite().
+	T& beginWrite() {
+		seq.store(seq.load(boost::memory_order_relaxed) + 1, boost::memory_order_relaxed);
+		boost::atomic_thread_fence(boost::memory_order_release);
+		return data;
+	}
+	void endWrite() {
+		seq.store(seq.load(boost::memory_order_relaxed) + 1, boost::memory_order_release);
+	}
+	void write(const T& value) {
+		beginWrite() = value;
+		endWrite();
+	}
+
+	/// Makes a single attempt to copy a consistent value into dest. Returns false (leaving dest torn) if a write interfered.
+	bool tryRead(T* dest) const {
+		uint_fast32_t s1 = seq.load(boost::memory_order_acquire);
+		if (s1 & 1) {
+			return false;
+		}
+		*dest = data;
+		boost::atomic_thread_fence(boost::memory_order_acquire);
+		return seq.load(boost::memory_order_relaxed) == s1;
+	}
+	/** Makes up to maxAttempts attempts to copy a consistent value into dest.
+	 *
+	 * Real-time readers should use this rather than read(): a reader that has
+	 * preempted the writer in the middle of a write would otherwise spin
+	 * forever.
+	 */
+	bool tryRead(T* dest, int maxAttempts) const {
+		for (int i = 0; i < maxAttempts; ++i) {
+			if (tryRead(dest)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	/// Copies a consistent value into dest, retrying as necessary. Never blocks the writer.
+	void read(T* dest) const {
+		while ( !tryRead(dest) ) {}
+	}
+	T read() const {
+		T result;
+		read(&result);
+		return result;
+	}
+
+	/// The number of completed writes.
+	uint_fast32_t getWriteCount() const {
+		return seq.load(boost::memory_order_acquire) / 2;
+	}
+	bool hasBeenWritten() const { return getWriteCount() != 0; }
+
+protected:
+	boost::atomic<uint_fast32_t> seq;
+	T data;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SeqLock);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+/** Follows a SeqLock, once per cycle, from a real-time thread.
+ *
+ * update() never spins: it makes at most maxReadAttempts attempts to read a
+ * new value and otherwise keeps the previous one. The value goes stale after
+ * maxStaleCycles consecutive cycles without a successful read of a new value,
+ * whether because the writer stopped or because the reads kept being
+ * interrupted.
+ */
+template<typename T>
+class SeqLockReader {
+public:
+	explicit SeqLockReader(int maxStaleCycles, int maxReadAttempts = 3) :
+		source(NULL), writeCount(0), staleCycles(maxStaleCycles),
+		maxStaleCycles(maxStaleCycles), maxReadAttempts(maxReadAttempts),
+		value(), scratch() {}
+
+	/// Starts following source (or nothing, if NULL). The value is stale until source has been written.
+	void setSource(const SeqLock<T>* source_) {
+		source = source_;
+		writeCount = 0;
+		staleCycles = maxStaleCycles;
+	}
+	const SeqLock<T>* getSource() const { return source; }
+
+	/// Call once per cycle. Returns isFresh().
+	bool update() {
+		if (source == NULL) {
+			return false;
+		}
+
+		uint_fast32_t count = source->getWriteCount();
+		if (count != writeCount  &&  source->tryRead(&scratch, maxReadAttempts)) {
+			value = scratch;
+			writeCount = count;
+			staleCycles = 0;
+		} else if (staleCycles < maxStaleCycles) {
+			++staleCycles;
+		}
+		return isFresh();
+	}
+
+	bool isFresh() const { return source != NULL  &&  staleCycles < maxStaleCycles; }
+	/// The most recent value read. Only meaningful if isFresh().
+	const T& getValue() const { return value; }
+	int getStaleCycles() const { return staleCycles; }
+
+protected:
+	const SeqLock<T>* source;
+	uint_fast32_t writeCount;
+	int staleCycles;
+	int maxStaleCycles, maxReadAttempts;
+	T value, scratch;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SeqLockReader);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_THREAD_SEQLOCK_H_ */
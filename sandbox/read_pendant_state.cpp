@@ -33,6 +33,8 @@
 #include <unistd.h>
 
 #include <barrett/products/product_manager.h>
+#include <barrett/systems/real_time_execution_manager.h>
+#include <barrett/systems/safety_monitor.h>
 
 
 using namespace barrett;
@@ -40,19 +42,24 @@ using namespace barrett;
 
 int main() {
 	ProductManager pm;
-	SafetyModule& sm = *pm.getSafetyModule();
-	SafetyModule::PendantState ps;
 
-	// Optional: Instantiate a Wam object and start the realtime control loop
+	// Optional: Instantiate a Wam object
 	if (pm.foundWam4()) {
 		pm.getWam4(false);
 	} else {
 		pm.getWam7(false);
 	}
 
+	// Read the pendant from the realtime control loop instead of polling the bus from this thread
+	systems::SafetyMonitor monitor(pm.getExecutionManager(), pm.getSafetyModule());
+	pm.startExecutionManager();
+
+	systems::SafetyMonitor::Snapshot snapshot;
 	while (true) {
-		sm.getPendantState(&ps);
-		std::cout << ps.toString() << " " << ps.allSafe() << " " << ps.hasFaults() << "\n";
+		if (monitor.getSnapshot(&snapshot)) {
+			const SafetyModule::PendantState& ps = snapshot.pendantState;
+			std::cout << ps.toString() << " " << ps.allSafe() << " " << ps.hasFaults() << "\n";
+		}
 		usleep(1000000);
 	}
 
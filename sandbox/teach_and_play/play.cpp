@@ -10,6 +10,7 @@
 #include <boost/ref.hpp>
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
+#include <boost/atomic.hpp>
 //#include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
@@ -21,6 +22,8 @@
 #include <barrett/exception.h>
 #include <barrett/units.h>
 #include <barrett/systems.h>
+#include <barrett/math/streaming_spline.h>
+#include <barrett/log/trajectory_file.h>
 #include <barrett/products/product_manager.h>
 #define BARRETT_SMF_VALIDATE_ARGS
 #include <barrett/standard_main_function.h>
@@ -34,6 +37,9 @@ enum STATE {
 	PLAYING, STOPPED, PAUSED, QUIT
 } curState = STOPPED, lastState = STOPPED;
 
+// Joint-space playback starts once this much of the recording has been loaded.
+const double PRELOAD_TIME = 1.0;  // seconds
+
 char* ctrlMode = NULL;
 bool vcMode = false;
 
@@ -100,17 +106,25 @@ protected:
 	typedef boost::tuple<double, Eigen::Quaterniond> input_quat_type;
 
 	ControlModeSwitcher<DOF>* cms;
+	// Set if playName is a binary trajectory file rather than a CSV file
+	log::TrajectoryFile* trajectory;
 
 	std::vector<input_cp_type, Eigen::aligned_allocator<input_cp_type> >* cpVec;
 	std::vector<input_quat_type, Eigen::aligned_allocator<input_quat_type> >* qVec;
-	math::Spline<jp_type>* jpSpline;
+	// Joint-space recordings are streamed from disk while they play, so they
+	// can start right away and don't need to fit in memory.
+	math::StreamingSpline<jp_type>* jpSpline;
 	math::Spline<cp_type>* cpSpline;
 	math::Spline<Eigen::Quaterniond>* qSpline;
 	systems::Callback<double, jp_type>* jpTrajectory;
 	systems::Callback<double, cp_type>* cpTrajectory;
 	systems::Callback<double, Eigen::Quaterniond>* qTrajectory;
 	systems::TupleGrouper<cp_type, Eigen::Quaterniond> poseTg;
-	systems::Ramp time;
+	// Playback time. Its rate follows the speed override, with jerk limits.
+	systems::PlaybackClock time;
+
+	boost::thread loadThread;
+	boost::atomic<bool> stopLoading;
 
 public:
 	int dataSize;
@@ -119,15 +133,19 @@ public:
 	Play(systems::Wam<DOF>& wam_, ProductManager& pm_, std::string filename_,
 			const libconfig::Setting& setting_) :
 			wam(wam_), hand(NULL), pm(pm_), playName(filename_), inputType(0), setting(
-					setting_), cms(NULL), cpVec(NULL), qVec(NULL), jpSpline(
+					setting_), cms(NULL), trajectory(NULL), cpVec(NULL), qVec(NULL), jpSpline(
 					NULL), cpSpline(NULL), qSpline(NULL), jpTrajectory(NULL), cpTrajectory(
-					NULL), qTrajectory(NULL), time(pm.getExecutionManager()), dataSize(
-					0), loop(false) {
+					NULL), qTrajectory(NULL), time(pm.getExecutionManager()), stopLoading(
+					false), dataSize(0), loop(false) {
 	}
 	bool
 	init();
+	bool
+	initFromTrajectoryFile();
 
 	~Play() {
+		stopLoadingThread();
+		delete trajectory;
 	}
 
 	void
@@ -138,6 +156,8 @@ public:
 	startPlayback();
 	void
 	pausePlayback();
+	void
+	changeSpeed(double change);
 	bool
 	playbackActive();
 	void
@@ -145,6 +165,14 @@ public:
 	void
 	reconnectSystems();
 
+protected:
+	void
+	startLoadingThread();
+	void
+	stopLoadingThread();
+	void
+	loadEntryPoint();
+
 private:
 	DISALLOW_COPY_AND_ASSIGN(Play);
 
@@ -168,100 +196,80 @@ bool Play<DOF>::init() {
 	cms = new ControlModeSwitcher<DOF>(pm, wam,
 			setting["control_mode_switcher"]);
 
-	//Create stream from input file
-	std::ifstream fs(playName.c_str());
-	std::string line;
-
-	// Check to see the data type specified on the first line (jp_type or pose_type)
-	// this will inform us if we are tracking 4DOF WAM Joint Angles, 7DOF WAM Joint Angles, or WAM Poses
-	std::getline(fs, line);
-	// Using a boost tokenizer to parse the data of the file into our vector.
-	boost::char_separator<char> sep(",");
-	typedef boost::tokenizer<boost::char_separator<char> > t_tokenizer;
-	t_tokenizer tok(line, sep);
-	if (strcmp(line.c_str(), "pose_type") == 0) {
-		// Create our spline and trajectory if the first line of the parsed file informs us of a pose_type
-		inputType = 1;
-		cpVec = new std::vector<input_cp_type,
-				Eigen::aligned_allocator<input_cp_type> >();
-		qVec = new std::vector<input_quat_type,
-				Eigen::aligned_allocator<input_quat_type> >();
-
-		float fLine[8];
-		input_cp_type cpSamp;
-		input_quat_type qSamp;
-		while (true) {
-			std::getline(fs, line);
-			if (!fs.good())
-				break;
-			t_tokenizer tok(line, sep);
-			int j = 0;
-			for (t_tokenizer::iterator beg = tok.begin(); beg != tok.end();
-					++beg) {
-				fLine[j] = boost::lexical_cast<float>(*beg);
-				j++;
-			}
-			boost::get<0>(cpSamp) = fLine[0];
-			boost::get<0>(qSamp) = boost::get<0>(cpSamp);
-
-			boost::get<1>(cpSamp) << fLine[1], fLine[2], fLine[3];
-			boost::get<1>(qSamp) = Eigen::Quaterniond(fLine[4], fLine[5],
-					fLine[6], fLine[7]);
-			boost::get<1>(qSamp).normalize();
-			cpVec->push_back(cpSamp);
-			qVec->push_back(qSamp);
-		}
-		// Make sure the vectors created are the same size
-		assert(cpVec->size() == qVec->size());
-		// Create our splines between points
-		cpSpline = new math::Spline<cp_type>(*cpVec);
-		qSpline = new math::Spline<Eigen::Quaterniond>(*qVec);
-		// Create trajectories from the splines
-		cpTrajectory = new systems::Callback<double, cp_type>(
-				boost::ref(*cpSpline));
-		qTrajectory = new systems::Callback<double, Eigen::Quaterniond>(
-				boost::ref(*qSpline));
-	} else if (strcmp(line.c_str(), "jp_type") == 0) {
-		// Create our spline and trajectory if the first line of the parsed file informs us of a jp_type
-		std::vector<input_jp_type, Eigen::aligned_allocator<input_jp_type> > jp_vec;
-		float fLine[DOF + 1];
-		input_jp_type samp;
-		while (true) {
-			std::getline(fs, line);
-			if (!fs.good())
-				break;
-			t_tokenizer tok(line, sep);
-			int j = 0;
-			for (t_tokenizer::iterator beg = tok.begin(); beg != tok.end();
-					++beg) {
-				fLine[j] = boost::lexical_cast<float>(*beg);
-				j++;
+	if (log::TrajectoryFile::isTrajectoryFile(playName)) {
+		if (!initFromTrajectoryFile())
+			return false;
+	} else {
+		//Create stream from input file
+		std::ifstream fs(playName.c_str());
+		std::string line;
+
+		// Check to see the data type specified on the first line (jp_type or pose_type)
+		// this will inform us if we are tracking 4DOF WAM Joint Angles, 7DOF WAM Joint Angles, or WAM Poses
+		std::getline(fs, line);
+		// Using a boost tokenizer to parse the data of the file into our vector.
+		boost::char_separator<char> sep(",");
+		typedef boost::tokenizer<boost::char_separator<char> > t_tokenizer;
+		t_tokenizer tok(line, sep);
+		if (strcmp(line.c_str(), "pose_type") == 0) {
+			// Create our spline and trajectory if the first line of the parsed file informs us of a pose_type
+			inputType = 1;
+			cpVec = new std::vector<input_cp_type,
+					Eigen::aligned_allocator<input_cp_type> >();
+			qVec = new std::vector<input_quat_type,
+					Eigen::aligned_allocator<input_quat_type> >();
+
+			float fLine[8];
+			input_cp_type cpSamp;
+			input_quat_type qSamp;
+			while (true) {
+				std::getline(fs, line);
+				if (!fs.good())
+					break;
+				t_tokenizer tok(line, sep);
+				int j = 0;
+				for (t_tokenizer::iterator beg = tok.begin(); beg != tok.end();
+						++beg) {
+					fLine[j] = boost::lexical_cast<float>(*beg);
+					j++;
+				}
+				boost::get<0>(cpSamp) = fLine[0];
+				boost::get<0>(qSamp) = boost::get<0>(cpSamp);
+
+				boost::get<1>(cpSamp) << fLine[1], fLine[2], fLine[3];
+				boost::get<1>(qSamp) = Eigen::Quaterniond(fLine[4], fLine[5],
+						fLine[6], fLine[7]);
+				boost::get<1>(qSamp).normalize();
+				cpVec->push_back(cpSamp);
+				qVec->push_back(qSamp);
 			}
-			boost::get<0>(samp) = fLine[0];
-			// To handle the different WAM configurations
-			if (DOF == 3)
-				boost::get<1>(samp) << fLine[1], fLine[2], fLine[3];
-			else if (DOF == 4)
-				boost::get<1>(samp) << fLine[1], fLine[2], fLine[3], fLine[4];
-			else if (DOF == 7)
-				boost::get<1>(samp) << fLine[1], fLine[2], fLine[3], fLine[4], fLine[5], fLine[6], fLine[7];
-			jp_vec.push_back(samp);
+			// Make sure the vectors created are the same size
+			assert(cpVec->size() == qVec->size());
+			// Create our splines between points
+			cpSpline = new math::Spline<cp_type>(*cpVec);
+			qSpline = new math::Spline<Eigen::Quaterniond>(*qVec);
+			// Create trajectories from the splines
+			cpTrajectory = new systems::Callback<double, cp_type>(
+					boost::ref(*cpSpline));
+			qTrajectory = new systems::Callback<double, Eigen::Quaterniond>(
+					boost::ref(*qSpline));
+		} else if (strcmp(line.c_str(), "jp_type") == 0) {
+			// The spline is filled in by loadEntryPoint() once playback starts
+			jpSpline = new math::StreamingSpline<jp_type>();
+			// Create our trajectory
+			jpTrajectory = new systems::Callback<double, jp_type>(
+					boost::ref(*jpSpline));
+		} else {
+			// The first line does not contain "jp_type or pose_type" return false and exit.
+			printf(
+					"EXITING: First line of file must specify jp_type or pose_type data.");
+			btsleep(1.5);
+			return false;
 		}
-		// Create our splines between points
-		jpSpline = new math::Spline<jp_type>(jp_vec);
-		// Create our trajectory
-		jpTrajectory = new systems::Callback<double, jp_type>(
-				boost::ref(*jpSpline));
-	} else {
-		// The first line does not contain "jp_type or pose_type" return false and exit.
-		printf(
-				"EXITING: First line of file must specify jp_type or pose_type data.");
-		btsleep(1.5);
-		return false;
-	}
 
-	//Close the file
-	fs.close();
+		//Close the file
+		fs.close();
+	}
 	printf("\nFile Contains data in the form of: %s\n\n",
 			inputType == 0 ? "jp_type" : "pose_type");
 
@@ -280,6 +288,49 @@ bool Play<DOF>::init() {
 	return true;
 }
 
+// Maps a binary trajectory file (see log::TrajectoryFile) into memory. Pose
+// splines are built straight from the mapped knots; joint positions are
+// streamed from the mapping by loadEntryPoint().
+template<size_t DOF>
+bool Play<DOF>::initFromTrajectoryFile() {
+	try {
+		trajectory = new log::TrajectoryFile(playName);
+	} catch (const std::runtime_error& e) {
+		printf("EXITING: %s\n", e.what());
+		return false;
+	}
+
+	if (trajectory->getSpace() == log::TrajectoryFile::POSE_SPACE) {
+		inputType = 1;
+		cpVec = new std::vector<input_cp_type,
+				Eigen::aligned_allocator<input_cp_type> >(trajectory->size());
+		qVec = new std::vector<input_quat_type,
+				Eigen::aligned_allocator<input_quat_type> >(trajectory->size());
+		for (size_t k = 0; k < trajectory->size(); ++k) {
+			boost::get<0>((*cpVec)[k]) = trajectory->getS(k);
+			boost::get<0>((*qVec)[k]) = trajectory->getS(k);
+			trajectory->getPose(k, &boost::get<1>((*cpVec)[k]), &boost::get<1>((*qVec)[k]));
+			boost::get<1>((*qVec)[k]).normalize();
+		}
+		cpSpline = new math::Spline<cp_type>(*cpVec);
+		qSpline = new math::Spline<Eigen::Quaterniond>(*qVec);
+		cpTrajectory = new systems::Callback<double, cp_type>(
+				boost::ref(*cpSpline));
+		qTrajectory = new systems::Callback<double, Eigen::Quaterniond>(
+				boost::ref(*qSpline));
+	} else if (trajectory->getDimension() == DOF) {
+		inputType = 0;
+		jpSpline = new math::StreamingSpline<jp_type>();
+		jpTrajectory = new systems::Callback<double, jp_type>(
+				boost::ref(*jpSpline));
+	} else {
+		printf("EXITING: The trajectory was recorded on a %zu-DOF WAM.\n",
+				trajectory->getDimension());
+		return false;
+	}
+	return true;
+}
+
 // This function will run in a different thread and control displaying to the screen and user input
 template<size_t DOF>
 void Play<DOF>::displayEntryPoint() {
@@ -303,6 +354,8 @@ void Play<DOF>::displayEntryPoint() {
 	printf("  i    Pause\n");
 	printf("  s    Stop\n");
 	printf("  l    Loop\n");
+	printf("  +    Speed up (by 10%%, to at most 200%%)\n");
+	printf("  -    Slow down (by 10%%)\n");
 	printf("  q    Quit\n");
 	printf("  At any time, press [Enter] to open or close the Hand.\n");
 	printf("\n");
@@ -335,6 +388,12 @@ void Play<DOF>::displayEntryPoint() {
 				loop = true;
 				curState = PLAYING;
 				break;
+			case '+':
+				changeSpeed(0.1);
+				break;
+			case '-':
+				changeSpeed(-0.1);
+				break;
 			case 'q':
 				loop = false;
 				cms->currentControl();
@@ -351,6 +410,16 @@ void Play<DOF>::displayEntryPoint() {
 template<size_t DOF>
 void Play<DOF>::moveToStart() {
 	if (inputType == 0) {
+		// Reload from the beginning; the stream is consumed as it plays.
+		startLoadingThread();
+		while (!jpSpline->isFinished()
+				&& jpSpline->availableS() < jpSpline->initialS() + PRELOAD_TIME) {
+			btsleep(0.01);
+		}
+		if (!jpSpline->isReady()) {
+			printf("EXITING: The trajectory file contains no samples.\n");
+			exit(1);
+		}
 		wam.moveTo(jpSpline->eval(jpSpline->initialS()), true);
 	} else
 		wam.moveTo(
@@ -368,10 +437,18 @@ void Play<DOF>::pausePlayback() {
 	time.stop();
 }
 
+// Takes effect smoothly, even in the middle of playback.
+template<size_t DOF>
+void Play<DOF>::changeSpeed(double change) {
+	time.setSpeed(time.getSpeed() + change);
+	printf("Speed: %.0f%%\n", 100.0 * time.getSpeed());
+}
+
 template<size_t DOF>
 bool Play<DOF>::playbackActive() {
 	if (inputType == 0)
-		return (jpTrajectory->input.getValue() < jpSpline->finalS());
+		return (!jpSpline->isFinished()
+				|| jpTrajectory->input.getValue() < jpSpline->finalS());
 	else {
 		return (cpTrajectory->input.getValue() < cpSpline->finalS());
 	}
@@ -381,8 +458,7 @@ template<size_t DOF>
 void Play<DOF>::disconnectSystems() {
 	disconnect(wam.input);
 	wam.idle();
-	time.stop();
-	time.setOutput(0.0);
+	time.reset();
 }
 
 template<size_t DOF>
@@ -399,6 +475,84 @@ void Play<DOF>::reconnectSystems() {
 	}
 }
 
+template<size_t DOF>
+void Play<DOF>::startLoadingThread() {
+	stopLoadingThread();
+
+	// The trajectory is disconnected, so nothing is evaluating the spline.
+	jpSpline->clear();
+	stopLoading = false;
+	loadThread = boost::thread(&Play<DOF>::loadEntryPoint, this);
+}
+
+template<size_t DOF>
+void Play<DOF>::stopLoadingThread() {
+	stopLoading = true;
+	if (loadThread.joinable()) {
+		loadThread.join();
+	}
+}
+
+// Parses the joint positions from the file into jpSpline, waiting whenever
+// its buffer is full for playback to catch up.
+template<size_t DOF>
+void Play<DOF>::loadEntryPoint() {
+	input_jp_type samp;
+	if (trajectory != NULL) {
+		for (size_t k = 0; k < trajectory->size(); ++k) {
+			boost::get<0>(samp) = trajectory->getS(k);
+			trajectory->getPoint(k, &boost::get<1>(samp));
+			while (!jpSpline->add(samp)) {
+				if (stopLoading)
+					return;
+				btsleep(0.01);
+			}
+		}
+		while (!stopLoading && !jpSpline->finish()) {
+			btsleep(0.01);
+		}
+		return;
+	}
+
+	std::ifstream fs(playName.c_str());
+	std::string line;
+	std::getline(fs, line);  // Skip the "jp_type" header
+
+	boost::char_separator<char> sep(",");
+	typedef boost::tokenizer<boost::char_separator<char> > t_tokenizer;
+	float fLine[DOF + 1];
+	while (!stopLoading) {
+		std::getline(fs, line);
+		if (!fs.good())
+			break;
+		t_tokenizer tok(line, sep);
+		int j = 0;
+		for (t_tokenizer::iterator beg = tok.begin(); beg != tok.end();
+				++beg) {
+			fLine[j] = boost::lexical_cast<float>(*beg);
+			j++;
+		}
+		boost::get<0>(samp) = fLine[0];
+		// To handle the different WAM configurations
+		if (DOF == 3)
+			boost::get<1>(samp) << fLine[1], fLine[2], fLine[3];
+		else if (DOF == 4)
+			boost::get<1>(samp) << fLine[1], fLine[2], fLine[3], fLine[4];
+		else if (DOF == 7)
+			boost::get<1>(samp) << fLine[1], fLine[2], fLine[3], fLine[4], fLine[5], fLine[6], fLine[7];
+
+		while (!jpSpline->add(samp)) {
+			if (stopLoading)
+				return;
+			btsleep(0.01);
+		}
+	}
+
+	while (!stopLoading && !jpSpline->finish()) {
+		btsleep(0.01);
+	}
+}
+
 template<size_t DOF>
 int wam_main(int argc, char** argv, ProductManager& pm,
 		systems::Wam<DOF>& wam) {
@@ -207,32 +207,35 @@ void Teach<DOF>::display() {
 
 template<size_t DOF>
 void Teach<DOF>::createSpline() {
-	saveName = "recorded/" + saveName;
+	// Save the recording as a binary trajectory file (see log::TrajectoryFile),
+	// which play can map into memory instead of parsing.
+	fileOut = "recorded/" + saveName + ".traj";
+	double period = pm.getExecutionManager()->getPeriod();
 	if (recordType == 0) {
 		jpLogger->closeLog();
 		disconnect(jpLogger->input);
-		// Build spline between recorded points
+
 		log::Reader<jp_sample_type> lr(tmpFile);
-		lr.exportCSV(saveName.c_str());
+		log::TrajectoryFileWriter tfw(fileOut, log::TrajectoryFile::JOINT_SPACE, DOF, period);
+		for (size_t i = 0; i < lr.numRecords(); ++i) {
+			jp_sample_type samp = lr.getRecord();
+			tfw.add(boost::get<0>(samp), boost::get<1>(samp));
+		}
+		tfw.close();
 	}
 	else{
 		poseLogger->closeLog();
 		disconnect(poseLogger->input);
+
 		log::Reader<pose_sample_type> pr(tmpFile);
-		pr.exportCSV(saveName.c_str());
+		log::TrajectoryFileWriter tfw(fileOut, log::TrajectoryFile::POSE_SPACE, 7, period);
+		for (size_t i = 0; i < pr.numRecords(); ++i) {
+			pose_sample_type samp = pr.getRecord();
+			tfw.add(boost::get<0>(samp), boost::get<0>(boost::get<1>(samp)), boost::get<1>(boost::get<1>(samp)));
+		}
+		tfw.close();
 	}
-	// Adding our datatype as the first line of the recorded trajectory
-	fileOut = saveName + ".csv";
-	std::ifstream in(saveName.c_str());
-	std::ofstream out(fileOut.c_str());
-	if (recordType == 0)
-		out << "jp_type\n";
-	else
-		out << "pose_type\n";
-	out << in.rdbuf();
-	out.close();
-	in.close();
-	remove(saveName.c_str());
+	remove(tmpFile);
 	printf("Trajectory saved to the location: %s \n\n ", fileOut.c_str());
 }
 
@@ -6,6 +6,8 @@
  */
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <boost/thread.hpp>
 #include <boost/function.hpp>
@@ -14,6 +16,7 @@
 #include <barrett/units.h>
 #include <barrett/systems.h>
 #include <barrett/products/product_manager.h>
+#include <barrett/products/multi_product_manager.h>
 
 #include <barrett/config.h>
 
@@ -31,8 +34,13 @@ int main(int argc, char** argv) {
 	// Give us pretty stack-traces when things die
 	installExceptionHandler();
 
-	ProductManager pm0;
-	ProductManager pm1(barrett::EtcPathRelative("bus1/default.conf").c_str());
+	// Both WAMs are updated in the same execution cycle, with their CAN traffic overlapped.
+	std::vector<std::string> configFiles;
+	configFiles.push_back("");  // The default config file
+	configFiles.push_back(barrett::EtcPathRelative("bus1/default.conf"));
+	MultiProductManager mpm(configFiles);
+	ProductManager& pm0 = mpm[0];
+	ProductManager& pm1 = mpm[1];
 
 	printf("Starting the WAM on Bus 0...\n");
 	boost::thread wt0 = startWam(pm0, wamThread0<4>, wamThread0<7>);
@@ -45,7 +45,7 @@ namespace bus {
 
 
 BusManager::BusManager(CommunicationsBus* _bus) :
-	bus(_bus), deleteBus(false), messageBuffers()
+	bus(_bus), deleteBus(false), lastReceiveTime(0.0), messageBuffers()
 {
 	if (bus == NULL) {
 		bus = new CANSocket;
@@ -54,7 +54,7 @@ BusManager::BusManager(CommunicationsBus* _bus) :
 }
 
 BusManager::BusManager(int port) :
-	bus(NULL), deleteBus(true), messageBuffers()
+	bus(NULL), deleteBus(true), lastReceiveTime(0.0), messageBuffers()
 {
 	bus = new CANSocket(port);
 }
@@ -107,6 +107,17 @@ int BusManager::receive(int expectedBusId, unsigned char* data, size_t& len, boo
 	}
 }
 
+int BusManager::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blocking) const
+{
+	BARRETT_SCOPED_LOCK(getMutex());
+
+	int ret = bus->receiveRaw(busId, data, len, blocking);
+	if (ret == 0) {
+		lastReceiveTime = bus->getLastReceiveTime();
+	}
+	return ret;
+}
+
 int BusManager::updateBuffers() const
 {
 	BARRETT_SCOPED_LOCK(getMutex());
@@ -120,7 +131,7 @@ int BusManager::updateBuffers() const
 	while (true) {
 		ret = receiveRaw(busId, data, len, false);  // non-blocking read
 		if (ret == 0) {  // successfully received a message
-			if (busId != 1344) storeMessage(busId, data, len); // disregard safetyboard broadcast message
+			if (busId != 1344) storeMessage(busId, data, len, lastReceiveTime); // disregard safetyboard broadcast message
 		} else if (ret == 1) {  // would block
 			return 0;
 		} else {  // error
@@ -129,12 +140,12 @@ int BusManager::updateBuffers() const
 	}
 }
 
-void BusManager::storeMessage(int busId, const unsigned char* data, size_t len) const
+void BusManager::storeMessage(int busId, const unsigned char* data, size_t len, double time) const
 {
 	if (messageBuffers[busId].full()) {
 		(logMessage("BusManager::%s: Buffer overflow. ID = %d",true) %__func__ %busId).raise<std::runtime_error>();
 	}
-	messageBuffers[busId].push_back(Message(data, len));
+	messageBuffers[busId].push_back(Message(data, len, time));
 }
 
 bool BusManager::retrieveMessage(int busId, unsigned char* data, size_t& len) const
@@ -143,7 +154,7 @@ bool BusManager::retrieveMessage(int busId, unsigned char* data, size_t& len) co
 		return false;
 	}
 
-	messageBuffers[busId].front().copyTo(data, len);
+	messageBuffers[busId].front().copyTo(data, len, lastReceiveTime);
 	messageBuffers[busId].pop_front();
 
 	return true;
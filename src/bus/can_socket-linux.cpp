@@ -37,6 +37,7 @@
 
 #include <unistd.h>
 #include <errno.h>
+#include <time.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <sys/uio.h>
@@ -55,6 +56,16 @@ namespace bus {
 
 
 namespace detail {
+// The kernel stamps frames with CLOCK_REALTIME. Convert using the frame's age,
+// which doesn't depend on the epoch of highResolutionSystemTime().
+inline double receiveTimeFromTimestamp(const struct timespec& ts)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	double age = (now.tv_sec - ts.tv_sec) + 1e-9 * (now.tv_nsec - ts.tv_nsec);
+	return highResolutionSystemTime() - age;
+}
+
 struct can_handle {
 	typedef int handle_type;
 	static const handle_type NULL_HANDLE = -1;
@@ -67,12 +78,12 @@ struct can_handle {
 
 
 CANSocket::CANSocket() :
-	mutex(), handle(new detail::can_handle)
+	mutex(), handle(new detail::can_handle), lastReceiveTime(0.0)
 {
 }
 
 CANSocket::CANSocket(int port) throw(std::runtime_error) :
-	mutex(), handle(new detail::can_handle)
+	mutex(), handle(new detail::can_handle), lastReceiveTime(0.0)
 {
 	open(port);
 }
@@ -119,6 +130,15 @@ void CANSocket::open(int port) throw(std::logic_error, std::runtime_error)
 				% __func__ % -ret % strerror(-ret)).raise<std::runtime_error>();
 	}
 
+	// Have the kernel timestamp received frames, so that getLastReceiveTime()
+	// doesn't include the time it took to schedule the reading thread.
+	int enable = 1;
+	ret = setsockopt(handle->h, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+	if (ret != 0) {
+		logMessage("CANSocket::%s(): setsockopt(SO_TIMESTAMPNS): (%d) %s. Receive times will not be available.")
+				% __func__ % errno % strerror(errno);
+	}
+
 	// Note: This must be done after the ioctl(SIOCGCANSTATE) call above,
 	// otherwise send() will fail with ret = -6 (No such device or
 	// address). The ifr.ifr_index gets overwritten because it is actually a
@@ -223,7 +243,17 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 	BARRETT_SCOPED_LOCK(mutex);
 
 	struct can_frame frame;
-	int ret = recv(handle->h, (void *) &frame, sizeof(struct can_frame), blocking ? 0 : MSG_DONTWAIT);
+	struct iovec iov;
+	iov.iov_base = (void *) &frame;
+	iov.iov_len = sizeof(struct can_frame);
+	char control[CMSG_SPACE(sizeof(struct timespec))];
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+	int ret = recvmsg(handle->h, &msg, blocking ? 0 : MSG_DONTWAIT);
 
 	if (ret < 0) {
 		ret = -errno;  // Specific error info is in errno. Save a copy.
@@ -231,25 +261,25 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 		switch (ret) {
 		case -EAGAIN: // -EWOULDBLOCK
 			//logMessage("CANSocket::%s: "
-			//		"recv(): no data available during non-blocking read")
+			//		"recvmsg(): no data available during non-blocking read")
 			//		% __func__;
 			return 1;
 			break;
 		case -ETIMEDOUT:
 			logMessage("CANSocket::%s: "
-					"recv(): timed out")
+					"recvmsg(): timed out")
 					% __func__;
 			return 2;
 			break;
 		case -EBADF:
 			logMessage("CANSocket::%s: "
-					"recv(): aborted because socket was closed")
+					"recvmsg(): aborted because socket was closed")
 					% __func__;
 			return 2;
 			break;
 		default:
 			logMessage("CANSocket::%s: "
-					"recv(): (%d) %s")
+					"recvmsg(): (%d) %s")
 					% __func__ % -ret % strerror(-ret);
 			return 2;
 			break;
@@ -267,6 +297,15 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 	len = frame.can_dlc;
 	memcpy(data, frame.data, len);
 
+	lastReceiveTime = 0.0;
+	for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET  &&  cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+			struct timespec ts;
+			memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+			lastReceiveTime = detail::receiveTimeFromTimestamp(ts);
+		}
+	}
+
 	return 0;
 }
 
@@ -62,12 +62,12 @@ struct can_handle {
 
 
 CANSocket::CANSocket() :
-	mutex(), handle(new detail::can_handle)
+	mutex(), handle(new detail::can_handle), lastReceiveTime(0.0)
 {
 }
 
 CANSocket::CANSocket(int port) throw(std::runtime_error) :
-	mutex(), handle(new detail::can_handle)
+	mutex(), handle(new detail::can_handle), lastReceiveTime(0.0)
 {
 	open(port);
 }
@@ -186,6 +186,15 @@ void CANSocket::open(int port) throw(std::logic_error, std::runtime_error)
 				% __func__ % -ret % strerror(-ret)).raise<std::runtime_error>();
 	}
 
+	// Have the driver timestamp received frames, so that getLastReceiveTime()
+	// doesn't include the time it took to schedule the reading thread.
+	int takeTimestamps = RTCAN_TAKE_TIMESTAMPS;
+	ret = rt_dev_ioctl(handle->h, RTCAN_RTIOC_TAKE_TIMESTAMP, &takeTimestamps);
+	if (ret != 0) {
+		logMessage("CANSocket::%s(): rt_dev_ioctl(TAKE_TIMESTAMP): (%d) %s. Receive times will not be available.")
+				% __func__ % -ret % strerror(-ret);
+	}
+
 	nanosecs_rel_t timeout = (nanosecs_rel_t) 1e9 * CommunicationsBus::TIMEOUT;
 	ret = rt_dev_ioctl(handle->h, RTCAN_RTIOC_RCV_TIMEOUT, &timeout);
 	if (ret != 0) {
@@ -261,31 +270,41 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 	BARRETT_SCOPED_LOCK(mutex);
 
 	struct can_frame frame;
-	int ret = rt_dev_recv(handle->h, (void *) &frame, sizeof(can_frame_t), blocking ? 0 : MSG_DONTWAIT);
+	struct iovec iov;
+	iov.iov_base = (void *) &frame;
+	iov.iov_len = sizeof(can_frame_t);
+	nanosecs_abs_t timestamp = 0;
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = &timestamp;
+	msg.msg_controllen = sizeof(timestamp);
+	int ret = rt_dev_recvmsg(handle->h, &msg, blocking ? 0 : MSG_DONTWAIT);
 
 	if (ret < 0) {
 		switch (ret) {
 		case -EAGAIN: // -EWOULDBLOCK
 			//logMessage("CANSocket::%s: "
-			//		"rt_dev_recv(): no data available during non-blocking read")
+			//		"rt_dev_recvmsg(): no data available during non-blocking read")
 			//		% __func__;
 			return 1;
 			break;
 		case -ETIMEDOUT:
 			logMessage("CANSocket::%s: "
-					"rt_dev_recv(): timed out")
+					"rt_dev_recvmsg(): timed out")
 					% __func__;
 			return 2;
 			break;
 		case -EBADF:
 			logMessage("CANSocket::%s: "
-					"rt_dev_recv(): aborted because socket was closed")
+					"rt_dev_recvmsg(): aborted because socket was closed")
 					% __func__;
 			return 2;
 			break;
 		default:
 			logMessage("CANSocket::%s: "
-					"rt_dev_recv(): (%d) %s")
+					"rt_dev_recvmsg(): (%d) %s")
 					% __func__ % -ret % strerror(-ret);
 			return 2;
 			break;
@@ -296,6 +315,13 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 	len = frame.can_dlc;
 	memcpy(data, frame.data, len);
 
+	// RTCAN stamps frames with rtdm_clock_read(), the same clock as rt_timer_read().
+	if (msg.msg_controllen == sizeof(timestamp)) {
+		lastReceiveTime = 1e-9 * timestamp;
+	} else {
+		lastReceiveTime = 0.0;
+	}
+
 	if (frame.can_id & CAN_ERR_FLAG) {
 		if (frame.can_id & CAN_ERR_BUSOFF) {
 			logMessage("CANSocket::%s: bus-off") % __func__;
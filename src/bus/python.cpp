@@ -126,6 +126,7 @@ void pythonBusInterface() {
 		.def("send", &send)
 		.def("receive", &receive, receive_overloads())
 		.def("receiveRaw", &receiveRaw, receiveRaw_overloads())
+		.def("getLastReceiveTime", &CommunicationsBus::getLastReceiveTime)
 	;
 
 	class_<CANSocket, bases<CommunicationsBus>, boost::noncopyable>("CANSocket")
@@ -417,6 +417,15 @@ int bt_dynamics_create(struct bt_dynamics ** dynptr,
       bt_dynamics_destroy(dyn);
       return -1;
    }
+   
+   /* Make the JSIM */
+   dyn->jsim = gsl_matrix_alloc(dyn->dof,dyn->dof);
+   if (!dyn->jsim)
+   {
+      syslog(LOG_ERR,"%s: Out of memory.",__func__);
+      bt_dynamics_destroy(dyn);
+      return -1;
+   }
 
    (*dynptr) = dyn;
    return 0;
@@ -437,6 +446,8 @@ int bt_dynamics_destroy( struct bt_dynamics * dyn )
       gsl_matrix_free(dyn->temp3x3_2);
    if (dyn->temp3xn_1)
       gsl_matrix_free(dyn->temp3xn_1);
+   if (dyn->jsim)
+      gsl_matrix_free(dyn->jsim);
    
    for (i=0; i<dyn->nlinks; i++)
    if (dyn->link_array[i])
@@ -805,9 +816,10 @@ int bt_dynamics_eval_jsim(struct bt_dynamics * dyn, struct bt_kinematics * kin)
       /* First, calculate each moving link's Jacobian at the COM */
       
       /* Get the COM in world coords */
+      gsl_vector_memcpy( dyn->temp1_v3, kin_link->origin_pos );
       gsl_blas_dgemv( CblasNoTrans, 1.0, kin_link->rot_to_world,
                       link->com,
-                      0.0, dyn->temp1_v3 );
+                      1.0, dyn->temp1_v3 );
       
       /* Evaluate the jacobian at the link's COM point */
       bt_kinematics_eval_jacobian( kin, j+1, dyn->temp1_v3,
@@ -0,0 +1,223 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @trajectory_file.cpp
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <barrett/os.h>
+#include <barrett/log/trajectory_file.h>
+
+
+namespace barrett {
+namespace log {
+
+
+const char TrajectoryFile::MAGIC[8] = { 'B', 'T', 'T', 'R', 'A', 'J', '\0', '\0' };
+const boost::uint32_t TrajectoryFile::VERSION;
+const boost::uint32_t TrajectoryFile::BYTE_ORDER_MARK;
+
+
+namespace {
+// True if count items of itemSize bytes starting at offset lie within length
+// bytes. Written so that no header value, however large, can overflow.
+bool fits(boost::uint64_t offset, boost::uint64_t count, boost::uint64_t itemSize, boost::uint64_t length) {
+	return offset <= length  &&  count <= (length - offset) / itemSize;
+}
+}
+
+
+TrajectoryFile::TrajectoryFile(const std::string& fileName_) :
+	fileName(fileName_), data(NULL), length(0), header(NULL), points(NULL), s(NULL)
+{
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd == -1) {
+		(logMessage("TrajectoryFile::%s(): Could not open \"%s\": %s")
+				% __func__ % fileName % strerror(errno)).raise<std::runtime_error>();
+	}
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		(logMessage("TrajectoryFile::%s(): Could not stat \"%s\": %s")
+				% __func__ % fileName % strerror(errno)).raise<std::runtime_error>();
+	}
+	length = st.st_size;
+	if (length < sizeof(Header)) {
+		close(fd);
+		(logMessage("TrajectoryFile::%s(): \"%s\" is too short to be a trajectory file.")
+				% __func__ % fileName).raise<std::runtime_error>();
+	}
+
+	data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);  // The mapping keeps the file open.
+	if (data == MAP_FAILED) {
+		data = NULL;
+		(logMessage("TrajectoryFile::%s(): Could not map \"%s\": %s")
+				% __func__ % fileName % strerror(errno)).raise<std::runtime_error>();
+	}
+
+	// Nothing after this point reads the knots, so their pages aren't
+	// loaded until they're used.
+	header = static_cast<const Header*>(data);
+	const char* bytes = static_cast<const char*>(data);
+	const char* error = NULL;
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+		error = "is not a trajectory file";
+	} else if (header->version != VERSION) {
+		error = "has an unsupported version";
+	} else if (header->byteOrder != BYTE_ORDER_MARK) {
+		error = "was written on a host with a different byte order";
+	} else if (header->space != JOINT_SPACE  &&  !(header->space == POSE_SPACE  &&  header->dimension == 7)) {
+		error = "has an invalid space";
+	} else if (header->knotCount == 0  ||  header->dimension == 0) {
+		error = "is empty";
+	} else if (header->pointsOffset % sizeof(float) != 0  ||  header->sOffset % sizeof(double) != 0  ||
+			!fits(header->pointsOffset, header->knotCount, header->dimension * sizeof(float), length)  ||
+			!fits(header->sOffset, header->knotCount, sizeof(double), length)) {
+		error = "is truncated or corrupted";
+	}
+	if (error != NULL) {
+		munmap(data, length);
+		data = NULL;
+		(logMessage("TrajectoryFile::%s(): \"%s\" %s.")
+				% __func__ % fileName % error).raise<std::runtime_error>();
+	}
+
+	points = reinterpret_cast<const float*>(bytes + header->pointsOffset);
+	s = reinterpret_cast<const double*>(bytes + header->sOffset);
+}
+
+TrajectoryFile::~TrajectoryFile()
+{
+	if (data != NULL) {
+		munmap(data, length);
+	}
+}
+
+bool TrajectoryFile::isTrajectoryFile(const std::string& fileName)
+{
+	char magic[sizeof(MAGIC)];
+	std::ifstream file(fileName.c_str(), std::ios_base::binary);
+	return file.read(magic, sizeof(magic))  &&  std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+size_t TrajectoryFile::find(double sValue) const
+{
+	const double* i = std::upper_bound(s, s + size(), sValue);
+	return (i == s) ? 0 : (i - s) - 1;
+}
+
+
+TrajectoryFileWriter::TrajectoryFileWriter(const std::string& fileName_, TrajectoryFile::Space space,
+		size_t dimension, double samplePeriod) :
+	fileName(fileName_), file(fileName.c_str(), std::ios_base::binary | std::ios_base::trunc), header(), s(), row(dimension)
+{
+	if (dimension == 0  ||  (space == TrajectoryFile::POSE_SPACE  &&  dimension != 7)) {
+		(logMessage("TrajectoryFileWriter::%s(): Invalid dimension (%d).")
+				% __func__ % dimension).raise<std::logic_error>();
+	}
+	if ( !file ) {
+		(logMessage("TrajectoryFileWriter::%s(): Could not open \"%s\".")
+				% __func__ % fileName).raise<std::runtime_error>();
+	}
+
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, TrajectoryFile::MAGIC, sizeof(header.magic));
+	header.version = TrajectoryFile::VERSION;
+	header.byteOrder = TrajectoryFile::BYTE_ORDER_MARK;
+	header.space = space;
+	header.dimension = dimension;
+	header.samplePeriod = samplePeriod;
+	header.pointsOffset = sizeof(header);
+
+	// Reserve space for the header; the real one is written by close().
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+TrajectoryFileWriter::~TrajectoryFileWriter()
+{
+	if (file.is_open()) {
+		try {
+			close();
+		} catch (const std::runtime_error& e) {
+			// close() already logged the error.
+		}
+	}
+}
+
+void TrajectoryFileWriter::add(double sValue, const double* point)
+{
+	if ( !s.empty()  &&  sValue <= s.back() ) {
+		(logMessage("TrajectoryFileWriter::%s(): s must increase (%f after %f).")
+				% __func__ % sValue % s.back()).raise<std::logic_error>();
+	}
+
+	s.push_back(sValue);
+	std::copy(point, point + getDimension(), row.begin());
+	file.write(reinterpret_cast<const char*>(&row[0]), row.size() * sizeof(float));
+}
+
+void TrajectoryFileWriter::close()
+{
+	// Align the s column
+	size_t end = header.pointsOffset + s.size() * getDimension() * sizeof(float);
+	size_t padding = (sizeof(double) - end % sizeof(double)) % sizeof(double);
+	const char zeros[sizeof(double)] = {};
+	file.write(zeros, padding);
+
+	header.knotCount = s.size();
+	header.sOffset = end + padding;
+	if ( !s.empty() ) {
+		file.write(reinterpret_cast<const char*>(&s[0]), s.size() * sizeof(double));
+	}
+
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.close();
+	if (file.fail()) {
+		(logMessage("TrajectoryFileWriter::%s(): Could not write \"%s\".")
+				% __func__ % fileName).raise<std::runtime_error>();
+	}
+}
+
+
+}
+}
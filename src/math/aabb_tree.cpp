@@ -0,0 +1,128 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @aabb_tree.cpp
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/math/aabb_tree.h>
+
+
+namespace barrett {
+namespace math {
+
+
+const size_t AabbTree::NONE;
+const size_t AabbTree::MAX_LEAF_SIZE;
+const size_t AabbTree::MAX_DEPTH;
+
+
+namespace {
+struct CenterLess {
+	CenterLess(const std::vector<AabbTree::vector_type>& centers_, int axis_) :
+		centers(centers_), axis(axis_) {}
+
+	bool operator() (size_t a, size_t b) const {
+		return centers[a][axis] < centers[b][axis];
+	}
+
+	const std::vector<AabbTree::vector_type>& centers;
+	int axis;
+};
+}
+
+
+void AabbTree::build(const std::vector<Box>& boxes)
+{
+	nodes.clear();
+	items.resize(boxes.size());
+	itemBoxes.clear();
+	if (boxes.empty()) {
+		return;
+	}
+
+	std::vector<vector_type> centers(boxes.size());
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		items[i] = i;
+		centers[i] = boxes[i].center();
+	}
+
+	// A leaf holds up to MAX_LEAF_SIZE items, so there are fewer than
+	// 2 * size() nodes.
+	nodes.reserve(2 * boxes.size());
+	itemBoxes = boxes;  // Used for the node bounds during the build
+	buildNode(0, boxes.size(), centers, 1);
+
+	for (size_t i = 0; i < items.size(); ++i) {
+		itemBoxes[i] = boxes[items[i]];
+	}
+}
+
+void AabbTree::buildNode(size_t begin, size_t end, const std::vector<vector_type>& centers, size_t depth)
+{
+	if (depth > MAX_DEPTH) {
+		(logMessage("AabbTree::%s(): the tree is too deep.") % __func__).raise<std::logic_error>();
+	}
+
+	const size_t n = nodes.size();
+	nodes.push_back(Node());
+	nodes[n].right = 0;
+	nodes[n].begin = begin;
+	nodes[n].count = 0;
+
+	Box centerBounds;
+	for (size_t i = begin; i < end; ++i) {
+		nodes[n].box.extend(itemBoxes[items[i]]);
+		centerBounds.extend(centers[items[i]]);
+	}
+
+	if (end - begin <= MAX_LEAF_SIZE) {
+		nodes[n].count = end - begin;
+		return;
+	}
+
+	int axis;
+	(centerBounds.max - centerBounds.min).maxCoeff(&axis);
+
+	const size_t mid = begin + (end - begin) / 2;
+	std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+			CenterLess(centers, axis));
+
+	buildNode(begin, mid, centers, depth + 1);
+	nodes[n].right = nodes.size();
+	buildNode(mid, end, centers, depth + 1);
+}
+
+
+}
+}
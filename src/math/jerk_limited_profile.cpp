@@ -0,0 +1,507 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @jerk_limited_profile.cpp
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/math/jerk_limited_profile.h>
+
+
+namespace barrett {
+namespace math {
+
+
+namespace {
+
+// Halves the search interval each time. 60 iterations resolve the peak
+// velocity to well below the precision of a double.
+const int BISECTION_ITERATIONS = 60;
+
+// Golden-section search shrinks its interval by this factor each time, so the
+// same number of iterations resolves a turning point to about 3e-13 of vMax.
+const double GOLDEN_RATIO = 0.6180339887498949;
+
+// How closely a move of a requested duration must end at its target (relative
+// to the length of the move) and last the requested time
+const double POSITION_TOLERANCE = 1e-9;
+const double TIME_TOLERANCE = 1e-6;
+
+inline void integrate(double* p, double* v, double* a, double j, double t) {
+	*p += t * (*v + t * (*a / 2.0 + t * j / 6.0));
+	*v += t * (*a + t * j / 2.0);
+	*a += t * j;
+}
+
+}
+
+
+JerkLimitedProfile::JerkLimitedProfile() :
+	vMax(0.0), aMax(0.0), jMax(0.0),
+	numSegments(0), vPeak(0.0), tf(0.0), p_f(0.0) {}
+
+JerkLimitedProfile::JerkLimitedProfile(double velocity, double acceleration, double jerk) :
+	vMax(0.0), aMax(0.0), jMax(0.0),
+	numSegments(0), vPeak(0.0), tf(0.0), p_f(0.0)
+{
+	setLimits(velocity, acceleration, jerk);
+}
+
+JerkLimitedProfile::JerkLimitedProfile(double velocity, double acceleration,
+		double jerk, double initialVelocity, double pathLength) :
+	vMax(0.0), aMax(0.0), jMax(0.0),
+	numSegments(0), vPeak(0.0), tf(0.0), p_f(0.0)
+{
+	setLimits(velocity, acceleration, jerk);
+	plan(0.0, initialVelocity, 0.0, pathLength);
+}
+
+void JerkLimitedProfile::setLimits(double velocity, double acceleration, double jerk)
+{
+	if (velocity <= 0.0  ||  acceleration <= 0.0  ||  jerk <= 0.0) {
+		(logMessage("math::JerkLimitedProfile::%s(): Limits must be positive. "
+				"(velocity = %f, acceleration = %f, jerk = %f)")
+				% __func__ % velocity % acceleration % jerk).raise<std::logic_error>();
+	}
+
+	vMax = velocity;
+	aMax = acceleration;
+	jMax = jerk;
+}
+
+void JerkLimitedProfile::plan(double p0, double v0, double a0, double pf)
+{
+	const double distance = pf - p0;
+	double duration;
+
+	const double dPlus = peakDisplacement(v0, a0, vMax, &duration);
+	if (distance >= dPlus) {
+		build(p0, v0, a0, pf, vMax, (distance - dPlus) / vMax);
+		return;
+	}
+
+	const double dMinus = peakDisplacement(v0, a0, -vMax, &duration);
+	if (distance <= dMinus) {
+		build(p0, v0, a0, pf, -vMax, (distance - dMinus) / -vMax);
+		return;
+	}
+
+	build(p0, v0, a0, pf, findPeakVelocity(v0, a0, distance), 0.0);
+}
+
+bool JerkLimitedProfile::plan(double p0, double v0, double a0, double pf, double duration)
+{
+	plan(p0, v0, a0, pf);
+	if (tf >= duration) {
+		return tf == duration;
+	}
+
+	// Slow peaks in the direction of pf from where the axis would stop give
+	// every duration from shortestSlowedDuration() up.
+	const double distance = pf - p0;
+	double stopDuration;
+	const double stop = peakDisplacement(v0, a0, 0.0, &stopDuration);
+	if (distance != stop) {
+		const double sign = (distance > stop) ? 1.0 : -1.0;
+		const double vSlow = findSlowPeakVelocity(v0, a0, distance, sign);
+		if (stretch(p0, v0, a0, pf, duration, sign, std::fabs(vSlow))) {
+			return true;
+		}
+	}
+
+	// Shorter durations may still be reached by slowing the fastest move.
+	if (vPeak != 0.0  &&  stretch(p0, v0, a0, pf, duration,
+			(vPeak > 0.0) ? 1.0 : -1.0, std::fabs(vPeak))) {
+		return true;
+	}
+
+	plan(p0, v0, a0, pf);
+	return false;
+}
+
+double JerkLimitedProfile::shortestSlowedDuration(double p0, double v0, double a0, double pf) const
+{
+	const double distance = pf - p0;
+	double duration;
+	const double stop = peakDisplacement(v0, a0, 0.0, &duration);
+	if (distance == stop) {
+		return std::numeric_limits<double>::infinity();
+	}
+
+	const double sign = (distance > stop) ? 1.0 : -1.0;
+	const double v = findSlowPeakVelocity(v0, a0, distance, sign);
+	const double d = peakDisplacement(v0, a0, v, &duration);
+	return duration + (distance - d) / v;
+}
+
+// Lowers the peak velocity (with the given sign) below limit and adds a cruise
+// segment. The total time is
+//   t(v) = T_peak(v) + (distance - D(v)) / v
+// which grows without bound as v approaches zero, unless the axis would come
+// to rest exactly at pf anyway. D(v) isn't monotonic (see findPeakVelocity()),
+// so t(v) is only meaningful where the cruise time is non-negative. Search for
+// the slowest such v that is fast enough, starting from a bracket whose slow
+// end is known to be valid. If the cruise time is non-negative all the way up
+// to limit, t(v) is continuous there and any duration down to t(limit) is
+// found.
+bool JerkLimitedProfile::stretch(double p0, double v0, double a0, double pf,
+		double duration, double sign, double limit)
+{
+	const double distance = pf - p0;
+	double lo = limit * 1e-9;
+	double hi = limit;
+	double cruiseTime;
+
+	if ( !slowerThan(v0, a0, distance, sign * lo, duration, &cruiseTime)) {
+		return false;
+	}
+
+	for (int i = 0; i < BISECTION_ITERATIONS; ++i) {
+		double mid = (lo + hi) / 2.0;
+		if (slowerThan(v0, a0, distance, sign * mid, duration, &cruiseTime)) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	// lo is valid (and at least as slow as requested) by construction.
+	slowerThan(v0, a0, distance, sign * lo, duration, &cruiseTime);
+	build(p0, v0, a0, pf, sign * lo, cruiseTime);
+
+	// If the valid region ends before t(v) reaches duration, the search
+	// stops at the edge of the region instead. Check the result rather than
+	// trusting the bracket.
+	return std::fabs(tf - duration) <= TIME_TOLERANCE  &&
+			std::fabs(endPosition() - pf) <= POSITION_TOLERANCE * (1.0 + std::fabs(distance));
+}
+
+double JerkLimitedProfile::eval(double t) const
+{
+	double p, v, a;
+	eval(t, &p, &v, &a);
+	return p;
+}
+
+void JerkLimitedProfile::eval(double t, double* p, double* v, double* a) const
+{
+	if (t >= tf  ||  numSegments == 0) {
+		*p = p_f;
+		*v = 0.0;
+		*a = 0.0;
+		return;
+	}
+
+	size_t i = numSegments - 1;
+	while (i > 0  &&  segments[i].t > t) {
+		--i;
+	}
+
+	const Segment& s = segments[i];
+	*p = s.p;
+	*v = s.v;
+	*a = s.a;
+	if (t > s.t) {
+		integrate(p, v, a, s.j, t - s.t);
+	}
+}
+
+// Closed-form, time-optimal change from (v0, a0) to (v1, 0): ramp the
+// acceleration to a peak, optionally hold it at aMax, then ramp it back to zero.
+void JerkLimitedProfile::planVelocityChange(double v0, double a0, double v1,
+		VelocityChange* vc) const
+{
+	// The velocity we would reach by bringing the acceleration straight to zero
+	const double vStop = v0 + a0 * std::fabs(a0) / (2.0 * jMax);
+
+	// Work in a frame where the peak acceleration is non-negative.
+	const double s = (v1 >= vStop) ? 1.0 : -1.0;
+	const double as = s * a0;
+	const double dv = s * (v1 - v0);
+
+	double ap = aMax;
+	if (as <= aMax) {
+		double ap2 = jMax * dv + as * as / 2.0;
+		ap = (ap2 > 0.0) ? std::sqrt(ap2) : 0.0;
+		if (ap > aMax) {
+			ap = aMax;
+		}
+	}
+
+	vc->t[0] = std::fabs(ap - as) / jMax;
+	vc->j[0] = (ap >= as) ? s * jMax : -s * jMax;
+	vc->t[2] = ap / jMax;
+	vc->j[2] = -s * jMax;
+
+	const double dv1 = (as + ap) / 2.0 * vc->t[0];
+	const double dv3 = ap * ap / (2.0 * jMax);
+	vc->t[1] = (ap > 0.0) ? (dv - dv1 - dv3) / ap : 0.0;
+	if (vc->t[1] < 0.0) {
+		vc->t[1] = 0.0;
+	}
+	vc->j[1] = 0.0;
+
+	double p = 0.0, v = v0, a = a0;
+	vc->duration = 0.0;
+	for (int i = 0; i < 3; ++i) {
+		integrate(&p, &v, &a, vc->j[i], vc->t[i]);
+		vc->duration += vc->t[i];
+	}
+	vc->displacement = p;
+}
+
+// Displacement (and duration) of the move that changes velocity from v0 to
+// vPeak and immediately back to zero
+double JerkLimitedProfile::peakDisplacement(double v0, double a0, double vPeak,
+		double* duration) const
+{
+	VelocityChange up, down;
+	planVelocityChange(v0, a0, vPeak, &up);
+	planVelocityChange(vPeak, 0.0, 0.0, &down);
+
+	*duration = up.duration + down.duration;
+	return up.displacement + down.displacement;
+}
+
+// Finds the fastest peak velocity that covers distance without a cruise
+// segment. Requires D(-vMax) < distance < D(vMax), where D(v) is
+// peakDisplacement().
+//
+// D(v) isn't monotonic. Raising the peak lengthens the end of the velocity
+// change, which is spent near v, and lengthens the stop from v. Both add
+// displacement with the sign of v, except that the velocity change from
+// (v0, a0) has a kink at vStop, the velocity reached by bringing the
+// acceleration straight to zero: on either side of it the change starts by
+// pushing the acceleration the other way. So D can only decrease between vStop
+// and zero, which splits [-vMax, vMax] into at most three monotonic pieces:
+// rising, falling (between vStop and the turning point on the zero side of
+// it), and rising again. Each piece may hold a root; take the fastest.
+double JerkLimitedProfile::findPeakVelocity(double v0, double a0, double distance) const
+{
+	double bounds[4];
+	findMonotonicPieces(v0, a0, bounds);
+
+	double best = 0.0, bestDuration = 0.0;
+	bool found = false;
+	for (int i = 0; i < 3; ++i) {
+		double v, duration;
+		if (findRoot(v0, a0, distance, bounds[i], bounds[i + 1], &v, &duration)  &&
+				( !found  ||  duration < bestDuration )) {
+			best = v;
+			bestDuration = duration;
+			found = true;
+		}
+	}
+
+	// Round-off at the edges of the pieces can hide a root that sits on an
+	// edge. D is continuous and brackets distance over the whole range, so
+	// fall back to plain bisection, which still finds one.
+	if ( !found ) {
+		double duration;
+		findRoot(v0, a0, distance, -vMax, vMax, &best, &duration);
+	}
+	return best;
+}
+
+// Splits [-vMax, vMax] into the three pieces described above: peakDisplacement()
+// rises on [bounds[0], bounds[1]], falls on [bounds[1], bounds[2]], and rises
+// on [bounds[2], bounds[3]].
+void JerkLimitedProfile::findMonotonicPieces(double v0, double a0, double bounds[4]) const
+{
+	double vStop = v0 + a0 * std::fabs(a0) / (2.0 * jMax);
+	vStop = std::max(-vMax, std::min(vMax, vStop));
+
+	bounds[0] = -vMax;
+	if (vStop < 0.0) {
+		bounds[1] = vStop;
+		bounds[2] = findTurningPoint(v0, a0, vStop, 0.0, 1.0);  // a minimum
+	} else {
+		bounds[1] = findTurningPoint(v0, a0, 0.0, vStop, -1.0);  // a maximum
+		bounds[2] = vStop;
+	}
+	bounds[3] = vMax;
+}
+
+// Walking out from zero in the direction of sign, returns the first peak
+// velocity that covers distance without a cruise segment, or sign * vMax if
+// there is none. peakDisplacement(0) must be on the other side of distance,
+// so every slower peak in that direction needs a positive cruise.
+double JerkLimitedProfile::findSlowPeakVelocity(double v0, double a0,
+		double distance, double sign) const
+{
+	double bounds[4];
+	findMonotonicPieces(v0, a0, bounds);
+
+	for (int k = 0; k < 3; ++k) {
+		const int i = (sign > 0.0) ? k : 2 - k;
+		double lo = bounds[i], hi = bounds[i + 1];
+		if (sign > 0.0) {
+			lo = std::max(lo, 0.0);
+		} else {
+			hi = std::min(hi, 0.0);
+		}
+
+		double v, duration;
+		if (lo < hi  &&  findRoot(v0, a0, distance, lo, hi, &v, &duration)) {
+			return v;
+		}
+	}
+	return sign * vMax;
+}
+
+// Golden-section search for the v in [lo, hi] that minimizes
+// sign * peakDisplacement(v). The function must have a single turning point
+// in the range (or none).
+double JerkLimitedProfile::findTurningPoint(double v0, double a0,
+		double lo, double hi, double sign) const
+{
+	double duration;
+	double x1 = hi - GOLDEN_RATIO * (hi - lo);
+	double x2 = lo + GOLDEN_RATIO * (hi - lo);
+	double f1 = sign * peakDisplacement(v0, a0, x1, &duration);
+	double f2 = sign * peakDisplacement(v0, a0, x2, &duration);
+
+	for (int i = 0; i < BISECTION_ITERATIONS; ++i) {
+		if (f1 < f2) {
+			hi = x2;
+			x2 = x1;
+			f2 = f1;
+			x1 = hi - GOLDEN_RATIO * (hi - lo);
+			f1 = sign * peakDisplacement(v0, a0, x1, &duration);
+		} else {
+			lo = x1;
+			x1 = x2;
+			f1 = f2;
+			x2 = lo + GOLDEN_RATIO * (hi - lo);
+			f2 = sign * peakDisplacement(v0, a0, x2, &duration);
+		}
+	}
+
+	return (lo + hi) / 2.0;
+}
+
+// Bisects for the v in [lo, hi] with peakDisplacement(v) == distance, and
+// returns the duration of that move. peakDisplacement() must be monotonic on
+// [lo, hi]. Returns false if distance isn't between its values at lo and hi.
+bool JerkLimitedProfile::findRoot(double v0, double a0, double distance,
+		double lo, double hi, double* v, double* duration) const
+{
+	const double dLo = peakDisplacement(v0, a0, lo, duration) - distance;
+	const double dHi = peakDisplacement(v0, a0, hi, duration) - distance;
+	if ((dLo > 0.0  &&  dHi > 0.0)  ||  (dLo < 0.0  &&  dHi < 0.0)) {
+		return false;
+	}
+
+	const bool rising = dLo <= dHi;
+	for (int i = 0; i < BISECTION_ITERATIONS; ++i) {
+		double mid = (lo + hi) / 2.0;
+		if ((peakDisplacement(v0, a0, mid, duration) < distance) == rising) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	*v = (lo + hi) / 2.0;
+	peakDisplacement(v0, a0, *v, duration);
+	return true;
+}
+
+// True if moving with the given peak velocity needs a non-negative cruise and
+// takes at least duration seconds.
+bool JerkLimitedProfile::slowerThan(double v0, double a0, double distance,
+		double peakVelocity, double duration, double* cruiseTime) const
+{
+	double t;
+	const double d = peakDisplacement(v0, a0, peakVelocity, &t);
+	*cruiseTime = (distance - d) / peakVelocity;
+	return *cruiseTime >= 0.0  &&  t + *cruiseTime >= duration;
+}
+
+// The position the segments actually reach at finalT(), before eval() snaps
+// it to the target
+double JerkLimitedProfile::endPosition() const
+{
+	if (numSegments == 0) {
+		return p_f;
+	}
+
+	const Segment& s = segments[numSegments - 1];
+	double p = s.p, v = s.v, a = s.a;
+	integrate(&p, &v, &a, s.j, tf - s.t);
+	return p;
+}
+
+void JerkLimitedProfile::build(double p0, double v0, double a0, double pf,
+		double peakVelocity, double cruiseTime)
+{
+	VelocityChange up, down;
+	planVelocityChange(v0, a0, peakVelocity, &up);
+	planVelocityChange(peakVelocity, 0.0, 0.0, &down);
+
+	double durations[MAX_SEGMENTS] = {
+		up.t[0], up.t[1], up.t[2], cruiseTime, down.t[0], down.t[1], down.t[2] };
+	double jerks[MAX_SEGMENTS] = {
+		up.j[0], up.j[1], up.j[2], 0.0, down.j[0], down.j[1], down.j[2] };
+
+	double t = 0.0, p = p0, v = v0, a = a0;
+	numSegments = 0;
+	for (size_t i = 0; i < MAX_SEGMENTS; ++i) {
+		if (i == 3) {
+			// Remove round-off accumulated while reaching the peak
+			v = peakVelocity;
+			a = 0.0;
+		}
+
+		if (durations[i] > 0.0) {
+			Segment& s = segments[numSegments++];
+			s.t = t;
+			s.p = p;
+			s.v = v;
+			s.a = a;
+			s.j = jerks[i];
+
+			integrate(&p, &v, &a, jerks[i], durations[i]);
+			t += durations[i];
+		}
+	}
+
+	vPeak = peakVelocity;
+	tf = t;
+	p_f = pf;
+}
+
+
+}
+}
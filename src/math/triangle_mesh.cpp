@@ -0,0 +1,387 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @triangle_mesh.cpp
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/cstdint.hpp>
+
+#include <Eigen/Geometry>
+
+#include <barrett/os.h>
+#include <barrett/math/triangle_mesh.h>
+
+
+namespace barrett {
+namespace math {
+
+
+namespace {
+typedef TriangleMesh::vector_type vector_type;
+typedef TriangleMesh::Triangle Triangle;
+
+
+// Binary STL: an 80-byte header, a 32-bit triangle count, then 50 bytes per
+// triangle (normal, 3 vertices, attributes), all little-endian.
+const size_t STL_HEADER_SIZE = 84;
+const size_t STL_TRIANGLE_SIZE = 50;
+
+void parseStl(const std::string& data, const std::string& fileName,
+		std::vector<vector_type>* v, std::vector<Triangle>* t)
+{
+	if (data.size() >= STL_HEADER_SIZE) {
+		const unsigned char* count = reinterpret_cast<const unsigned char*>(data.data() + 80);
+		size_t n = count[0] | (count[1] << 8) | (count[2] << 16) | (size_t(count[3]) << 24);
+
+		// ASCII files can start with "solid", and so can binary ones. Trust the size.
+		if (data.size() == STL_HEADER_SIZE + n * STL_TRIANGLE_SIZE) {
+			for (size_t i = 0; i < n; ++i) {
+				const char* record = data.data() + STL_HEADER_SIZE + i * STL_TRIANGLE_SIZE;
+				for (size_t j = 0; j < 3; ++j) {
+					vector_type vertex;
+					for (size_t k = 0; k < 3; ++k) {
+						boost::uint32_t bits = 0;
+						for (size_t b = 0; b < 4; ++b) {
+							bits |= boost::uint32_t(static_cast<unsigned char>(record[12 + 12*j + 4*k + b])) << (8*b);
+						}
+						float f;
+						std::memcpy(&f, &bits, sizeof(f));
+						vertex[k] = f;
+					}
+					v->push_back(vertex);
+				}
+				t->push_back(Triangle(3*i, 3*i + 1, 3*i + 2));
+			}
+			return;
+		}
+	}
+
+	std::istringstream iss(data);
+	std::string token;
+	while (iss >> token) {
+		if (token == "vertex") {
+			vector_type vertex;
+			if ( !(iss >> vertex[0] >> vertex[1] >> vertex[2]) ) {
+				(logMessage("TriangleMesh::%s(): Bad vertex in STL file \"%s\".")
+						% __func__ % fileName).raise<std::runtime_error>();
+			}
+			v->push_back(vertex);
+		} else if (token == "endloop") {
+			if (v->size() != 3 * (t->size() + 1)) {
+				(logMessage("TriangleMesh::%s(): STL file \"%s\" contains a facet that isn't a triangle.")
+						% __func__ % fileName).raise<std::runtime_error>();
+			}
+			t->push_back(Triangle(v->size() - 3, v->size() - 2, v->size() - 1));
+		}
+	}
+}
+
+void parseObj(const std::string& data, const std::string& fileName,
+		std::vector<vector_type>* v, std::vector<Triangle>* t)
+{
+	std::istringstream iss(data);
+	std::string line, type;
+	std::vector<size_t> face;
+	while (std::getline(iss, line)) {
+		std::istringstream ls(line);
+		if ( !(ls >> type) ) {
+			continue;
+		}
+
+		if (type == "v") {
+			vector_type vertex;
+			if ( !(ls >> vertex[0] >> vertex[1] >> vertex[2]) ) {
+				(logMessage("TriangleMesh::%s(): Bad vertex in OBJ file \"%s\": \"%s\"")
+						% __func__ % fileName % line).raise<std::runtime_error>();
+			}
+			v->push_back(vertex);
+		} else if (type == "f") {
+			// Each corner is "v", "v/vt", "v//vn", or "v/vt/vn". Indices are
+			// 1-based; negative indices count back from the latest vertex.
+			face.clear();
+			std::string corner;
+			while (ls >> corner) {
+				long i = std::strtol(corner.c_str(), NULL, 10);
+				if (i < 0) {
+					i += v->size() + 1;
+				}
+				if (i < 1  ||  i > long(v->size())) {
+					(logMessage("TriangleMesh::%s(): Bad face in OBJ file \"%s\": \"%s\"")
+							% __func__ % fileName % line).raise<std::runtime_error>();
+				}
+				face.push_back(i - 1);
+			}
+
+			// Triangulate polygons as fans
+			for (size_t j = 2; j < face.size(); ++j) {
+				t->push_back(Triangle(face[0], face[j-1], face[j]));
+			}
+		}
+	}
+}
+
+
+struct VertexLess {
+	bool operator() (const vector_type& a, const vector_type& b) const {
+		return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+	}
+};
+
+double angle(const vector_type& a, const vector_type& b) {
+	return std::atan2(a.cross(b).norm(), a.dot(b));
+}
+}
+
+
+struct TriangleMesh::Nearest {
+	Nearest(const TriangleMesh& mesh_, const vector_type& p_, double maxDistance) :
+		mesh(mesh_), p(p_), squaredDistance(maxDistance * maxDistance), normal(NULL) {}
+
+	void operator() (size_t t) {
+		const vector_type* n;
+		vector_type c = mesh.closestPoint(t, p, &n);
+		double d = (c - p).squaredNorm();
+		if (d <= squaredDistance) {
+			squaredDistance = d;
+			closest = c;
+			normal = n;
+		}
+	}
+
+	const TriangleMesh& mesh;
+	const vector_type& p;
+
+	double squaredDistance;
+	vector_type closest;
+	const vector_type* normal;
+};
+
+
+void TriangleMesh::load(const std::string& fileName, double scale)
+{
+	std::ifstream file(fileName.c_str(), std::ios_base::binary);
+	if ( !file ) {
+		(logMessage("TriangleMesh::%s(): Could not open \"%s\".")
+				% __func__ % fileName).raise<std::runtime_error>();
+	}
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	std::string extension = fileName.substr(fileName.find_last_of('.') + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	std::vector<vector_type> v;
+	std::vector<Triangle> t;
+	if (extension == "stl") {
+		parseStl(data, fileName, &v, &t);
+	} else if (extension == "obj") {
+		parseObj(data, fileName, &v, &t);
+	} else {
+		(logMessage("TriangleMesh::%s(): \"%s\" is not an .stl or .obj file.")
+				% __func__ % fileName).raise<std::runtime_error>();
+	}
+
+	if (t.empty()) {
+		(logMessage("TriangleMesh::%s(): \"%s\" contains no triangles.")
+				% __func__ % fileName).raise<std::runtime_error>();
+	}
+	for (size_t i = 0; i < v.size(); ++i) {
+		v[i] *= scale;
+	}
+	build(v, t);
+}
+
+void TriangleMesh::build(const std::vector<vector_type>& v, const std::vector<Triangle>& t)
+{
+	vertices.clear();
+	triangles.clear();
+
+	// Merge coincident vertices so neighboring triangles share edges
+	std::map<vector_type, size_t, VertexLess> merged;
+	std::vector<size_t> index(v.size());
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::pair<std::map<vector_type, size_t, VertexLess>::iterator, bool> result =
+				merged.insert(std::make_pair(v[i], vertices.size()));
+		if (result.second) {
+			vertices.push_back(v[i]);
+		}
+		index[i] = result.first->second;
+	}
+
+	for (size_t i = 0; i < t.size(); ++i) {
+		Triangle tri;
+		for (size_t j = 0; j < 3; ++j) {
+			if (t[i].v[j] >= v.size()) {
+				(logMessage("TriangleMesh::%s(): Triangle %d refers to vertex %d, but there are only %d vertices.")
+						% __func__ % i % t[i].v[j] % v.size()).raise<std::logic_error>();
+			}
+			tri.v[j] = index[t[i].v[j]];
+		}
+
+		// Skip degenerate triangles; they have no normal.
+		const vector_type& a = vertices[tri.v[0]];
+		if ((vertices[tri.v[1]] - a).cross(vertices[tri.v[2]] - a).squaredNorm() > 0.0) {
+			triangles.push_back(tri);
+		}
+	}
+
+	// Pseudonormals (Baerentzen and Aanaes, 2005): the sign of (p - c).n, where
+	// c is the nearest point on the surface and n is the pseudonormal of the
+	// feature c lies on, tells whether p is inside a closed mesh.
+	faceNormals.resize(triangles.size());
+	edgeNormals.resize(3 * triangles.size());
+	vertexNormals.assign(vertices.size(), vector_type::Zero());
+
+	typedef std::map<std::pair<size_t, size_t>, vector_type> edge_map_type;
+	edge_map_type edges;
+
+	std::vector<AabbTree::Box> boxes(triangles.size());
+	for (size_t i = 0; i < triangles.size(); ++i) {
+		const size_t* tv = triangles[i].v;
+		faceNormals[i] = (vertices[tv[1]] - vertices[tv[0]]).cross(vertices[tv[2]] - vertices[tv[0]]).normalized();
+
+		for (size_t j = 0; j < 3; ++j) {
+			const vector_type& corner = vertices[tv[j]];
+			vertexNormals[tv[j]] += angle(vertices[tv[(j+1)%3]] - corner, vertices[tv[(j+2)%3]] - corner) * faceNormals[i];
+
+			std::pair<size_t, size_t> edge(std::min(tv[j], tv[(j+1)%3]), std::max(tv[j], tv[(j+1)%3]));
+			edge_map_type::iterator e = edges.insert(std::make_pair(edge, vector_type::Zero())).first;
+			e->second += faceNormals[i];
+
+			boxes[i].extend(corner);
+		}
+	}
+
+	for (size_t i = 0; i < vertexNormals.size(); ++i) {
+		vertexNormals[i].normalize();
+	}
+	for (size_t i = 0; i < triangles.size(); ++i) {
+		const size_t* tv = triangles[i].v;
+		for (size_t j = 0; j < 3; ++j) {
+			std::pair<size_t, size_t> edge(std::min(tv[j], tv[(j+1)%3]), std::max(tv[j], tv[(j+1)%3]));
+			edgeNormals[3*i + j] = edges[edge].normalized();
+		}
+	}
+
+	tree.build(boxes);
+}
+
+bool TriangleMesh::penetration(const vector_type& p, double maxDepth, double* depth, vector_type* direction) const
+{
+	AabbTree::Box query(p, p);
+	query.inflate(maxDepth);
+
+	Nearest nearest(*this, p, maxDepth);
+	tree.forEachIntersecting(query, nearest);
+
+	if (nearest.normal == NULL) {
+		return false;  // Outside, or pushed through
+	}
+	*direction = nearest.closest - p;
+	if (direction->dot(*nearest.normal) <= 0.0) {
+		return false;  // Outside
+	}
+	*depth = std::sqrt(nearest.squaredDistance);
+	*direction /= *depth;
+	return true;
+}
+
+// From Ericson, "Real-Time Collision Detection", section 5.1.5
+TriangleMesh::vector_type TriangleMesh::closestPoint(size_t t, const vector_type& p, const vector_type** normal) const
+{
+	const size_t* tv = triangles[t].v;
+	const vector_type& a = vertices[tv[0]];
+	const vector_type& b = vertices[tv[1]];
+	const vector_type& c = vertices[tv[2]];
+	vector_type ab = b - a;
+	vector_type ac = c - a;
+
+	vector_type ap = p - a;
+	double d1 = ab.dot(ap);
+	double d2 = ac.dot(ap);
+	if (d1 <= 0.0  &&  d2 <= 0.0) {
+		*normal = &vertexNormals[tv[0]];
+		return a;
+	}
+
+	vector_type bp = p - b;
+	double d3 = ab.dot(bp);
+	double d4 = ac.dot(bp);
+	if (d3 >= 0.0  &&  d4 <= d3) {
+		*normal = &vertexNormals[tv[1]];
+		return b;
+	}
+
+	double vc = d1*d4 - d3*d2;
+	if (vc <= 0.0  &&  d1 >= 0.0  &&  d3 <= 0.0) {
+		*normal = &edgeNormals[3*t + 0];
+		return a + (d1 / (d1 - d3)) * ab;
+	}
+
+	vector_type cp = p - c;
+	double d5 = ab.dot(cp);
+	double d6 = ac.dot(cp);
+	if (d6 >= 0.0  &&  d5 <= d6) {
+		*normal = &vertexNormals[tv[2]];
+		return c;
+	}
+
+	double vb = d5*d2 - d1*d6;
+	if (vb <= 0.0  &&  d2 >= 0.0  &&  d6 <= 0.0) {
+		*normal = &edgeNormals[3*t + 2];
+		return a + (d2 / (d2 - d6)) * ac;
+	}
+
+	double va = d3*d6 - d5*d4;
+	if (va <= 0.0  &&  (d4 - d3) >= 0.0  &&  (d5 - d6) >= 0.0) {
+		*normal = &edgeNormals[3*t + 1];
+		return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+	}
+
+	*normal = &faceNormals[t];
+	double denom = 1.0 / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+
+}
+}
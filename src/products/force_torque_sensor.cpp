@@ -34,6 +34,7 @@
 #include <stdexcept>
 
 #include <barrett/os.h>
+#include <barrett/bus/abstract/communications_bus.h>
 #include <barrett/products/puck.h>
 #include <barrett/products/abstract/special_puck.h>
 #include <barrett/products/force_torque_sensor.h>
@@ -58,6 +59,16 @@ void ForceTorqueSensor::setPuck(Puck* puck)
 }
 /** update Method establishes new force and torque values from the sensor */
 void ForceTorqueSensor::update(bool realtime)
+{
+	BARRETT_SCOPED_LOCK(bus->getMutex());
+
+	requestUpdate();
+	receiveUpdate(true, realtime);
+
+	boost::this_thread::yield();
+}
+/** requestUpdate Method asks the sensor for new force and torque values */
+void ForceTorqueSensor::requestUpdate()
 {
 	int ret;
 
@@ -69,24 +80,53 @@ void ForceTorqueSensor::update(bool realtime)
 				"Puck::sendGetPropertyRequest() returned error %d.")
 				% __func__ % ret).raise<std::runtime_error>();
 	}
+}
+/** receiveUpdate Method collects the force and torque replies */
+bool ForceTorqueSensor::receiveUpdate(bool blocking, bool realtime)
+{
+	int ret;
 
+	BARRETT_SCOPED_LOCK(bus->getMutex());
 
 	// Receive force message
-	ret = Puck::receiveGetPropertyReply<ForceParser>(*bus, id, propId, &cf, true, realtime);
-	if (ret != 0) {
-		(logMessage("ForceTorqueSensor::%s(): Failed to receive reply. "
-				"Puck::receiveGetPropertyReply() returned error %d while receiving FT Force reply from ID=%d.")
-				% __func__ % ret % id).raise<std::runtime_error>();
+	if ( !forceReceived ) {
+		ret = Puck::receiveGetPropertyReply<ForceParser>(*bus, id, propId, &cf, blocking, realtime);
+		if (ret == 1  &&  !blocking) {  // would block
+			return false;
+		} else if (ret != 0) {
+			(logMessage("ForceTorqueSensor::%s(): Failed to receive reply. "
+					"Puck::receiveGetPropertyReply() returned error %d while receiving FT Force reply from ID=%d.")
+					% __func__ % ret % id).raise<std::runtime_error>();
+		}
+		forceReceived = true;
 	}
 
 	// Receive torque message
-	ret = Puck::receiveGetPropertyReply<TorqueParser>(*bus, id, propId, &ct, true, realtime);
-	if (ret != 0) {
+	ret = Puck::receiveGetPropertyReply<TorqueParser>(*bus, id, propId, &ct, blocking, realtime);
+	if (ret == 1  &&  !blocking) {  // would block
+		return false;
+	} else if (ret != 0) {
 		(logMessage("ForceTorqueSensor::%s(): Failed to receive reply. "
 				"Puck::receiveGetPropertyReply() returned error %d while receiving FT Torque reply from ID=%d.")
 				% __func__ % ret % id).raise<std::runtime_error>();
 	}
-	boost::this_thread::yield();
+	forceReceived = false;
+
+	return true;
+}
+/** cancelUpdate Method discards the replies to an abandoned request */
+void ForceTorqueSensor::cancelUpdate(bool realtime)
+{
+	unsigned char data[bus::CommunicationsBus::MAX_MESSAGE_LEN];
+	size_t len;
+	const int busIds[] = { ForceParser::busId(id, propId), TorqueParser::busId(id, propId) };
+
+	BARRETT_SCOPED_LOCK(bus->getMutex());
+
+	forceReceived = false;
+	for (size_t i = 0; i < sizeof(busIds) / sizeof(busIds[0]); ++i) {
+		while (bus->receive(busIds[i], data, len, false, realtime) == 0) {}
+	}
 }
 /** updateAccel Method clears stored acceleration values in each axis */
 void ForceTorqueSensor::updateAccel(bool realtime)
@@ -201,70 +201,71 @@ void Hand::update(unsigned int sensors, bool realtime)
 	//	ul.lock();
 	//}
 
-	// Send requests
-	if (sensors & S_POSITION) {
-		{
-			BARRETT_SCOPED_LOCK(bus.getMutex());
-			group.sendGetPropertyRequest(group.getPropertyId(Puck::P));
-
-			group.receiveGetPropertyReply<MotorPuck::CombinedPositionParser<int> >(group.getPropertyId(Puck::P), encoderTmp.data(), realtime);
-		}
-		boost::this_thread::yield();
-
-		for (size_t i = 0; i < DOF; ++i) {
-			primaryEncoder[i] = encoderTmp[i].get<0>();
-			secondaryEncoder[i] = encoderTmp[i].get<1>();
-		}
-		// For the fingers
-		for (size_t i = 0; i < DOF-1; ++i) {
-			// If we got a reading from the secondary encoder and it's enabled...
-			if (useSecondaryEncoders  &&  secondaryEncoder[i] != std::numeric_limits<int>::max()) {
-				innerJp[i] = motorPucks[i].counts2rad(secondaryEncoder[i]) / J2_ENCODER_RATIO;
-				outerJp[i] = motorPucks[i].counts2rad(primaryEncoder[i]) * (1.0/J2_RATIO + 1.0/J3_RATIO) - innerJp[i];
-			} else {
-				// These calculations are only valid before breakaway!
-				innerJp[i] = motorPucks[i].counts2rad(primaryEncoder[i]) / J2_RATIO;
-				outerJp[i] = innerJp[i] * J2_RATIO / J3_RATIO;
-			}
-		}
+	bool position = sensors & S_POSITION;
+	bool fingertipTorque = hasFingertipTorqueSensors()  &&  (sensors & S_FINGERTIP_TORQUE);
+	bool tactFull = hasTactSensors()  &&  (sensors & S_TACT_FULL);
+	bool tactTop10 = hasTactSensors()  &&  (sensors & S_TACT_TOP10);
 
-		// For the spread
-		innerJp[SPREAD_INDEX] = outerJp[SPREAD_INDEX] = motorPucks[SPREAD_INDEX].counts2rad(primaryEncoder[SPREAD_INDEX]) / SPREAD_RATIO;
+	// Send every request before receiving any of the replies, so they all
+	// arrive within a single bus round trip.
+	PuckGroup::PropertyBatch batch(group);
+	if (position) {
+		batch.add<MotorPuck::CombinedPositionParser<int> >(Puck::P, encoderTmp.data());
 	}
-	
-	if (hasFingertipTorqueSensors()  &&  sensors & S_FINGERTIP_TORQUE) {
-		{
-			BARRETT_SCOPED_LOCK(bus.getMutex());
-			group.sendGetPropertyRequest(group.getPropertyId(Puck::SG));
-
-			group.receiveGetPropertyReply<Puck::StandardParser>(group.getPropertyId(Puck::SG), ftt.data(), realtime);
-		}
-		boost::this_thread::yield();
+	if (fingertipTorque) {
+		batch.add(Puck::SG, ftt.data());
 	}
-	
-	
-	if (hasTactSensors()) {
-		if(sensors & S_TACT_FULL){
-			BARRETT_SCOPED_LOCK(bus.getMutex());
-			// This should be TactilePuck::requestFull()
+
+	{
+		BARRETT_SCOPED_LOCK(bus.getMutex());
+
+		batch.send();
+		// These should be TactilePuck::requestFull() and TactilePuck::requestTop10()
+		if (tactFull) {
 			group.setProperty(Puck::TACT, TactilePuck::FULL_FORMAT);
+		}
+		if (tactTop10) {
+			group.setProperty(Puck::TACT, TactilePuck::TOP10_FORMAT);
+		}
 
-			for (size_t i = 0; i < tactilePucks.size(); ++i) {
+		batch.receive(realtime);
+		for (size_t i = 0; i < tactilePucks.size(); ++i) {
+			if (tactFull) {
 				tactilePucks[i]->receiveFull(realtime);
 			}
+			if (tactTop10) {
+				tactilePucks[i]->receiveTop10(realtime);
+			}
 		}
+	}
+	boost::this_thread::yield();
 
-		if (sensors & S_TACT_TOP10) {
-			BARRETT_SCOPED_LOCK(bus.getMutex());
-			// This should be TactilePuck::requestTop10()
-			group.setProperty(Puck::TACT, TactilePuck::TOP10_FORMAT);
+	if (position) {
+		updatePosition(encoderTmp.data());
+	}
+}
 
-			for (size_t i = 0; i < tactilePucks.size(); ++i) {
-				tactilePucks[i]->receiveTop10(realtime);
-			}
+void Hand::updatePosition(const encoder_type encoders[])
+{
+	for (size_t i = 0; i < DOF; ++i) {
+		primaryEncoder[i] = encoders[i].get<0>();
+		secondaryEncoder[i] = encoders[i].get<1>();
+	}
+	// For the fingers
+	for (size_t i = 0; i < DOF-1; ++i) {
+		// If we got a reading from the secondary encoder and it's enabled...
+		if (useSecondaryEncoders  &&  secondaryEncoder[i] != std::numeric_limits<int>::max()) {
+			innerJp[i] = motorPucks[i].counts2rad(secondaryEncoder[i]) / J2_ENCODER_RATIO;
+			outerJp[i] = motorPucks[i].counts2rad(primaryEncoder[i]) * (1.0/J2_RATIO + 1.0/J3_RATIO) - innerJp[i];
+		} else {
+			// These calculations are only valid before breakaway!
+			innerJp[i] = motorPucks[i].counts2rad(primaryEncoder[i]) / J2_RATIO;
+			outerJp[i] = innerJp[i] * J2_RATIO / J3_RATIO;
 		}
-		boost::this_thread::yield();
 	}
+
+	// For the spread
+	innerJp[SPREAD_INDEX] = outerJp[SPREAD_INDEX] = motorPucks[SPREAD_INDEX].counts2rad(primaryEncoder[SPREAD_INDEX]) / SPREAD_RATIO;
 }
 
 /** */
@@ -52,11 +52,11 @@ void MotorPuck::setPuck(Puck* puck)
 	SpecialPuck::setPuck(puck);
 
 	if (p != NULL) {
-		cts = p->getProperty(Puck::CTS);
+		cts = p->getCachedProperty(Puck::CTS);
 		rpc = 2*M_PI / cts;
 		cpr = cts / (2*M_PI);
 
-		ipnm = p->getProperty(Puck::IPNM);
+		ipnm = p->getCachedProperty(Puck::IPNM);
 	}
 }
 
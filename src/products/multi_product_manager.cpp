@@ -0,0 +1,133 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file multi_product_manager.cpp
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/detail/stl_utils.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/real_time_execution_manager.h>
+#include <barrett/products/product_manager.h>
+#include <barrett/products/multi_product_manager.h>
+
+
+namespace barrett {
+
+
+// Sends every bus's WAM position request. Managed first, so it runs before the
+// Systems that read the replies.
+class MultiProductManager::Prefetcher : public systems::System {
+public:
+	Prefetcher(systems::ExecutionManager* em, const std::vector<ProductManager*>& pms_) :
+		systems::System("MultiProductManager::Prefetcher"), pms(pms_)
+	{
+		em->startManaging(*this);
+	}
+	virtual ~Prefetcher() { mandatoryCleanUp(); }
+
+protected:
+	virtual void operate() {
+		for (size_t i = 0; i < pms.size(); ++i) {
+			pms[i]->requestWamUpdate();
+		}
+	}
+
+	const std::vector<ProductManager*>& pms;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(Prefetcher);
+};
+
+
+MultiProductManager::MultiProductManager(const std::vector<std::string>& configFiles, double period_s, int rt_priority) :
+	pms(), rtem(NULL), prefetcher(NULL)
+{
+	logMessage("MultiProductManager::%s()") % __func__;
+
+	if (configFiles.empty()) {
+		(logMessage("MultiProductManager::%s(): configFiles is empty.") % __func__).raise<std::invalid_argument>();
+	}
+
+	rtem = new systems::RealTimeExecutionManager(period_s, rt_priority);
+	try {
+		for (size_t i = 0; i < configFiles.size(); ++i) {
+			pms.push_back(new ProductManager(configFiles[i].empty() ? NULL : configFiles[i].c_str()));
+			pms.back()->setExecutionManager(rtem);
+		}
+		prefetcher = new Prefetcher(rtem, pms);
+	} catch (...) {
+		detail::purge(pms);
+		delete rtem;
+		throw;
+	}
+}
+
+MultiProductManager::~MultiProductManager()
+{
+	logMessage("MultiProductManager::%s()") % __func__;
+
+	// The Products' Systems unregister themselves from rtem, so rtem goes last.
+	rtem->stop();
+	delete prefetcher;
+	detail::purge(pms);
+	delete rtem;
+}
+
+ProductManager& MultiProductManager::getProductManager(size_t i)
+{
+	if (i >= pms.size()) {
+		(logMessage("MultiProductManager::%s(): Invalid index: %d (there are %d buses).")
+				% __func__ % i % pms.size()).raise<std::out_of_range>();
+	}
+	return *pms[i];
+}
+
+void MultiProductManager::startExecutionManager()
+{
+	if ( !rtem->isRunning() ) {
+		rtem->start();
+	}
+}
+
+void MultiProductManager::cleanUpAfterEstop()
+{
+	// The Prefetcher mustn't run while the WAMs are being destroyed.
+	rtem->stop();
+	for (size_t i = 0; i < pms.size(); ++i) {
+		pms[i]->cleanUpAfterEstop();
+	}
+}
+
+
+}
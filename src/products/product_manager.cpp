@@ -47,6 +47,7 @@
 #include <barrett/bus/abstract/communications_bus.h>
 #include <barrett/bus/bus_manager.h>
 #include <barrett/products/puck.h>
+#include <barrett/products/puck_cache.h>
 #include <barrett/products/hand.h>
 #include <barrett/products/gimbals_hand_controller.h>
 #include <barrett/products/safety_module.h>
@@ -62,11 +63,12 @@ namespace barrett {
 
 
 const std::string ProductManager::DEFAULT_CONFIG_FILE = barrett::EtcPathRelative("default.conf");
+const std::string ProductManager::DEFAULT_PUCK_CACHE_FILE = barrett::EtcPathRelative("puck_cache");
 
 ProductManager::ProductManager(const char* configFile, bus::CommunicationsBus* _bus) :
 	config(), bus(_bus), deleteBus(false),
-	pucks(), wamPucks(MAX_WAM_DOF), handPucks(Hand::DOF),
-	sm(NULL), rtem(NULL), wam3(NULL), wam4(NULL), wam7(NULL), fts(NULL), hand(NULL), ghc(NULL)
+	pucks(), wamPucks(MAX_WAM_DOF), handPucks(Hand::DOF), puckCache(NULL),
+	sm(NULL), rtem(NULL), deleteRtem(true), wam3(NULL), wam4(NULL), wam7(NULL), fts(NULL), hand(NULL), ghc(NULL)
 {
 	int ret;
 
@@ -127,6 +129,10 @@ ProductManager::ProductManager(const char* configFile, bus::CommunicationsBus* _
 		if ( !bus->isOpen() ) {
 			bus->open(config.lookup("bus.port"));
 		}
+
+		std::string puckCacheFile = DEFAULT_PUCK_CACHE_FILE;
+		config.lookupValue("bus.puck_cache", puckCacheFile);
+		puckCache = new PuckCache(puckCacheFile);
 	} catch (libconfig::ParseException pe) {
 		printf("\n>>> CONFIG FILE ERROR on line %d of %s: \"%s\"\n\n", pe.getLine(), configFile, pe.getError());
 		printf("Check your configuration file directory to ensure that the proper configuration files are installed.\n");
@@ -163,6 +169,8 @@ ProductManager::~ProductManager()
 	delete sm;
 	sm = NULL;
 	detail::purge(pucks);
+	delete puckCache;
+	puckCache = NULL;
 	if (deleteBus) {
 		delete bus;
 		bus = NULL;
@@ -171,43 +179,57 @@ ProductManager::~ProductManager()
 
 void ProductManager::enumerate()
 {
-	int ret, result;
 	int propId = Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 0);
 	Puck* p = NULL;
 	int lastId = -1;
 
 	logMessage("ProductManager::%s()") % __func__;
 
-	logMessage("  Pucks:");
+	// Ask every ID at once, so absent IDs share a single timeout.
+	std::vector<int> ids;
 	for (int id = Puck::MIN_ID; id <= Puck::MAX_ID; ++id) {
-		ret = Puck::tryGetProperty(*bus, id, propId, &result);
-		p = getPuck(id);
+		ids.push_back(id);
+	}
+	std::vector<int> stats;
+	std::vector<int> rets = Puck::tryGetProperty(*bus, ids, propId, &stats, ENUMERATION_TIMEOUT);
 
-		if (ret == 0) {
+	std::vector<Puck*> found;
+	for (size_t i = 0; i < ids.size(); ++i) {
+		p = getPuck(ids[i]);
+
+		if (rets[i] == 0) {
 			// if the Puck doesn't exist, make it
 			if (p == NULL) {
-				p = new Puck(*bus, id);
+				p = new Puck(*bus, ids[i], false);
 				pucks.push_back(p);
-			} else {
-				// if the Puck already exists (from a previous enumeration), update it
-				p->updateRole();
-				p->updateStatus();
-			}
-
-			if (lastId != id - 1  &&  lastId != -1) {
-				logMessage("    --");  // marker to indicate that the listed IDs are not contiguous
 			}
-			logMessage("    ID=%2d VERS=%3d ROLE=0x%04x TYPE=%s%s")
-					% p->getId() % p->getVers() % p->getRole()
-					% Puck::getPuckTypeStr(p->getType())
-					% ((p->getEffectiveType() == Puck::PT_Monitor) ? " (Monitor)" : "");
-			lastId = id;
+			found.push_back(p);
 		} else if (p != NULL) {
 			// if the Puck has disappeared since the last enumeration, remove it
 			deletePuck(p);
 		}
 	}
 
+	// New Pucks need their role and status, and those from a previous
+	// enumeration need updating. Either way, query them all together. Pucks
+	// that are in the cache only need their fingerprint and status.
+	puckCache->validate(found);
+	Puck::updateRoleAndStatus(found);
+	puckCache->save();
+
+	logMessage("  Pucks:");
+	for (size_t i = 0; i < found.size(); ++i) {
+		p = found[i];
+		if (lastId != p->getId() - 1  &&  lastId != -1) {
+			logMessage("    --");  // marker to indicate that the listed IDs are not contiguous
+		}
+		logMessage("    ID=%2d VERS=%3d ROLE=0x%04x TYPE=%s%s")
+				% p->getId() % p->getVers() % p->getRole()
+				% Puck::getPuckTypeStr(p->getType())
+				% ((p->getEffectiveType() == Puck::PT_Monitor) ? " (Monitor)" : "");
+		lastId = p->getId();
+	}
+
 
 	// update WAM/Hand Pucks
 	for (size_t i = 0; i < MAX_WAM_DOF; ++i) {
@@ -266,15 +288,27 @@ void ProductManager::cleanUpAfterEstop()
 }
 void ProductManager::destroyEstopProducts()
 {
-	delete rtem;
-	rtem = NULL;
+	if (deleteRtem) {
+		delete rtem;
+		rtem = NULL;
+	}
 	// TODO(JH): Rehab Update implement and test
-	delete wam3;
+	systems::Wam<3>* oldWam3 = wam3;
+	systems::Wam<4>* oldWam4 = wam4;
+	systems::Wam<7>* oldWam7 = wam7;
+	// A shared execution manager may still be calling requestWamUpdate().
+	if (rtem != NULL) {
+		rtem->getMutex().lock();
+	}
 	wam3 = NULL;
-	delete wam4;
 	wam4 = NULL;
-	delete wam7;
 	wam7 = NULL;
+	if (rtem != NULL) {
+		rtem->getMutex().unlock();
+	}
+	delete oldWam3;
+	delete oldWam4;
+	delete oldWam7;
 	delete fts;
 	fts = NULL;
 	delete hand;
@@ -326,8 +360,10 @@ bool ProductManager::wam7FoundHelper(int poles) const
 {
 	if (foundWam7()) {
 		Puck* p7 = getPuck(7);
-		p7->wake();
-		return p7->getProperty(Puck::POLES) == poles;
+		if ( !p7->isPropertyCached(Puck::POLES) ) {
+			p7->wake();
+		}
+		return p7->getCachedProperty(Puck::POLES) == poles;
 	} else {
 		return false;
 	}
@@ -388,7 +424,9 @@ systems::Wam<3>* ProductManager::getWam3(bool waitForShiftActivate, const char*
 			configPath = getWamDefaultConfigPath();
 		}
 		try {
-			wam3 = new systems::Wam<3>(getExecutionManager(), wam3Pucks, getSafetyModule(), getConfig().lookup(configPath));
+			systems::Wam<3>* newWam = new systems::Wam<3>(getExecutionManager(), wam3Pucks, getSafetyModule(), getConfig().lookup(configPath));
+			BARRETT_SCOPED_LOCK(rtem->getMutex());  // requestWamUpdate() reads wam3 from the execution cycle
+			wam3 = newWam;
 		} catch (libconfig::FileIOException e) {
 			printf("\n>>> CONFIG FILE ERROR in %s: I/O while reading file\n\n", configPath);
 			printf("Check your configuration file directory to ensure that the proper configuration files are installed.\n");
@@ -437,7 +475,9 @@ systems::Wam<4>* ProductManager::getWam4(bool waitForShiftActivate, const char*
 			configPath = getWamDefaultConfigPath();
 		}
 		try {
-			wam4 = new systems::Wam<4>(getExecutionManager(), wam4Pucks, getSafetyModule(), getConfig().lookup(configPath));
+			systems::Wam<4>* newWam = new systems::Wam<4>(getExecutionManager(), wam4Pucks, getSafetyModule(), getConfig().lookup(configPath));
+			BARRETT_SCOPED_LOCK(rtem->getMutex());  // requestWamUpdate() reads wam4 from the execution cycle
+			wam4 = newWam;
 		} catch (libconfig::FileIOException e) {
 			printf("\n>>> CONFIG FILE ERROR in %s: I/O while reading file\n\n", configPath);
 			printf("Check your configuration file directory to ensure that the proper configuration files are installed.\n");
@@ -487,7 +527,9 @@ systems::Wam<7>* ProductManager::getWam7(bool waitForShiftActivate, const char*
 			configPath = getWamDefaultConfigPath();
 		}
 		try {
-			wam7 = new systems::Wam<7>(getExecutionManager(), wam7Pucks, getSafetyModule(), getConfig().lookup(configPath));
+			systems::Wam<7>* newWam = new systems::Wam<7>(getExecutionManager(), wam7Pucks, getSafetyModule(), getConfig().lookup(configPath));
+			BARRETT_SCOPED_LOCK(rtem->getMutex());  // requestWamUpdate() reads wam7 from the execution cycle
+			wam7 = newWam;
 		} catch (libconfig::FileIOException e) {
 			printf("\n>>> CONFIG FILE ERROR in %s: I/O while reading file\n\n", configPath);
 			printf("Check your configuration file directory to ensure that the proper configuration files are installed.\n");
@@ -530,6 +572,26 @@ systems::RealTimeExecutionManager* ProductManager::getExecutionManager(double pe
 	}
 	return rtem;
 }
+void ProductManager::setExecutionManager(systems::RealTimeExecutionManager* em)
+{
+	if (rtem != NULL) {
+		(logMessage("ProductManager::%s(): The execution manager has already been created.") % __func__).raise<std::logic_error>();
+	}
+	rtem = em;
+	deleteRtem = false;
+}
+void ProductManager::requestWamUpdate()
+{
+	if (wam3 != NULL) {
+		wam3->getLowLevelWam().requestUpdate();
+	}
+	if (wam4 != NULL) {
+		wam4->getLowLevelWam().requestUpdate();
+	}
+	if (wam7 != NULL) {
+		wam7->getLowLevelWam().requestUpdate();
+	}
+}
 void ProductManager::startExecutionManager() {
 	getExecutionManager();
 	if ( !rtem->isRunning() ) {
@@ -31,6 +31,7 @@
  *      Author: dc
  */
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -38,20 +39,24 @@
 #include <barrett/bus/abstract/communications_bus.h>
 #include <barrett/products/puck.h>
 #include <barrett/products/puck_group.h>
+#include <barrett/products/puck_cache.h>
 
 
 namespace barrett {
 
 
-Puck::Puck(const bus::CommunicationsBus& _bus, int _id) :
-	bus(_bus), id(_id), vers(-1), role(-1), type(PT_Unknown), effectiveType(PT_Unknown)
+Puck::Puck(const bus::CommunicationsBus& _bus, int _id, bool update) :
+	bus(_bus), id(_id), vers(-1), role(-1), type(PT_Unknown), effectiveType(PT_Unknown),
+	cache(NULL)
 {
 	if ((id & NODE_ID_MASK) != id) {
 		throw std::invalid_argument("Puck::Puck(): Invalid Node ID.");
 	}
 
-	updateRole();
-	updateStatus();
+	if (update) {
+		updateRole();
+		updateStatus();
+	}
 }
 
 Puck::~Puck()
@@ -80,7 +85,83 @@ void Puck::resetProperty(enum Property prop) const
 
 void Puck::updateRole()
 {
-	role = getProperty(ROLE);
+	setRole(getProperty(ROLE));
+}
+
+void Puck::updateStatus()
+{
+	vers = getProperty(VERS);
+	setStat(getProperty(STAT));
+}
+
+int Puck::getCachedProperty(enum Property prop) const
+{
+	int value;
+	if (cache != NULL  &&  cache->getProperty(id, prop, &value)) {
+		return value;
+	}
+
+	value = getProperty(prop);
+	if (cache != NULL) {
+		cache->setProperty(id, prop, value);
+		cache->save();
+	}
+	return value;
+}
+
+bool Puck::isPropertyCached(enum Property prop) const
+{
+	return cache != NULL  &&  cache->hasProperty(id, prop);
+}
+
+void Puck::updateRoleAndStatus(const std::vector<Puck*>& pucks)
+{
+	// Same sequence as updateRole() and updateStatus(): each request depends
+	// on the results of the previous ones.
+	std::vector<Puck*> uncached;
+	for (size_t i = 0; i < pucks.size(); ++i) {
+		Puck* p = pucks[i];
+		int cachedRole, cachedVers;
+		if (p->cache != NULL  &&  p->cache->getProperty(p->id, ROLE, &cachedRole)  &&
+				p->cache->getProperty(p->id, VERS, &cachedVers)) {
+			p->setRole(cachedRole);
+			p->vers = cachedVers;
+		} else {
+			uncached.push_back(p);
+		}
+	}
+
+	std::vector<int> results;
+	getPropertyFromAll(uncached, ROLE, &results);
+	for (size_t i = 0; i < uncached.size(); ++i) {
+		uncached[i]->setRole(results[i]);
+	}
+
+	getPropertyFromAll(uncached, VERS, &results);
+	for (size_t i = 0; i < uncached.size(); ++i) {
+		Puck* p = uncached[i];
+		p->vers = results[i];
+		if (p->cache != NULL) {
+			p->cache->setProperty(p->id, ROLE, p->role);
+			p->cache->setProperty(p->id, VERS, p->vers);
+		}
+	}
+
+	for (size_t i = 0; i < uncached.size(); ++i) {
+		if (uncached[i]->cache != NULL) {
+			uncached[i]->cache->save();
+		}
+	}
+
+	getPropertyFromAll(pucks, STAT, &results);
+	for (size_t i = 0; i < pucks.size(); ++i) {
+		pucks[i]->setStat(results[i]);
+	}
+}
+
+void Puck::setRole(int newRole)
+{
+	role = newRole;
 	switch (role & ROLE_MASK) {
 	case ROLE_SAFETY:
 		type = PT_Safety;
@@ -99,10 +180,8 @@ void Puck::updateRole()
 	}
 }
 
-void Puck::updateStatus()
+void Puck::setStat(int stat)
 {
-	vers = getProperty(VERS);
-	int stat = getProperty(STAT);
 	switch (stat) {
 	case STATUS_RESET:
 		effectiveType = PT_Monitor;
@@ -197,6 +276,88 @@ void Puck::wake(std::vector<Puck*> pucks)
 }
 
 
+std::vector<int> Puck::tryGetProperty(const bus::CommunicationsBus& bus,
+		const std::vector<int>& ids, int propId, std::vector<int>* results,
+		double timeout_s)
+{
+	BARRETT_SCOPED_LOCK(bus.getMutex());
+
+	std::vector<int> rets(ids.size());
+	results->resize(ids.size());
+
+	// Send in batches that fit in the CAN driver's transmit queue, giving the
+	// queue time to drain in between. Replies wait in the bus's receive buffers
+	// until they are collected, so every batch shares the same timeout.
+	for (size_t start = 0; start < ids.size(); start += MAX_OUTSTANDING_REQUESTS) {
+		const size_t end = std::min(ids.size(), start + MAX_OUTSTANDING_REQUESTS);
+
+		if (start != 0) {
+			btsleepRT(TX_QUEUE_DRAIN_TIME);
+		}
+		for (size_t i = start; i < end; ++i) {
+			int ret = sendGetPropertyRequest(bus, ids[i], propId);
+			if (ret != 0) {
+				(logMessage("Puck::%s(): Failed to send request. "
+						"Puck::sendGetPropertyRequest() returned error %d.")
+						% __func__ % ret).raise<std::runtime_error>();
+			}
+		}
+	}
+
+	if (timeout_s != 0.0) {
+		btsleepRT(timeout_s);
+	}
+
+	// Each Puck replies with its own bus ID, so the replies can be collected
+	// in any order.
+	for (size_t i = 0; i < ids.size(); ++i) {
+		rets[i] = receiveGetPropertyReply(bus, ids[i], propId, &(*results)[i], false, false);
+		if (rets[i] != 0  &&  rets[i] != 1) {  // some error other than "would block" occurred
+			(logMessage("Puck::%s(): Receive error. "
+					"Puck::receiveGetPropertyReply() returned error %d.")
+					% __func__ % rets[i]).raise<std::runtime_error>();
+		}
+	}
+	return rets;
+}
+
+void Puck::getPropertyFromAll(const std::vector<Puck*>& pucks, enum Property prop,
+		std::vector<int>* results)
+{
+	results->resize(pucks.size());
+	if (pucks.empty()) {
+		return;
+	}
+
+	const bus::CommunicationsBus& bus = pucks[0]->getBus();
+	BARRETT_SCOPED_LOCK(bus.getMutex());
+
+	std::vector<int> propIds(pucks.size());
+	for (size_t start = 0; start < pucks.size(); start += MAX_OUTSTANDING_REQUESTS) {
+		const size_t end = std::min(pucks.size(), start + MAX_OUTSTANDING_REQUESTS);
+
+		for (size_t i = start; i < end; ++i) {
+			propIds[i] = pucks[i]->getPropertyId(prop);
+			int ret = sendGetPropertyRequest(bus, pucks[i]->getId(), propIds[i]);
+			if (ret != 0) {
+				(logMessage("Puck::%s(): Failed to send request. "
+						"Puck::sendGetPropertyRequest() returned error %d.")
+						% __func__ % ret).raise<std::runtime_error>();
+			}
+		}
+
+		for (size_t i = start; i < end; ++i) {
+			int ret = receiveGetPropertyReply(bus, pucks[i]->getId(), propIds[i], &(*results)[i], true, false);
+			if (ret != 0) {
+				(logMessage("Puck::%s(): Failed to receive reply. "
+						"Puck::receiveGetPropertyReply() returned error %d.")
+						% __func__ % ret).raise<std::runtime_error>();
+			}
+		}
+	}
+}
+
+
 int Puck::StandardParser::parse(int id,
 		int propId, result_type* result, const unsigned char* data, size_t len)
 {
@@ -0,0 +1,247 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file puck_cache.cpp
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/bus/abstract/communications_bus.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_cache.h>
+
+
+namespace barrett {
+
+
+PuckCache::PuckCache(const std::string& fileName_) :
+	fileName(fileName_), entries(), changed(false)
+{
+	if ( !fileName.empty() ) {
+		load();
+	}
+}
+
+PuckCache::~PuckCache()
+{
+}
+
+void PuckCache::validate(const std::vector<Puck*>& pucks)
+{
+	if (pucks.empty()) {
+		return;
+	}
+
+	// SN and VERS have the same ID in every property list.
+	const int snId = Puck::getPropertyId(Puck::SN, Puck::PT_Unknown, -1);
+	const int versId = Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1);
+	std::vector<int> sns(pucks.size()), verses(pucks.size());
+
+	{
+		const bus::CommunicationsBus& bus = pucks[0]->getBus();
+		BARRETT_SCOPED_LOCK(bus.getMutex());
+
+		// Two requests per Puck. Send them in batches that fit in the CAN
+		// driver's transmit queue.
+		const size_t batchSize = Puck::MAX_OUTSTANDING_REQUESTS / 2;
+		for (size_t start = 0; start < pucks.size(); start += batchSize) {
+			const size_t end = std::min(pucks.size(), start + batchSize);
+
+			for (size_t i = start; i < end; ++i) {
+				int ret = Puck::sendGetPropertyRequest(bus, pucks[i]->getId(), snId);
+				if (ret == 0) {
+					ret = Puck::sendGetPropertyRequest(bus, pucks[i]->getId(), versId);
+				}
+				if (ret != 0) {
+					(logMessage("PuckCache::%s(): Failed to send request. "
+							"Puck::sendGetPropertyRequest() returned error %d.")
+							% __func__ % ret).raise<std::runtime_error>();
+				}
+			}
+
+			for (size_t i = start; i < end; ++i) {
+				int ret = Puck::receiveGetPropertyReply(bus, pucks[i]->getId(), snId, &sns[i], true, false);
+				if (ret == 0) {
+					ret = Puck::receiveGetPropertyReply(bus, pucks[i]->getId(), versId, &verses[i], true, false);
+				}
+				if (ret != 0) {
+					(logMessage("PuckCache::%s(): Failed to receive reply. "
+							"Puck::receiveGetPropertyReply() returned error %d.")
+							% __func__ % ret).raise<std::runtime_error>();
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < pucks.size(); ++i) {
+		int id = pucks[i]->getId();
+		std::map<int, Entry>::iterator e = entries.find(id);
+		if (e == entries.end()  ||  e->second.sn != sns[i]  ||  e->second.props[Puck::VERS] != verses[i]) {
+			if (e != entries.end()) {
+				logMessage("PuckCache::%s(): Puck %d has changed; discarding its entry") % __func__ % id;
+			}
+
+			Entry& entry = entries[id];
+			entry.sn = sns[i];
+			entry.props.clear();
+			entry.props[Puck::VERS] = verses[i];
+			changed = true;
+		}
+
+		pucks[i]->setCache(this);
+	}
+}
+
+bool PuckCache::hasProperty(int id, enum Puck::Property prop) const
+{
+	std::map<int, Entry>::const_iterator e = entries.find(id);
+	return e != entries.end()  &&  e->second.props.count(prop) != 0;
+}
+
+bool PuckCache::getProperty(int id, enum Puck::Property prop, int* value) const
+{
+	std::map<int, Entry>::const_iterator e = entries.find(id);
+	if (e == entries.end()) {
+		return false;
+	}
+
+	std::map<enum Puck::Property, int>::const_iterator p = e->second.props.find(prop);
+	if (p == e->second.props.end()) {
+		return false;
+	}
+	*value = p->second;
+	return true;
+}
+
+void PuckCache::setProperty(int id, enum Puck::Property prop, int value)
+{
+	std::map<int, Entry>::iterator e = entries.find(id);
+	if (e == entries.end()) {
+		return;
+	}
+
+	std::map<enum Puck::Property, int>::iterator p = e->second.props.find(prop);
+	if (p == e->second.props.end()  ||  p->second != value) {
+		e->second.props[prop] = value;
+		changed = true;
+	}
+}
+
+void PuckCache::clear()
+{
+	if ( !entries.empty() ) {
+		entries.clear();
+		changed = true;
+	}
+}
+
+void PuckCache::save()
+{
+	if (fileName.empty()  ||  !changed) {
+		return;
+	}
+
+	// Write a temporary file and rename it, so a crash can't leave a partial file behind.
+	std::string tmpFileName = fileName + ".tmp";
+	std::ofstream file(tmpFileName.c_str());
+	file << "# Puck properties cached by libbarrett. Safe to delete.\n";
+	for (std::map<int, Entry>::const_iterator e = entries.begin(); e != entries.end(); ++e) {
+		file << e->first << " " << e->second.sn << " " << e->second.props.find(Puck::VERS)->second;
+		std::map<enum Puck::Property, int>::const_iterator p;
+		for (p = e->second.props.begin(); p != e->second.props.end(); ++p) {
+			if (p->first != Puck::VERS) {
+				file << " " << Puck::getPropertyStr(p->first) << "=" << p->second;
+			}
+		}
+		file << "\n";
+	}
+	file.close();
+
+	if ( !file  ||  std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+		logMessage("PuckCache::%s(): Couldn't write \"%s\"") % __func__ % fileName;
+		std::remove(tmpFileName.c_str());
+		return;
+	}
+	changed = false;
+}
+
+void PuckCache::load()
+{
+	std::ifstream file(fileName.c_str());
+	if ( !file ) {
+		return;  // Nothing cached yet
+	}
+
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty()  ||  line[0] == '#') {
+			continue;
+		}
+
+		std::istringstream iss(line);
+		int id, vers;
+		Entry entry;
+		if ( !(iss >> id >> entry.sn >> vers) ) {
+			logMessage("PuckCache::%s(): Ignoring bad line in \"%s\": \"%s\"") % __func__ % fileName % line;
+			continue;
+		}
+		entry.props[Puck::VERS] = vers;
+
+		std::string item;
+		bool ok = true;
+		while (iss >> item) {
+			size_t eq = item.find('=');
+			enum Puck::Property prop = Puck::getPropertyEnumNoThrow(item.substr(0, eq).c_str());
+			std::istringstream valueStream(item.substr(eq == std::string::npos ? item.size() : eq + 1));
+			int value;
+			if (eq == std::string::npos  ||  (int) prop == -1  ||  !(valueStream >> value)) {
+				ok = false;
+				break;
+			}
+			entry.props[prop] = value;
+		}
+		if ( !ok ) {
+			logMessage("PuckCache::%s(): Ignoring bad line in \"%s\": \"%s\"") % __func__ % fileName % line;
+			continue;
+		}
+
+		entries[id] = entry;
+	}
+}
+
+
+}
@@ -49,7 +49,7 @@ namespace barrett {
 
 
 SafetyModule::SafetyModule(Puck* puck) :
-	SpecialPuck(Puck::PT_Safety)
+	SpecialPuck(Puck::PT_Safety), stateSource(NULL)
 {
 	setPuck(puck);
 
@@ -59,6 +59,12 @@ SafetyModule::SafetyModule(Puck* puck) :
 }
 
 enum SafetyModule::SafetyMode SafetyModule::getMode(bool realtime) const {
+	const StateSource* source = getStateSource();
+	enum SafetyMode sourceMode;
+	if (source != NULL  &&  source->getMode(&sourceMode)) {
+		return sourceMode;
+	}
+
 	int mode = p->getProperty(Puck::MODE, realtime);
 	if (mode < 0  ||  mode > 2) {
 		(logMessage("SafetyModule::%s(): Bad MODE value. "
@@ -131,11 +137,25 @@ void SafetyModule::setVelocityLimit(double fault, double warning)
 }
 
 void SafetyModule::getPendantState(PendantState* ps, bool realtime) const
+{
+	assert(ps != NULL);
+	const StateSource* source = getStateSource();
+	if (source != NULL  &&  source->getPendantState(ps)) {
+		return;
+	}
+
+	int pen = p->getProperty(Puck::PEN, realtime);
+	if ( !decodePendantState(pen, ps) ) {
+		(logMessage("SafetyModule::%s(): Bad PEN value: %s")
+				% __func__ % std::bitset<32>(pen).to_string()).raise<std::runtime_error>();
+	}
+}
+
+bool SafetyModule::decodePendantState(int pen, PendantState* ps)
 {
 	typedef const std::bitset<32> bits_type;
 
 	assert(ps != NULL);
-	int pen = p->getProperty(Puck::PEN);
 	bits_type bits(pen);
 
 	if (bits[27]) {
@@ -159,8 +179,7 @@ void SafetyModule::getPendantState(PendantState* ps, bool realtime) const
 	for (int i = 0; i < PendantState::NUM_PARAMS; ++i) {
 		bits_type paramBits((pen >> (3 * i)) & 0x7);  // Select three bits...
 		if (paramBits.count() != 1) {  // exactly one of which should be set.
-			(logMessage("SafetyModule::%s(): Bad PEN value for Parameter %d: %s")
-					% __func__ % i % bits.to_string()).raise<std::runtime_error>();
+			return false;
 		}
 
 		if (paramBits[0]) {
@@ -171,6 +190,8 @@ void SafetyModule::getPendantState(PendantState* ps, bool realtime) const
 			ps->safetyParameters[i] = PendantState::FAULT;
 		}
 	}
+
+	return true;
 }
 
 
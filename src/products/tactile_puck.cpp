@@ -158,26 +158,19 @@ int TactilePuck::Top10TactParser::parse(int id, int propId, result_type* result,
 	// Sensors 1, 2, 8, 10, 12, 13, 14, 20, 21, and 24 are reporting the highest pressures. 
 	// The pressures are, respectively: 6, 4, 5, 14, 7, 7, 11, 6, 9, 3 (N/cm2)
 	
-	// I don't know how "data" is aligned, so align the data properly here...
-	uint64_t dat = 0; // No initialization required, but compiler complains otherwise
-	for(size_t i = 0; i < sizeof(uint64_t); i++){
-		dat <<= 8;
-		dat |= data[i];
-	}
-	
-	uint32_t map = dat >> 40; // Pick off the top 3 bytes
-	uint8_t *byte = (uint8_t*)&dat + 4; // Pointer to the AAAABBBB byte of dat
-	
-	// Now rotate through the map and shift out each non-zero value from the packed data
-	// Note: result is a math::Vector[24]
-	for(size_t i = 0; i < NUM_SENSORS; i++){
-		if(map & 1){
-			(*result)[i] = (*byte & 0xF0) >> 4; // 4-bit N/cm2 (0-15)
-			dat <<= 4;
-		}else{
-			(*result)[i] = 0; // No data returned for this cell, set to zero
-		}
-		map >>= 1;
+	// The map of reporting sensors, sensor 1 in the least significant bit
+	uint32_t map = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | (uint32_t)data[2];
+
+	// Visit only the set bits of the map, taking the 4-bit pressures (0-15
+	// N/cm2) from the packed data in order. Works regardless of host byte order.
+	result->setZero();
+	size_t n = 0;
+	while (map != 0  &&  n < 10) {
+		size_t i = __builtin_ctz(map);  // Index of the lowest set bit
+		(*result)[i] = (data[3 + n/2] >> ((n % 2) ? 0 : 4)) & 0x0F;
+
+		map &= map - 1;  // Clear it
+		++n;
 	}
 
     return 0;
@@ -0,0 +1,228 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file force_torque_source.cpp
+ * @date 10/19/2026
+ *
+ */
+
+#include <cassert>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/products/force_torque_sensor.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/force_torque_source.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+ForceTorqueSource::ForceTorqueSource(ExecutionManager* em, ForceTorqueSensor* fts_,
+		double omega_p, const std::string& sysName) :
+	ForceTorqueSource(NULL, omega_p, sysName)
+{
+	if (fts_ == NULL) {
+		(logMessage("systems::ForceTorqueSource::%s(): fts must not be NULL.")
+				% __func__).raise<std::invalid_argument>();
+	}
+	fts = fts_;
+
+	// Only once fts is set, so operate() can't run without it.
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+ForceTorqueSource::ForceTorqueSource(ExecutionManager* em, double omega_p_, const std::string& sysName) :
+	System(sysName), toolOrientationInput(this),
+	forceOutput(this, &forceOutputValue), torqueOutput(this, &torqueOutputValue),
+	fts(NULL), T_s(0.0), omega_p(omega_p_), toolMass(0.0), toolCenterOfMass(0.0),
+	tarePending(false), forceBias(0.0), torqueBias(0.0),
+	requested(false), sampleDefined(false), missedCycles(0), missedSampleCount(0),
+	rawForce(0.0), force(0.0), toolWeight(0.0), rawTorque(0.0), torque(0.0)
+{
+	if (omega_p < 0.0) {
+		(logMessage("systems::ForceTorqueSource::%s(): omega_p must be non-negative (got %f).")
+				% __func__ % omega_p).raise<std::invalid_argument>();
+	}
+
+	// The sensor must be read every execution cycle, whether or not the data is used.
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+
+	getSamplePeriodFromEM();
+}
+
+ForceTorqueSource::~ForceTorqueSource()
+{
+	mandatoryCleanUp();
+}
+
+void ForceTorqueSource::tare()
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	tarePending = true;
+}
+
+void ForceTorqueSource::clearTare()
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	tarePending = false;
+	forceBias.setZero();
+	torqueBias.setZero();
+}
+
+void ForceTorqueSource::setLowPass(double omega_p_)
+{
+	if (omega_p_ < 0.0) {
+		(logMessage("systems::ForceTorqueSource::%s(): omega_p must be non-negative (got %f).")
+				% __func__ % omega_p_).raise<std::invalid_argument>();
+	}
+
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	omega_p = omega_p_;
+	updateFilters();
+}
+
+void ForceTorqueSource::setToolMass(double mass, const cp_type& centerOfMass)
+{
+	if (mass < 0.0) {
+		(logMessage("systems::ForceTorqueSource::%s(): mass must be non-negative (got %f).")
+				% __func__ % mass).raise<std::invalid_argument>();
+	}
+
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	toolMass = mass;
+	toolCenterOfMass = centerOfMass;
+}
+
+
+void ForceTorqueSource::onExecutionManagerChanged()
+{
+	System::onExecutionManagerChanged();  // First, call super
+	getSamplePeriodFromEM();
+}
+
+void ForceTorqueSource::getSamplePeriodFromEM()
+{
+	if (this->hasExecutionManager()) {
+		assert(this->getExecutionManager()->getPeriod() > 0.0);
+		T_s = this->getExecutionManager()->getPeriod();
+	} else {
+		T_s = 0.0;
+	}
+	updateFilters();
+}
+
+void ForceTorqueSource::updateFilters()
+{
+	forceFilter.setSamplePeriod(T_s);
+	forceFilter.setLowPass(cf_type(omega_p));
+	torqueFilter.setSamplePeriod(T_s);
+	torqueFilter.setLowPass(ct_type(omega_p));
+}
+
+
+void ForceTorqueSource::operate()
+{
+	// Collect last cycle's sample, then ask for the next one.
+	if (requested) {
+		if (collectSample(&rawForce, &rawTorque)) {
+			requested = false;
+			sampleDefined = true;
+			missedCycles = 0;
+		} else {
+			++missedSampleCount;
+			if (++missedCycles >= MAX_MISSED_CYCLES) {
+				cancelSample();  // Give up on it
+				requested = false;
+				missedCycles = 0;
+			}
+		}
+	}
+	if ( !requested ) {
+		requestSample();
+		requested = true;
+	}
+
+	if ( !sampleDefined ) {
+		return;
+	}
+
+
+	force = rawForce;
+	torque = rawTorque;
+
+	if (toolMass != 0.0  &&  toolOrientationInput.valueDefined()) {
+		toolWeight = toolOrientationInput.getValue() * Eigen::Vector3d(0.0, 0.0, -toolMass * GRAVITY);
+		force -= toolWeight;
+		torque -= toolCenterOfMass.cross(toolWeight);
+	}
+
+	if (tarePending) {
+		forceBias = force;
+		torqueBias = torque;
+		tarePending = false;
+	}
+	force -= forceBias;
+	torque -= torqueBias;
+
+	if (omega_p != 0.0  &&  T_s != 0.0) {
+		force = forceFilter.eval(force);
+		torque = torqueFilter.eval(torque);
+	}
+
+	forceOutputValue->setData(&force);
+	torqueOutputValue->setData(&torque);
+}
+
+void ForceTorqueSource::requestSample()
+{
+	fts->requestUpdate();
+}
+
+bool ForceTorqueSource::collectSample(cf_type* force, ct_type* torque)
+{
+	if ( !fts->receiveUpdate(false, true) ) {
+		return false;
+	}
+
+	*force = fts->getForce();
+	*torque = fts->getTorque();
+	return true;
+}
+
+void ForceTorqueSource::cancelSample()
+{
+	fts->cancelUpdate(true);
+}
+
+
+}
+}
@@ -0,0 +1,346 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file hand_sensors.cpp
+ * @date 10/19/2026
+ *
+ */
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/products/hand.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/motor_puck.h>
+#include <barrett/products/puck_group.h>
+#include <barrett/products/tactile_puck.h>
+#include <barrett/systems/hand_sensors.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+HandSensors::Snapshot::Snapshot() :
+	innerJp(0.0), outerJp(0.0), fingertipTorque(0.0), tactile(0.0),
+	positionTime(0.0), fingertipTorqueTime(0.0), tactileTime(0.0)
+{
+}
+
+
+HandSensors::HandSensors(ExecutionManager* em, Hand* hand_,
+		size_t maxReadsPerCycle_, const std::string& sysName) :
+	System(sysName),
+	innerJpOutput(this, &innerJpOutputValue), outerJpOutput(this, &outerJpOutputValue),
+	fingertipTorqueOutput(this, &fingertipTorqueOutputValue), tactileOutput(this, &tactileOutputValue),
+	hand(hand_), maxReadsPerCycle(maxReadsPerCycle_)
+{
+	if (hand == NULL) {
+		(logMessage("systems::HandSensors::%s(): hand must not be NULL.")
+				% __func__).raise<std::invalid_argument>();
+	}
+	init(hand->hasFingertipTorqueSensors(), hand->hasTactSensors() ? hand->getTactilePucks().size() : 0);
+
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+HandSensors::HandSensors(ExecutionManager* em, bool hasFingertipTorqueSensors,
+		size_t numTactilePucks, size_t maxReadsPerCycle_, const std::string& sysName) :
+	System(sysName),
+	innerJpOutput(this, &innerJpOutputValue), outerJpOutput(this, &outerJpOutputValue),
+	fingertipTorqueOutput(this, &fingertipTorqueOutputValue), tactileOutput(this, &tactileOutputValue),
+	hand(NULL), maxReadsPerCycle(maxReadsPerCycle_)
+{
+	init(hasFingertipTorqueSensors, numTactilePucks);
+
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+HandSensors::~HandSensors()
+{
+	mandatoryCleanUp();
+}
+
+void HandSensors::init(bool hasFingertipTorqueSensors, size_t numTactilePucks)
+{
+	if (maxReadsPerCycle == 0) {
+		(logMessage("systems::HandSensors::%s(): maxReadsPerCycle must be at least 1.")
+				% __func__).raise<std::invalid_argument>();
+	}
+	if (numTactilePucks > Hand::DOF) {
+		(logMessage("systems::HandSensors::%s(): Too many TactilePucks (%d).")
+				% __func__ % numTactilePucks).raise<std::invalid_argument>();
+	}
+
+	T_s = 0.0;
+	for (size_t s = 0; s < NUM_SENSORS; ++s) {
+		rates[s] = 0.0;
+		nextDue[s] = 0;
+	}
+	cycle = 0;
+	overrunCount = 0;
+
+	// Interleave the sensors, so a sensor's reads are spread out when several come due together.
+	numReads = 0;
+	addRead(POSITION, 0);
+	if (hasFingertipTorqueSensors) {
+		addRead(FINGERTIP_TORQUE, 0);
+	}
+	for (size_t i = 0; i < numTactilePucks; ++i) {
+		addRead(TACT_TOP10, i);
+		addRead(TACT_FULL, i);
+	}
+	nextRead = 0;
+
+	hasPosition = hasFingertipTorque = hasTactile = false;
+	tactileTmp.setZero();
+
+	getSamplePeriodFromEM();
+}
+
+void HandSensors::addRead(enum Sensor sensor, size_t i)
+{
+	assert(numReads < MAX_READS);
+	readSensor[numReads] = sensor;
+	readIndex[numReads] = i;
+	pending[numReads] = false;
+	++numReads;
+}
+
+
+void HandSensors::setRate(unsigned int sensors, double rate)
+{
+	if (rate < 0.0) {
+		(logMessage("systems::HandSensors::%s(): rate must not be negative (got %f).")
+				% __func__ % rate).raise<std::invalid_argument>();
+	}
+
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	for (size_t s = 0; s < NUM_SENSORS; ++s) {
+		if (sensors & (1 << s)) {
+			rates[s] = rate;
+			nextDue[s] = cycle;  // Read as soon as possible
+		}
+	}
+}
+
+double HandSensors::getRate(unsigned int sensor) const
+{
+	for (size_t s = 0; s < NUM_SENSORS; ++s) {
+		if (sensor == (1u << s)) {
+			return rates[s];
+		}
+	}
+
+	(logMessage("systems::HandSensors::%s(): sensor must be a single Hand::S_* flag (got %d).")
+			% __func__ % sensor).raise<std::invalid_argument>();
+	return 0.0;
+}
+
+void HandSensors::setMaxReadsPerCycle(size_t newMaxReadsPerCycle)
+{
+	if (newMaxReadsPerCycle == 0) {
+		(logMessage("systems::HandSensors::%s(): maxReadsPerCycle must be at least 1.")
+				% __func__).raise<std::invalid_argument>();
+	}
+
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	maxReadsPerCycle = newMaxReadsPerCycle;
+}
+
+bool HandSensors::getSnapshot(Snapshot* snapshot) const
+{
+	if ( !snapshotLock.hasBeenWritten() ) {
+		return false;
+	}
+	snapshotLock.read(snapshot);
+	return true;
+}
+
+
+// Hand::update() yields after releasing the bus, which an execution cycle
+// must not do. Read the Pucks directly instead.
+void HandSensors::readPosition(jp_type* innerJp, jp_type* outerJp)
+{
+	PuckGroup::PropertyBatch batch(hand->getPuckGroup());
+	batch.add<MotorPuck::CombinedPositionParser<int> >(Puck::P, encoderTmp);
+	batch.update(true);
+
+	hand->updatePosition(encoderTmp);
+	*innerJp = hand->getInnerLinkPosition();
+	*outerJp = hand->getOuterLinkPosition();
+}
+
+void HandSensors::readFingertipTorque(v_type* fingertipTorque)
+{
+	PuckGroup::PropertyBatch batch(hand->getPuckGroup());
+	batch.add(Puck::SG, fttTmp);
+	batch.update(true);
+
+	for (size_t i = 0; i < Hand::DOF; ++i) {
+		(*fingertipTorque)[i] = fttTmp[i];
+	}
+}
+
+void HandSensors::readTactTop10(size_t i, TactilePuck::v_type* tactile)
+{
+	TactilePuck* tp = hand->getTactilePucks()[i];
+	{
+		BARRETT_SCOPED_LOCK(tp->getPuck()->getBus().getMutex());
+		tp->updateTop10(true);
+	}
+	*tactile = tp->getTactileData();
+}
+
+void HandSensors::readTactFull(size_t i, TactilePuck::v_type* tactile)
+{
+	TactilePuck* tp = hand->getTactilePucks()[i];
+	{
+		BARRETT_SCOPED_LOCK(tp->getPuck()->getBus().getMutex());
+		tp->updateFull(true);
+	}
+	*tactile = tp->getTactileData();
+}
+
+
+void HandSensors::onExecutionManagerChanged()
+{
+	System::onExecutionManagerChanged();  // First, call super
+	getSamplePeriodFromEM();
+}
+
+void HandSensors::operate()
+{
+	// Queue the reads of the sensors that are due.
+	for (size_t s = 0; s < NUM_SENSORS; ++s) {
+		if (rates[s] == 0.0  ||  cycle < nextDue[s]) {
+			continue;
+		}
+
+		bool overrun = false;
+		for (size_t r = 0; r < numReads; ++r) {
+			if (readSensor[r] == (enum Sensor) s) {
+				overrun = overrun  ||  pending[r];
+				pending[r] = true;
+			}
+		}
+		if (overrun) {
+			++overrunCount;
+		}
+
+		long period = 1;
+		if (T_s > 0.0) {
+			period = std::max(1L, static_cast<long>(std::floor(1.0 / (rates[s] * T_s) + 0.5)));
+		}
+		nextDue[s] += period;
+		if (nextDue[s] <= cycle) {
+			nextDue[s] = cycle + period;
+		}
+	}
+	++cycle;
+
+	// Serve them round-robin.
+	size_t count = 0;
+	for (size_t k = 0; k < numReads  &&  count < maxReadsPerCycle; ++k) {
+		size_t r = (nextRead + k) % numReads;
+		if (pending[r]) {
+			read(r);
+			pending[r] = false;
+			++count;
+
+			if (count == maxReadsPerCycle) {
+				nextRead = (r + 1) % numReads;
+			}
+		}
+	}
+
+	if (count != 0) {
+		snapshotLock.write(current);
+	}
+
+	if (hasPosition) {
+		innerJpOutputValue->setData(&current.innerJp);
+		outerJpOutputValue->setData(&current.outerJp);
+	}
+	if (hasFingertipTorque) {
+		fingertipTorqueOutputValue->setData(&current.fingertipTorque);
+	}
+	if (hasTactile) {
+		tactileOutputValue->setData(&current.tactile);
+	}
+}
+
+void HandSensors::read(size_t r)
+{
+	size_t i = readIndex[r];
+	switch (readSensor[r]) {
+	case POSITION:
+		readPosition(&current.innerJp, &current.outerJp);
+		current.positionTime = highResolutionSystemTime();
+		hasPosition = true;
+		break;
+	case FINGERTIP_TORQUE:
+		readFingertipTorque(&current.fingertipTorque);
+		current.fingertipTorqueTime = highResolutionSystemTime();
+		hasFingertipTorque = true;
+		break;
+	case TACT_TOP10:
+		readTactTop10(i, &tactileTmp);
+		current.tactile.row(i) = tactileTmp.transpose();
+		current.tactileTime = highResolutionSystemTime();
+		hasTactile = true;
+		break;
+	case TACT_FULL:
+		readTactFull(i, &tactileTmp);
+		current.tactile.row(i) = tactileTmp.transpose();
+		current.tactileTime = highResolutionSystemTime();
+		hasTactile = true;
+		break;
+	default:
+		break;
+	}
+}
+
+void HandSensors::getSamplePeriodFromEM()
+{
+	if (this->hasExecutionManager()) {
+		assert(this->getExecutionManager()->getPeriod() > 0.0);
+		T_s = this->getExecutionManager()->getPeriod();
+	} else {
+		T_s = 0.0;
+	}
+}
+
+
+}
+}
@@ -0,0 +1,150 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file playback_clock.cpp
+ * @date 10/19/2026
+ *
+ */
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+#include <barrett/math/utils.h>
+#include <barrett/systems/playback_clock.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+PlaybackClock::PlaybackClock(ExecutionManager* em, double maxAcceleration_,
+		double maxJerk_, double maxSpeed_, const std::string& sysName) :
+	System(sysName), SingleOutput<double>(this), speedInput(this),
+	T_s(0.0), maxAcceleration(maxAcceleration_), maxJerk(maxJerk_),
+	maxSpeed(maxSpeed_), running(false), speed(1.0), rate(0.0),
+	acceleration(0.0), y(0.0)
+{
+	assert(maxAcceleration > 0.0);
+	assert(maxJerk > 0.0);
+	assert(maxSpeed >= 0.0);
+
+	// Update every execution cycle so the clock stays current even if the
+	// data isn't used for a time.
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+
+	getSamplePeriodFromEM();
+}
+PlaybackClock::~PlaybackClock() {
+	mandatoryCleanUp();
+}
+
+bool PlaybackClock::isRunning() {
+	return running  ||  rate != 0.0;
+}
+
+void PlaybackClock::start() {
+	// running is read in operate(), so it needs to be locked.
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	running = true;
+}
+void PlaybackClock::stop() {
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	running = false;
+}
+
+void PlaybackClock::reset() {
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	running = false;
+	rate = 0.0;
+	acceleration = 0.0;
+	y = 0.0;
+}
+void PlaybackClock::setOutput(double newOutput) {
+	// y is written and read in operate(), so it needs to be locked.
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	y = newOutput;
+}
+
+void PlaybackClock::setSpeed(double newSpeed) {
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	speed = math::saturate(newSpeed, 0.0, maxSpeed);
+}
+
+
+void PlaybackClock::onExecutionManagerChanged() {
+	System::onExecutionManagerChanged();  // First, call super
+	getSamplePeriodFromEM();
+}
+
+void PlaybackClock::operate() {
+	double target = 0.0;
+	if (running) {
+		target = speedInput.valueDefined() ? speedInput.getValue() : speed;
+		target = math::saturate(target, 0.0, maxSpeed);
+	}
+
+	if (rate != target  ||  acceleration != 0.0) {
+		// Follow the jerk-limited braking curve: the largest acceleration from
+		// which the rate can still settle at target without overshooting. In
+		// discrete time, reducing the acceleration from n*jT to zero in steps
+		// of jT changes the rate by jT^2 * n(n+1)/2.
+		double error = target - rate;
+		double jT = maxJerk * T_s;
+		double braking = (jT == 0.0) ? 0.0 : jT * (std::sqrt(0.25 + 2.0 * std::abs(error) / (jT * T_s)) - 0.5);
+		double desired = math::sign(error) * std::min(braking, maxAcceleration);
+		acceleration += math::saturate(desired - acceleration, jT);
+		rate += T_s * acceleration;
+
+		// Settle once the remaining error is less than one cycle's worth.
+		if (std::abs(target - rate) <= jT * T_s  &&  std::abs(acceleration) <= jT) {
+			rate = target;
+			acceleration = 0.0;
+		} else if (rate < 0.0  ||  rate > maxSpeed) {
+			rate = math::saturate(rate, 0.0, maxSpeed);
+			acceleration = 0.0;
+		}
+	}
+
+	y += T_s * rate;
+	outputValue->setData(&y);
+}
+
+void PlaybackClock::getSamplePeriodFromEM()
+{
+	if (this->hasExecutionManager()) {
+		assert(this->getExecutionManager()->getPeriod() > 0.0);
+		T_s = this->getExecutionManager()->getPeriod();
+	} else {
+		T_s = 0.0;
+	}
+}
+
+
+}
+}
@@ -0,0 +1,345 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file safety_monitor.cpp
+ * @date 10/19/2026
+ *
+ */
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/bus/abstract/communications_bus.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/safety_module.h>
+#include <barrett/systems/safety_monitor.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+SafetyMonitor::Snapshot::Snapshot() :
+	mode(SafetyModule::ESTOP), pendantState(), modeTime(0.0), pendantStateTime(0.0), maxAge(0.0)
+{
+	pendantState.pressedButton = SafetyModule::PendantState::NONE;
+	pendantState.activateLight = false;
+	pendantState.idleLight = false;
+	pendantState.displayedCharacter = ' ';
+	for (int i = 0; i < SafetyModule::PendantState::NUM_PARAMS; ++i) {
+		pendantState.safetyParameters[i] = SafetyModule::PendantState::SAFE;
+	}
+}
+
+
+SafetyMonitor::SafetyMonitor(ExecutionManager* em, SafetyModule* sm, double rate_,
+		const std::string& sysName) :
+	System(sysName), modeOutput(this, &modeOutputValue),
+	safetyModule(sm), puck(NULL), modePropId(-1), penPropId(-1), rate(rate_)
+{
+	if (sm == NULL) {
+		(logMessage("systems::SafetyMonitor::%s(): sm must not be NULL.")
+				% __func__).raise<std::invalid_argument>();
+	}
+	puck = sm->getPuck();
+	modePropId = puck->getPropertyId(Puck::MODE);
+	penPropId = puck->getPropertyId(Puck::PEN);
+	init();
+
+	safetyModule->setStateSource(this);
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+SafetyMonitor::SafetyMonitor(ExecutionManager* em, double rate_, const std::string& sysName) :
+	System(sysName), modeOutput(this, &modeOutputValue),
+	safetyModule(NULL), puck(NULL), modePropId(-1), penPropId(-1), rate(rate_)
+{
+	init();
+
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+SafetyMonitor::~SafetyMonitor()
+{
+	if (safetyModule != NULL  &&  safetyModule->getStateSource() == this) {
+		safetyModule->setStateSource(NULL);
+	}
+	mandatoryCleanUp();
+}
+
+void SafetyMonitor::init()
+{
+	if (rate < 0.0) {
+		(logMessage("systems::SafetyMonitor::%s(): rate must not be negative (got %f).")
+				% __func__ % rate).raise<std::invalid_argument>();
+	}
+
+	T_s = 0.0;
+	nextDue = 0;
+	cycle = 0;
+
+	modePending = penPending = false;
+	missedCycles = 0;
+	errorCount = 0;
+
+	pen = 0;
+	hasMode = hasPendantState = false;
+
+	getSamplePeriodFromEM();
+}
+
+
+void SafetyMonitor::setRate(double newRate)
+{
+	if (newRate < 0.0) {
+		(logMessage("systems::SafetyMonitor::%s(): rate must not be negative (got %f).")
+				% __func__ % newRate).raise<std::invalid_argument>();
+	}
+
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	rate = newRate;
+	nextDue = cycle;  // Read as soon as possible
+}
+
+void SafetyMonitor::setModeChangeCallback(const mode_callback_type& callback)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	modeCallback = callback;
+}
+
+void SafetyMonitor::setPendantStateChangeCallback(const pendant_state_callback_type& callback)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	pendantStateCallback = callback;
+}
+
+bool SafetyMonitor::getSnapshot(Snapshot* snapshot) const
+{
+	if ( !snapshotLock.hasBeenWritten() ) {
+		return false;
+	}
+	snapshotLock.read(snapshot);
+	return true;
+}
+
+bool SafetyMonitor::getRecentSnapshot(Snapshot* snapshot) const
+{
+	// Don't spin if called from a real-time thread that preempted operate().
+	return snapshotLock.hasBeenWritten()  &&  snapshotLock.tryRead(snapshot, 3)  &&
+			highResolutionSystemTime() - snapshot->modeTime <= snapshot->maxAge;
+}
+
+bool SafetyMonitor::getMode(enum SafetyModule::SafetyMode* mode) const
+{
+	Snapshot snapshot;
+	if ( !getRecentSnapshot(&snapshot) ) {
+		return false;
+	}
+	*mode = snapshot.mode;
+	return true;
+}
+
+bool SafetyMonitor::getPendantState(SafetyModule::PendantState* ps) const
+{
+	Snapshot snapshot;
+	if ( !getRecentSnapshot(&snapshot)  ||  snapshot.pendantStateTime == 0.0 ) {
+		return false;
+	}
+	*ps = snapshot.pendantState;
+	return true;
+}
+
+bool SafetyMonitor::waitForMode(enum SafetyModule::SafetyMode mode, double timeout_s,
+		double pollingPeriod_s) const
+{
+	double start = highResolutionSystemTime();
+	Snapshot snapshot;
+	while (true) {
+		if (getSnapshot(&snapshot)  &&  snapshot.mode == mode) {
+			return true;
+		}
+		if (timeout_s > 0.0  &&  highResolutionSystemTime() - start > timeout_s) {
+			return false;
+		}
+		btsleep(pollingPeriod_s);
+	}
+}
+
+
+int SafetyMonitor::requestProperty(enum Puck::Property prop)
+{
+	BARRETT_SCOPED_LOCK(puck->getBus().getMutex());
+	return Puck::sendGetPropertyRequest(puck->getBus(), puck->getId(), puck->getPropertyId(prop));
+}
+
+int SafetyMonitor::receiveReply(enum Puck::Property* prop, int* value)
+{
+	const bus::CommunicationsBus& bus = puck->getBus();
+	unsigned char data[bus::CommunicationsBus::MAX_MESSAGE_LEN];
+	size_t len;
+
+	int ret = bus.receive(Puck::StandardParser::busId(puck->getId(), 0), data, len, false, true);
+	if (ret != 0) {
+		return ret;
+	}
+
+	int propId = data[0] & Puck::PROPERTY_MASK;
+	if (propId == modePropId) {
+		*prop = Puck::MODE;
+	} else if (propId == penPropId) {
+		*prop = Puck::PEN;
+	} else {
+		return -1;
+	}
+	return -Puck::StandardParser::parse(puck->getId(), propId, value, data, len);
+}
+
+
+void SafetyMonitor::onExecutionManagerChanged()
+{
+	System::onExecutionManagerChanged();  // First, call super
+	getSamplePeriodFromEM();
+}
+
+void SafetyMonitor::operate()
+{
+	bool updated = false;
+
+	// Collect the replies that have arrived. They are matched to MODE and PEN
+	// by property, so a late or unexpected reply is used (or discarded) rather
+	// than being taken for the answer to a later request.
+	enum Puck::Property prop;
+	int value;
+	for (int i = 0; i < MAX_REPLIES_PER_CYCLE; ++i) {
+		int ret = receiveReply(&prop, &value);
+		if (ret == 1) {  // Nothing waiting
+			break;
+		} else if (ret > 0) {  // Bus error
+			++errorCount;
+			break;
+		} else if (ret < 0) {  // Discarded
+			++errorCount;
+		} else if (prop == Puck::MODE) {
+			modePending = false;
+			updated = updateMode(value)  ||  updated;
+		} else {
+			penPending = false;
+			updated = updatePendantState(value)  ||  updated;
+		}
+	}
+
+	if (modePending  ||  penPending) {
+		if (++missedCycles >= MAX_MISSED_CYCLES) {
+			++errorCount;
+			modePending = penPending = false;  // Give up on it
+		}
+	} else if (rate != 0.0  &&  cycle >= nextDue) {
+		// Both replies are collected during later cycles. If a request can't
+		// be sent, only the replies that were requested are waited for.
+		modePending = requestProperty(Puck::MODE) == 0;
+		penPending = requestProperty(Puck::PEN) == 0;
+		if ( !modePending  ||  !penPending ) {
+			++errorCount;
+		}
+		missedCycles = 0;
+
+		long period = 1;
+		if (T_s > 0.0) {
+			period = std::max(1L, static_cast<long>(std::floor(1.0 / (rate * T_s) + 0.5)));
+		}
+		nextDue += period;
+		if (nextDue <= cycle) {
+			nextDue = cycle + period;
+		}
+		// Tolerates one missed read
+		current.maxAge = (2*period + MAX_MISSED_CYCLES) * T_s;
+	}
+	++cycle;
+
+	if (updated  &&  hasMode) {
+		snapshotLock.write(current);
+	}
+	if (hasMode) {
+		modeOutputValue->setData(&current.mode);
+	}
+}
+
+bool SafetyMonitor::updateMode(int value)
+{
+	if (value < SafetyModule::ESTOP  ||  value > SafetyModule::ACTIVE) {
+		++errorCount;
+		return false;
+	}
+
+	enum SafetyModule::SafetyMode previous = current.mode;
+	current.mode = static_cast<enum SafetyModule::SafetyMode>(value);
+	current.modeTime = highResolutionSystemTime();
+	if (hasMode  &&  current.mode != previous  &&  modeCallback) {
+		modeCallback(previous, current.mode);
+	}
+	hasMode = true;
+
+	return true;
+}
+
+bool SafetyMonitor::updatePendantState(int value)
+{
+	if ( !SafetyModule::decodePendantState(value, &pendantStateTmp) ) {
+		++errorCount;
+		return false;
+	}
+
+	current.pendantState = pendantStateTmp;
+	current.pendantStateTime = highResolutionSystemTime();
+	if (hasPendantState  &&  value != pen  &&  pendantStateCallback) {
+		pendantStateCallback(current.pendantState);
+	}
+	pen = value;
+	hasPendantState = true;
+
+	return true;
+}
+
+void SafetyMonitor::getSamplePeriodFromEM()
+{
+	if (this->hasExecutionManager()) {
+		assert(this->getExecutionManager()->getPeriod() > 0.0);
+		T_s = this->getExecutionManager()->getPeriod();
+	} else {
+		T_s = 0.0;
+	}
+}
+
+
+}
+}
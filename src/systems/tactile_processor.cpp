@@ -0,0 +1,136 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+/*
+ * @file tactile_processor.cpp
+ * @date 10/19/2026
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/products/hand.h>
+#include <barrett/systems/tactile_processor.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+TactileProcessor::TactileProcessor(double cellArea_, double contactThreshold_,
+		bool spatialFilter_, const std::string& sysName) :
+	SingleIO<tactile_type, tactile_type>(sysName),
+	totalForceOutput(this, &totalForceOutputValue), centroidOutput(this, &centroidOutputValue),
+	cellArea(cellArea_), contactThreshold(contactThreshold_), spatialFilter(spatialFilter_),
+	tarePending(0), tareValue(0.0), pressure(0.0), totalForce(0.0), centroid(0.0)
+{
+	if (cellArea <= 0.0) {
+		(logMessage("systems::TactileProcessor::%s(): cellArea must be positive (got %f).")
+				% __func__ % cellArea).raise<std::invalid_argument>();
+	}
+
+	const int n = TactilePuck::NUM_SENSORS;
+	for (int i = 0; i < n; ++i) {
+		int row = i / TACT_COLUMNS;
+		int col = i % TACT_COLUMNS;
+		cellPositions(i, 0) = col - (TACT_COLUMNS - 1) / 2.0;
+		cellPositions(i, 1) = row - (TACT_ROWS - 1) / 2.0;
+
+		// Cell i spreads its pressure over its neighbors with binomial weights
+		// (1 2 1) x (1 2 1), renormalized at the edges so none is lost.
+		for (int j = 0; j < n; ++j) {
+			int dr = std::abs(j / TACT_COLUMNS - row);
+			int dc = std::abs(j % TACT_COLUMNS - col);
+			filter(i, j) = (dr <= 1  &&  dc <= 1) ? (2 - dr) * (2 - dc) : 0.0;
+		}
+		filter.row(i) /= filter.row(i).sum();
+	}
+}
+
+TactileProcessor::~TactileProcessor()
+{
+	mandatoryCleanUp();
+}
+
+void TactileProcessor::tare(unsigned int whichPads)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	tarePending |= whichPads;
+}
+
+void TactileProcessor::clearTare()
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	tarePending = 0;
+	tareValue.setZero();
+}
+
+void TactileProcessor::setSpatialFilter(bool enable)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	spatialFilter = enable;
+}
+
+
+void TactileProcessor::operate()
+{
+	const tactile_type& raw = input.getValue();
+
+	if (tarePending != 0) {
+		for (size_t i = 0; i < Hand::DOF; ++i) {
+			if (tarePending & (1 << i)) {
+				tareValue.row(i) = raw.row(i);
+			}
+		}
+		tarePending = 0;
+	}
+
+	pressure = (raw - tareValue).cwiseMax(tactile_type::Zero());
+	if (spatialFilter) {
+		pressure = pressure * filter;
+	}
+
+	totalForce = pressure.rowwise().sum();
+	centroid = pressure * cellPositions;
+	for (size_t i = 0; i < Hand::DOF; ++i) {
+		if (totalForce[i] > contactThreshold) {
+			centroid.row(i) /= totalForce[i];
+		} else {
+			centroid.row(i).setZero();
+		}
+	}
+	totalForce *= cellArea;
+
+	outputValue->setData(&pressure);
+	totalForceOutputValue->setData(&totalForce);
+	centroidOutputValue->setData(&centroid);
+}
+
+
+}
+}
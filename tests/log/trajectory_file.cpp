@@ -0,0 +1,184 @@
+/*
+ * trajectory_file.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/log/trajectory_file.h>
+
+
+namespace {
+using namespace barrett;
+
+typedef units::JointPositions<7>::type jp_type;
+typedef units::CartesianPosition::type cp_type;
+
+
+jp_type sample(double s) {
+	jp_type jp;
+	for (size_t i = 0; i < 7; ++i) {
+		jp[i] = std::sin(s + i);
+	}
+	return jp;
+}
+
+
+TEST(TrajectoryFileTest, JointSpace) {
+	char tmpFile[] = "/tmp/btXXXXXX";
+	ASSERT_TRUE(mkstemp(tmpFile) != -1);
+
+	const size_t N = 1001;
+	{
+		log::TrajectoryFileWriter tfw(tmpFile, log::TrajectoryFile::JOINT_SPACE, 7, 0.002);
+		for (size_t k = 0; k < N; ++k) {
+			tfw.add(0.002 * k, sample(0.002 * k));
+		}
+		EXPECT_EQ(N, tfw.size());
+	}
+
+	EXPECT_TRUE(log::TrajectoryFile::isTrajectoryFile(tmpFile));
+	log::TrajectoryFile tf(tmpFile);
+	EXPECT_EQ(log::TrajectoryFile::JOINT_SPACE, tf.getSpace());
+	EXPECT_EQ(7u, tf.getDimension());
+	EXPECT_EQ(0.002, tf.getSamplePeriod());
+	ASSERT_EQ(N, tf.size());
+	EXPECT_EQ(0.0, tf.initialS());
+	EXPECT_EQ(0.002 * (N-1), tf.finalS());
+
+	jp_type jp;
+	for (size_t k = 0; k < N; ++k) {
+		EXPECT_EQ(0.002 * k, tf.getS(k));
+		tf.getPoint(k, &jp);
+		for (size_t i = 0; i < 7; ++i) {
+			EXPECT_EQ(float(sample(0.002 * k)[i]), jp[i]);
+		}
+	}
+
+	cp_type cp;
+	EXPECT_THROW(tf.getPoint(0, &cp), std::logic_error);
+
+	std::remove(tmpFile);
+}
+
+TEST(TrajectoryFileTest, Pose) {
+	char tmpFile[] = "/tmp/btXXXXXX";
+	ASSERT_TRUE(mkstemp(tmpFile) != -1);
+
+	// An odd number of knots leaves the s column to be aligned.
+	{
+		log::TrajectoryFileWriter tfw(tmpFile, log::TrajectoryFile::POSE_SPACE, 7);
+		for (size_t k = 0; k < 5; ++k) {
+			tfw.add(0.5 * k, cp_type(k, 2.0, -3.0), Eigen::Quaterniond(0.0, 1.0, 0.0, 0.0));
+		}
+		tfw.close();
+	}
+
+	log::TrajectoryFile tf(tmpFile);
+	EXPECT_EQ(log::TrajectoryFile::POSE_SPACE, tf.getSpace());
+	ASSERT_EQ(5u, tf.size());
+
+	cp_type cp;
+	Eigen::Quaterniond q;
+	tf.getPose(3, &cp, &q);
+	EXPECT_EQ(cp_type(3.0, 2.0, -3.0), cp);
+	EXPECT_EQ(1.0, q.x());
+	EXPECT_EQ(0.0, q.w());
+
+	std::remove(tmpFile);
+}
+
+TEST(TrajectoryFileTest, Find) {
+	char tmpFile[] = "/tmp/btXXXXXX";
+	ASSERT_TRUE(mkstemp(tmpFile) != -1);
+
+	{
+		log::TrajectoryFileWriter tfw(tmpFile, log::TrajectoryFile::JOINT_SPACE, 1);
+		double p = 0.0;
+		for (size_t k = 0; k < 100; ++k) {
+			tfw.add(k * k, &p);
+		}
+	}
+
+	log::TrajectoryFile tf(tmpFile);
+	EXPECT_EQ(0u, tf.find(-1.0));
+	EXPECT_EQ(0u, tf.find(0.0));
+	EXPECT_EQ(0u, tf.find(0.5));
+	EXPECT_EQ(5u, tf.find(25.0));
+	EXPECT_EQ(5u, tf.find(35.9));
+	EXPECT_EQ(6u, tf.find(36.0));
+	EXPECT_EQ(99u, tf.find(1e9));
+
+	std::remove(tmpFile);
+}
+
+TEST(TrajectoryFileTest, Throws) {
+	char tmpFile[] = "/tmp/btXXXXXX";
+	ASSERT_TRUE(mkstemp(tmpFile) != -1);
+
+	EXPECT_THROW(log::TrajectoryFile("/does/not/exist"), std::runtime_error);
+
+	// Not a trajectory file
+	{
+		std::ofstream file(tmpFile);
+		file << "jp_type\n0.0, 1.0, 2.0, 3.0, 4.0\n0.1, 1.0, 2.0, 3.0, 4.0\n";
+	}
+	EXPECT_FALSE(log::TrajectoryFile::isTrajectoryFile(tmpFile));
+	EXPECT_THROW(log::TrajectoryFile tf(tmpFile), std::runtime_error);
+
+	// Empty
+	{
+		log::TrajectoryFileWriter tfw(tmpFile, log::TrajectoryFile::JOINT_SPACE, 4);
+		jp_type jp(0.0);
+		EXPECT_THROW(tfw.add(0.0, jp), std::logic_error);
+	}
+	EXPECT_TRUE(log::TrajectoryFile::isTrajectoryFile(tmpFile));
+	EXPECT_THROW(log::TrajectoryFile tf(tmpFile), std::runtime_error);
+
+	// Truncated
+	{
+		log::TrajectoryFileWriter tfw(tmpFile, log::TrajectoryFile::JOINT_SPACE, 1);
+		double p = 0.0;
+		tfw.add(0.0, &p);
+		tfw.add(1.0, &p);
+		EXPECT_THROW(tfw.add(1.0, &p), std::logic_error);
+	}
+	EXPECT_NO_THROW(log::TrajectoryFile tf(tmpFile));
+	EXPECT_EQ(0, truncate(tmpFile, sizeof(log::TrajectoryFile::Header) + 8));
+	EXPECT_THROW(log::TrajectoryFile tf(tmpFile), std::runtime_error);
+
+	// A knotCount large enough to wrap the size calculation around
+	{
+		log::TrajectoryFileWriter tfw(tmpFile, log::TrajectoryFile::JOINT_SPACE, 1);
+		double p = 0.0;
+		tfw.add(0.0, &p);
+		tfw.add(1.0, &p);
+	}
+	{
+		log::TrajectoryFile::Header header;
+		std::FILE* file = std::fopen(tmpFile, "r+b");
+		ASSERT_TRUE(file != NULL);
+		ASSERT_EQ(1u, std::fread(&header, sizeof(header), 1, file));
+		header.knotCount = (boost::uint64_t(1) << 62) + 1;
+		std::rewind(file);
+		ASSERT_EQ(1u, std::fwrite(&header, sizeof(header), 1, file));
+		std::fclose(file);
+	}
+	EXPECT_THROW(log::TrajectoryFile tf(tmpFile), std::runtime_error);
+
+	EXPECT_THROW(log::TrajectoryFileWriter(tmpFile, log::TrajectoryFile::POSE_SPACE, 3), std::logic_error);
+
+	std::remove(tmpFile);
+}
+
+
+}
@@ -0,0 +1,161 @@
+/*
+ * aabb_tree.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <barrett/math/aabb_tree.h>
+
+
+namespace {
+using namespace barrett;
+
+typedef math::AabbTree::vector_type vector_type;
+typedef math::AabbTree::Box Box;
+
+
+double random(double low, double high) {
+	return low + (high - low) * std::rand() / RAND_MAX;
+}
+
+vector_type randomPoint(double range) {
+	return vector_type(random(-range, range), random(-range, range), random(-range, range));
+}
+
+
+// Items are spheres
+struct SphereDistance {
+	SphereDistance(const std::vector<vector_type>& c, const std::vector<double>& r) :
+		centers(c), radii(r) {}
+
+	double operator() (size_t i, const vector_type& p) const {
+		double d = std::max((p - centers[i]).norm() - radii[i], 0.0);
+		return d * d;
+	}
+
+	const std::vector<vector_type>& centers;
+	const std::vector<double>& radii;
+};
+
+struct Collector {
+	void operator() (size_t i) { found.push_back(i); }
+	std::vector<size_t> found;
+};
+
+
+class AabbTreeTest : public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		std::srand(42);
+		for (size_t i = 0; i < 500; ++i) {
+			centers.push_back(randomPoint(1.0));
+			radii.push_back(random(0.001, 0.05));
+
+			Box b(centers.back(), centers.back());
+			b.inflate(radii.back());
+			boxes.push_back(b);
+		}
+		tree.build(boxes);
+	}
+
+	size_t bruteForceNearest(const vector_type& p, double* d2) {
+		SphereDistance dist(centers, radii);
+		size_t best = 0;
+		*d2 = std::numeric_limits<double>::infinity();
+		for (size_t i = 0; i < centers.size(); ++i) {
+			if (dist(i, p) < *d2) {
+				*d2 = dist(i, p);
+				best = i;
+			}
+		}
+		return best;
+	}
+
+	std::vector<vector_type> centers;
+	std::vector<double> radii;
+	std::vector<Box> boxes;
+	math::AabbTree tree;
+};
+
+
+TEST(AabbTreeBoxTest, Box) {
+	Box b;
+	b.extend(vector_type(1, 2, 3));
+	EXPECT_EQ(vector_type(1, 2, 3), b.min);
+	EXPECT_EQ(vector_type(1, 2, 3), b.max);
+
+	b.extend(Box(vector_type(0, 0, 0), vector_type(-1, 4, 1)));
+	EXPECT_EQ(vector_type(-1, 0, 0), b.min);
+	EXPECT_EQ(vector_type(1, 4, 3), b.max);
+	EXPECT_EQ(vector_type(0, 2, 1.5), b.center());
+
+	EXPECT_TRUE(b.contains(vector_type(0, 1, 1)));
+	EXPECT_FALSE(b.contains(vector_type(0, 5, 1)));
+	EXPECT_EQ(0.0, b.squaredDistance(vector_type(0, 1, 1)));
+	EXPECT_DOUBLE_EQ(1.0 + 4.0, b.squaredDistance(vector_type(2, 6, 1)));
+
+	EXPECT_TRUE(b.intersects(Box(vector_type(1, 4, 3), vector_type(2, 5, 4))));
+	EXPECT_FALSE(b.intersects(Box(vector_type(1.1, 4, 3), vector_type(2, 5, 4))));
+}
+
+TEST(AabbTreeBoxTest, Empty) {
+	math::AabbTree tree;
+	EXPECT_TRUE(tree.empty());
+
+	double d2;
+	EXPECT_EQ(math::AabbTree::NONE, tree.nearest(vector_type(0, 0, 0),
+			SphereDistance(std::vector<vector_type>(), std::vector<double>()), &d2));
+}
+
+TEST_F(AabbTreeTest, Nearest) {
+	EXPECT_EQ(centers.size(), tree.size());
+
+	SphereDistance dist(centers, radii);
+	size_t hint = math::AabbTree::NONE;
+	for (size_t j = 0; j < 1000; ++j) {
+		vector_type p = randomPoint(1.5);
+
+		double expectedD2, d2;
+		size_t expected = bruteForceNearest(p, &expectedD2);
+
+		// Compare distances, in case of ties
+		EXPECT_EQ(expectedD2, dist(tree.nearest(p, dist, &d2), p));
+		EXPECT_EQ(expectedD2, d2);
+
+		// Any hint gives the same answer.
+		EXPECT_EQ(expectedD2, dist(tree.nearest(p, dist, &d2, hint), p));
+		EXPECT_EQ(expectedD2, d2);
+		EXPECT_EQ(expected, tree.nearest(p, dist, &d2, expected));
+		hint = (j * 7) % centers.size();
+	}
+}
+
+TEST_F(AabbTreeTest, Intersecting) {
+	for (size_t j = 0; j < 100; ++j) {
+		vector_type p = randomPoint(1.0);
+		Box query(p, p + vector_type::Constant(random(0.0, 0.5)));
+
+		Collector c;
+		tree.forEachIntersecting(query, c);
+		std::sort(c.found.begin(), c.found.end());
+
+		std::vector<size_t> expected;
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			if (boxes[i].intersects(query)) {
+				expected.push_back(i);
+			}
+		}
+		EXPECT_EQ(expected, c.found);
+	}
+}
+
+
+}
@@ -0,0 +1,148 @@
+/*
+ * dynamics.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <libconfig.h++>
+
+#include <Eigen/Cholesky>
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/kinematics.h>
+#include <barrett/math/dynamics.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/kinematics_base.h>
+#include <barrett/systems/operational_space_controller.h>
+
+#include "../systems/exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 7;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+
+class DynamicsTest : public ::testing::Test {
+public:
+	DynamicsTest() :
+		kin(NULL), dyn(NULL)
+	{
+		libconfig::Config config;
+		config.readFile("test.config");
+		kin = new math::Kinematics<DOF>(config.lookup("wam.kinematics"));
+		dyn = new math::Dynamics<DOF>(config.lookup("wam.dynamics"));
+	}
+
+	~DynamicsTest() {
+		delete dyn;
+		dyn = NULL;
+		delete kin;
+		kin = NULL;
+	}
+
+protected:
+	math::Kinematics<DOF>* kin;
+	math::Dynamics<DOF>* dyn;
+};
+
+
+TEST_F(DynamicsTest, JsimIsSymmetricPositiveDefinite) {
+	jp_type jp;
+	jp << 0.3, -1.2, 0.1, 2.1, -0.4, 0.9, 0.2;
+	kin->eval(jp, jv_type(0.0));
+
+	sqm_type M = dyn->evalJsim(*kin);
+	EXPECT_TRUE(M.isApprox(M.transpose(), 1e-12));
+
+	Eigen::LLT<sqm_type::Base> llt(M);
+	EXPECT_EQ(Eigen::Success, llt.info());
+}
+
+TEST_F(DynamicsTest, JsimDependsOnConfiguration) {
+	jp_type jp(0.0);
+	kin->eval(jp, jv_type(0.0));
+	sqm_type M0 = dyn->evalJsim(*kin);
+
+	jp[3] = 1.5;
+	kin->eval(jp, jv_type(0.0));
+	sqm_type M1 = dyn->evalJsim(*kin);
+
+	// The first joint sees the whole arm; folding the elbow changes its inertia.
+	EXPECT_NE(M0(0,0), M1(0,0));
+}
+
+TEST_F(DynamicsTest, JsimMatchesInverseDynamics) {
+	jp_type jp;
+	jp << -0.7, 0.4, 1.1, 1.6, 0.3, -0.8, 1.2;
+	kin->eval(jp, jv_type(0.0));
+	dyn->setGravity(ca_type(0.0));
+
+	// At rest and without gravity, the torque needed for a unit acceleration
+	// of joint i is column i of the JSIM.
+	sqm_type M = dyn->evalJsim(*kin);
+	for (size_t i = 0; i < DOF; ++i) {
+		ja_type ja(0.0);
+		ja[i] = 1.0;
+		jt_type jt = dyn->evalInverse(*kin, jv_type(0.0), ja);
+
+		for (size_t j = 0; j < DOF; ++j) {
+			EXPECT_NEAR(M(j,i), jt[j], 1e-9) << "column " << i << ", row " << j;
+		}
+	}
+}
+
+TEST_F(DynamicsTest, OperationalSpaceNullSpaceIsDynamicallyConsistent) {
+	libconfig::Config config;
+	config.readFile("test.config");
+
+	systems::ManualExecutionManager mem(0.002);
+	systems::KinematicsBase<DOF> kinBase(config.lookup("wam.kinematics"));
+	systems::OperationalSpaceController<DOF> osc(config.lookup("wam.dynamics"));
+	ExposedIOSystem<jp_type> jpSource;
+	ExposedIOSystem<jv_type> jvSource;
+	ExposedIOSystem<cp_type> cpSource;
+	ExposedIOSystem<jt_type> jtSink;
+	mem.startManaging(jtSink);
+
+	systems::connect(jpSource.output, kinBase.jpInput);
+	systems::connect(jvSource.output, kinBase.jvInput);
+	systems::connect(kinBase.kinOutput, osc.kinInput);
+	systems::connect(jpSource.output, osc.jpInput);
+	systems::connect(jvSource.output, osc.jvInput);
+	systems::connect(cpSource.output, osc.referenceInput);
+	systems::connect(cpSource.output, osc.feedbackInput);
+	systems::connect(osc.controlOutput, jtSink.input);
+
+	// With no task-space gains, the output is just the projected posture torque.
+	jp_type jp;
+	jp << 0.3, -1.2, 0.1, 2.1, -0.4, 0.9, 0.2;
+	jv_type jv;
+	jv << 0.2, -0.1, 0.3, 0.0, 0.5, -0.2, 0.1;
+	osc.setNullSpaceKp(v_type(10.0));
+	osc.setNullSpaceKd(v_type(1.0));
+	osc.setPosture(jp_type(0.0));
+	jpSource.setOutputValue(jp);
+	jvSource.setOutputValue(jv);
+	cpSource.setOutputValue(cp_type(0.0));
+	mem.runExecutionCycle();
+
+	const jt_type& jt = jtSink.getInputValue();
+	ASSERT_GT(jt.norm(), 1e-3);
+
+	// J * M^-1 * N^T * tau = 0: the null-space torque doesn't accelerate the tool.
+	kin->eval(jp, jv);
+	sqm_type M = dyn->evalJsim(*kin);
+	math::Matrix<3,DOF> J;
+	J.copyFrom(kin->impl->tool_jacobian_linear);
+	Eigen::LDLT<sqm_type::Base> ldlt(M);
+	math::Vector<3>::type ca = J * ldlt.solve(jt);
+	EXPECT_NEAR(0.0, ca.norm(), 1e-8);
+}
+
+
+}
@@ -0,0 +1,362 @@
+/*
+ * jerk_limited_profile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/jerk_limited_profile.h>
+
+
+namespace {
+using namespace barrett;
+
+
+const double V = 1.0;
+const double A = 2.0;
+const double J = 10.0;
+const double DT = 1e-4;
+const double EPS = 1e-9;
+
+// Checks the boundary conditions, limits, and continuity of a planned profile
+void verifyProfile(const math::JerkLimitedProfile& profile,
+		double p0, double v0, double a0, double pf) {
+	double p, v, a;
+
+	profile.eval(0.0, &p, &v, &a);
+	EXPECT_NEAR(p0, p, EPS);
+	EXPECT_NEAR(v0, v, EPS);
+	EXPECT_NEAR(a0, a, EPS);
+
+	// A large initial acceleration may carry the velocity past its limit.
+	const double vStop = v0 + a0 * std::fabs(a0) / (2.0 * J);
+	const double vLimit = std::max(V, std::max(std::fabs(v0), std::fabs(vStop))) + EPS;
+	const double aLimit = std::max(A, std::fabs(a0)) + EPS;
+
+	double pLast = p, vLast = v, aLast = a;
+	for (double t = DT; t < profile.finalT() + 0.1; t += DT) {
+		profile.eval(t, &p, &v, &a);
+
+		ASSERT_LE(std::fabs(v), vLimit) << "t = " << t;
+		ASSERT_LE(std::fabs(a), aLimit) << "t = " << t;
+		ASSERT_LE(std::fabs(a - aLast), J * DT + EPS) << "t = " << t;
+		ASSERT_NEAR(vLast + (aLast + a) / 2.0 * DT, v, J * DT * DT) << "t = " << t;
+		ASSERT_NEAR(pLast + (vLast + v) / 2.0 * DT, p, 1e-6) << "t = " << t;
+
+		pLast = p;
+		vLast = v;
+		aLast = a;
+	}
+
+	profile.eval(profile.finalT(), &p, &v, &a);
+	EXPECT_DOUBLE_EQ(pf, p);
+	EXPECT_EQ(0.0, v);
+	EXPECT_EQ(0.0, a);
+	EXPECT_DOUBLE_EQ(pf, profile.eval(profile.finalT() + 10.0));
+}
+
+
+TEST(JerkLimitedProfileTest, RestToRest) {
+	math::JerkLimitedProfile profile(V, A, J);
+
+	profile.plan(0.0, 0.0, 0.0, 0.1);
+	verifyProfile(profile, 0.0, 0.0, 0.0, 0.1);
+
+	profile.plan(0.0, 0.0, 0.0, 3.0);
+	verifyProfile(profile, 0.0, 0.0, 0.0, 3.0);
+	EXPECT_NEAR(V, (profile.eval(profile.finalT() / 2.0 + DT) - profile.eval(profile.finalT() / 2.0)) / DT, 1e-6);  // cruising
+
+	profile.plan(1.0, 0.0, 0.0, -2.0);
+	verifyProfile(profile, 1.0, 0.0, 0.0, -2.0);
+}
+
+TEST(JerkLimitedProfileTest, ZeroLength) {
+	math::JerkLimitedProfile profile(V, A, J);
+
+	profile.plan(0.5, 0.0, 0.0, 0.5);
+	EXPECT_NEAR(0.0, profile.finalT(), 1e-6);
+	EXPECT_DOUBLE_EQ(0.5, profile.eval(0.0));
+	EXPECT_DOUBLE_EQ(0.5, profile.eval(1.0));
+}
+
+TEST(JerkLimitedProfileTest, InitialVelocityAndAcceleration) {
+	math::JerkLimitedProfile profile(V, A, J);
+
+	profile.plan(0.0, 0.5, 1.0, 2.0);
+	verifyProfile(profile, 0.0, 0.5, 1.0, 2.0);
+
+	// Moving away from the target
+	profile.plan(0.0, -0.8, -1.5, 0.3);
+	verifyProfile(profile, 0.0, -0.8, -1.5, 0.3);
+
+	// Overshooting the target
+	profile.plan(0.0, 0.9, 1.0, 0.05);
+	verifyProfile(profile, 0.0, 0.9, 1.0, 0.05);
+}
+
+TEST(JerkLimitedProfileTest, InitialStateExceedsLimits) {
+	math::JerkLimitedProfile profile(V, A, J);
+
+	profile.plan(0.0, 1.5, 0.0, 5.0);
+	verifyProfile(profile, 0.0, 1.5, 0.0, 5.0);
+
+	profile.plan(0.0, 0.0, 4.0, 1.0);
+	verifyProfile(profile, 0.0, 0.0, 4.0, 1.0);
+}
+
+TEST(JerkLimitedProfileTest, TrapezoidalCompatibleCtor) {
+	math::JerkLimitedProfile profile(V, A, J, 0.3, 2.0);
+	verifyProfile(profile, 0.0, 0.3, 0.0, 2.0);
+}
+
+TEST(JerkLimitedProfileTest, Duration) {
+	math::JerkLimitedProfile profile(V, A, J);
+
+	profile.plan(0.0, 0.0, 0.0, 1.0);
+	double fastest = profile.finalT();
+
+	EXPECT_TRUE(profile.plan(0.0, 0.0, 0.0, 1.0, fastest + 2.0));
+	EXPECT_NEAR(fastest + 2.0, profile.finalT(), 1e-6);
+	verifyProfile(profile, 0.0, 0.0, 0.0, 1.0);
+
+	EXPECT_TRUE(profile.plan(0.0, 0.4, -0.5, 1.0, 5.0));
+	EXPECT_NEAR(5.0, profile.finalT(), 1e-6);
+	verifyProfile(profile, 0.0, 0.4, -0.5, 1.0);
+
+	// Can't go faster than the limits allow
+	EXPECT_FALSE(profile.plan(0.0, 0.0, 0.0, 1.0, fastest / 2.0));
+	EXPECT_DOUBLE_EQ(fastest, profile.finalT());
+}
+
+double random(double low, double high) {
+	return low + (high - low) * std::rand() / RAND_MAX;
+}
+
+TEST(JerkLimitedProfileTest, DurationOvershoot) {
+	math::JerkLimitedProfile profile(1.0, 2.0, 20.0);
+	const double p0 = 0.0, v0 = -0.884161, a0 = -1.96244, pf = -0.410383;
+
+	profile.plan(p0, v0, a0, pf);
+	const double fastest = profile.finalT();
+
+	// The initial acceleration carries the axis past pf, and only a narrow
+	// range of slower moves avoids reversing during the cruise.
+	if (profile.plan(p0, v0, a0, pf, fastest + 0.05)) {
+		EXPECT_NEAR(fastest + 0.05, profile.finalT(), 1e-6);
+	} else {
+		EXPECT_DOUBLE_EQ(fastest, profile.finalT());
+	}
+	EXPECT_NEAR(pf, profile.eval(profile.finalT() * (1.0 - 1e-12)), 1e-6);
+
+	EXPECT_TRUE(profile.plan(p0, v0, a0, pf, fastest + 1.0));
+	EXPECT_NEAR(fastest + 1.0, profile.finalT(), 1e-6);
+	EXPECT_NEAR(pf, profile.eval(profile.finalT() * (1.0 - 1e-12)), 1e-6);
+}
+
+// plan() with a duration either meets the duration exactly and ends on
+// target, or falls back to the fastest move.
+TEST(JerkLimitedProfileTest, RandomDurations) {
+	const double v = 1.0, a = 2.0, j = 20.0;
+	math::JerkLimitedProfile profile(v, a, j);
+	std::srand(29);
+
+	for (int i = 0; i < 5000; ++i) {
+		const double p0 = random(-0.5, 0.5);
+		const double v0 = random(-v, v);
+		const double a0 = random(-a, a);
+		const double pf = random(-0.5, 0.5);
+
+		// Short extensions of short moves are where an initial overshoot
+		// leaves no valid slower move.
+		profile.plan(p0, v0, a0, pf);
+		const double fastest = profile.finalT();
+		const double duration = fastest + random(0.0, 0.05);
+
+		SCOPED_TRACE(::testing::Message() << "p0 = " << p0 << ", v0 = " << v0
+				<< ", a0 = " << a0 << ", pf = " << pf << ", duration = " << duration);
+		if (profile.plan(p0, v0, a0, pf, duration)) {
+			ASSERT_NEAR(duration, profile.finalT(), 1e-6);
+		} else {
+			ASSERT_DOUBLE_EQ(fastest, profile.finalT());
+		}
+
+		// Just before the end, the profile is already (almost) at rest on
+		// target; eval() doesn't hide a jump.
+		double p, vel, acc;
+		profile.eval(profile.finalT() - 1e-9, &p, &vel, &acc);
+		ASSERT_NEAR(pf, p, 1e-6);
+		ASSERT_NEAR(0.0, vel, 1e-6);
+	}
+}
+
+// Exposes the displacement of a move without a cruise segment
+class PeakProfile : public math::JerkLimitedProfile {
+public:
+	PeakProfile() : math::JerkLimitedProfile(V, A, J) {}
+
+	double displacement(double v0, double a0, double vPeak, double* duration) const {
+		return peakDisplacement(v0, a0, vPeak, duration);
+	}
+};
+
+TEST(JerkLimitedProfileTest, FastestPeakVelocity) {
+	PeakProfile profile;
+	std::srand(229);
+
+	int checked = 0;
+	for (int i = 0; i < 300; ++i) {
+		const double v0 = random(-V, V);
+		const double a0 = random(-2.0 * A, 2.0 * A);
+		const double pf = random(-0.5, 0.5);
+		double duration;
+		if (pf >= profile.displacement(v0, a0, V, &duration)  ||
+				pf <= profile.displacement(v0, a0, -V, &duration)) {
+			continue;  // Cruises at the velocity limit
+		}
+		++checked;
+
+		// The displacement isn't monotonic in the peak velocity, so pf may
+		// be reached by several peaks. Scan for all of them.
+		const int N = 2000;
+		double best = -1.0;
+		double vLast = -V;
+		double dLast = profile.displacement(v0, a0, vLast, &duration) - pf;
+		for (int j = 1; j <= N; ++j) {
+			double v = -V + 2.0 * V * j / N;
+			double d = profile.displacement(v0, a0, v, &duration) - pf;
+			if ((dLast <= 0.0) != (d <= 0.0)) {
+				double lo = vLast, hi = v;
+				for (int k = 0; k < 60; ++k) {
+					double mid = (lo + hi) / 2.0;
+					if ((profile.displacement(v0, a0, mid, &duration) - pf <= 0.0) == (dLast <= 0.0)) {
+						lo = mid;
+					} else {
+						hi = mid;
+					}
+				}
+				profile.displacement(v0, a0, (lo + hi) / 2.0, &duration);
+				if (best < 0.0  ||  duration < best) {
+					best = duration;
+				}
+			}
+			vLast = v;
+			dLast = d;
+		}
+
+		SCOPED_TRACE(::testing::Message() << "v0 = " << v0 << ", a0 = " << a0 << ", pf = " << pf);
+		profile.plan(0.0, v0, a0, pf);
+		ASSERT_LT(profile.finalT(), best + 1e-6);
+	}
+	EXPECT_GT(checked, 100);
+}
+
+TEST(JerkLimitedProfileTest, BadLimitsThrow) {
+	EXPECT_THROW(math::JerkLimitedProfile(0.0, A, J), std::logic_error);
+	EXPECT_THROW(math::JerkLimitedProfile(V, -1.0, J), std::logic_error);
+	EXPECT_THROW(math::JerkLimitedProfile(V, A, 0.0), std::logic_error);
+}
+
+
+TEST(SynchronizedJerkLimitedProfileTest, AxesFinishTogether) {
+	typedef units::JointPositions<3>::type jp_type;
+	typedef jp_type::unitless_type v_type;
+
+	math::SynchronizedJerkLimitedProfile<jp_type> profile(V, A, J);
+	jp_type p0(0.0, 1.0, -1.0);
+	jp_type pf(2.0, 1.1, -1.0);
+	v_type v0(0.0, 0.0, 0.5);
+
+	profile.plan(p0, v0, v_type(0.0), pf);
+	for (size_t i = 0; i < 3; ++i) {
+		EXPECT_NEAR(profile.finalT(), profile.getProfile(i).finalT(), 1e-6);
+		verifyProfile(profile.getProfile(i), p0[i], v0[i], 0.0, pf[i]);
+	}
+
+	EXPECT_EQ(p0, profile.eval(0.0));
+	EXPECT_EQ(pf, profile.eval(profile.finalT()));
+}
+
+TEST(SynchronizedJerkLimitedProfileTest, LargeInitialAcceleration) {
+	typedef units::JointPositions<2>::type jp_type;
+	typedef jp_type::unitless_type v_type;
+
+	math::SynchronizedJerkLimitedProfile<jp_type> profile(V, A, J);
+	jp_type p0(0.0, 0.0);
+	jp_type pf(0.18, -0.29);
+	v_type v0(0.0, -0.21);
+	v_type a0(0.0, -2.6);
+
+	// Axis 0 is the slowest, but axis 1's acceleration leaves it no slower
+	// move of the same length, so the move must be lengthened.
+	math::JerkLimitedProfile axis(V, A, J);
+	axis.plan(p0[0], v0[0], a0[0], pf[0]);
+	const double tSlowest = axis.finalT();
+	axis.plan(p0[1], v0[1], a0[1], pf[1]);
+	ASSERT_LT(axis.finalT(), tSlowest);
+	ASSERT_FALSE(axis.plan(p0[1], v0[1], a0[1], pf[1], tSlowest));
+
+	EXPECT_TRUE(profile.plan(p0, v0, a0, pf));
+	EXPECT_GT(profile.finalT(), tSlowest);
+	for (size_t i = 0; i < 2; ++i) {
+		EXPECT_NEAR(profile.finalT(), profile.getProfile(i).finalT(), 1e-6);
+		verifyProfile(profile.getProfile(i), p0[i], v0[i], a0[i], pf[i]);
+	}
+}
+
+TEST(SynchronizedJerkLimitedProfileTest, RandomInitialStates) {
+	typedef units::JointPositions<3>::type jp_type;
+	typedef jp_type::unitless_type v_type;
+
+	math::SynchronizedJerkLimitedProfile<jp_type> profile(V, A, J);
+	std::srand(129);
+
+	for (int i = 0; i < 2000; ++i) {
+		jp_type p0, pf;
+		v_type v0, a0;
+		for (size_t j = 0; j < 3; ++j) {
+			p0[j] = random(-0.5, 0.5);
+			v0[j] = random(-V, V);
+			a0[j] = random(-2.0 * A, 2.0 * A);
+			pf[j] = random(-0.5, 0.5);
+		}
+
+		SCOPED_TRACE(::testing::Message() << "p0 = " << p0 << ", v0 = " << v0
+				<< ", a0 = " << a0 << ", pf = " << pf);
+		ASSERT_TRUE(profile.plan(p0, v0, a0, pf));
+		for (size_t j = 0; j < 3; ++j) {
+			ASSERT_NEAR(profile.finalT(), profile.getProfile(j).finalT(), 1e-6);
+		}
+		ASSERT_TRUE((profile.eval(profile.finalT() - 1e-9) - pf).norm() < 1e-6);
+	}
+}
+
+TEST(SynchronizedJerkLimitedProfileTest, StraightLineFromRest) {
+	typedef units::JointPositions<3>::type jp_type;
+	typedef jp_type::unitless_type v_type;
+
+	math::SynchronizedJerkLimitedProfile<jp_type> profile(V, A, J);
+	jp_type p0(0.0, 1.0, -1.0);
+	jp_type pf(2.0, 1.5, -1.0);
+
+	profile.plan(p0, v_type(0.0), v_type(0.0), pf);
+	for (size_t i = 0; i < 3; ++i) {
+		verifyProfile(profile.getProfile(i), p0[i], 0.0, 0.0, pf[i]);
+	}
+
+	jp_type d = pf - p0;
+	for (double t = 0.0; t < profile.finalT(); t += 0.01) {
+		jp_type p = profile.eval(t) - p0;
+		EXPECT_NEAR(p[0] * d[1], p[1] * d[0], 1e-9);
+		EXPECT_EQ(0.0, p[2]);
+	}
+}
+
+
+}
@@ -8,6 +8,7 @@
 
 #include <iostream>
 #include <vector>
+#include <cmath>
 #include <boost/tuple/tuple.hpp>
 
 #define EIGEN_USE_NEW_STDVECTOR
@@ -171,5 +172,134 @@ TEST(SplineTest, NoSaturateCtor) {
 	}
 }
 
+TEST(SplineTest, NaturalCubicCoefficients) {
+	typedef math::Spline<jp_type>::tuple_type tuple_type;
+	tuple_type sample;
+	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > samples;
+
+	// The natural cubic spline through (0,0), (1,1), (2,0) is
+	// 1.5s - 0.5s^3 on the first segment.
+	sample.get<0>() = 0.0;
+	sample.get<1>().setConstant(0.0);
+	samples.push_back(sample);
+	sample.get<0>() = 1.0;
+	sample.get<1>().setConstant(1.0);
+	samples.push_back(sample);
+	sample.get<0>() = 2.0;
+	sample.get<1>().setConstant(0.0);
+	samples.push_back(sample);
+
+	math::Spline<jp_type> spline(samples);
+
+	jp_type p, v, a;
+	spline.eval(0.5, &p, &v, &a);
+	for (size_t i = 0; i < DOF; ++i) {
+		EXPECT_DOUBLE_EQ(0.6875, p[i]);
+		EXPECT_DOUBLE_EQ(1.125, v[i]);
+		EXPECT_DOUBLE_EQ(-1.5, a[i]);
+	}
+	EXPECT_EQ(p, spline.eval(0.5));
+	EXPECT_EQ(v, spline.evalDerivative(0.5));
+	EXPECT_EQ(a, spline.evalSecondDerivative(0.5));
+
+	// Symmetric about s = 1
+	spline.eval(1.5, &p, &v, NULL);
+	for (size_t i = 0; i < DOF; ++i) {
+		EXPECT_DOUBLE_EQ(0.6875, p[i]);
+		EXPECT_DOUBLE_EQ(-1.125, v[i]);
+	}
+}
+
+TEST(SplineTest, ContinuousAtKnots) {
+	typedef math::Spline<jp_type>::tuple_type tuple_type;
+	tuple_type sample;
+	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > samples;
+
+	const double s[] = { 0.0, 0.3, 1.0, 1.2, 2.5, 3.0 };
+	const size_t N = sizeof(s) / sizeof(s[0]);
+	for (size_t k = 0; k < N; ++k) {
+		sample.get<0>() = s[k];
+		for (size_t i = 0; i < DOF; ++i) {
+			sample.get<1>()[i] = std::sin(s[k] + i);
+		}
+		samples.push_back(sample);
+	}
+
+	math::Spline<jp_type> spline(samples);
+
+	const double eps = 1e-9;
+	for (size_t k = 0; k < N; ++k) {
+		jp_type p = spline.eval(s[k]);
+		for (size_t i = 0; i < DOF; ++i) {
+			EXPECT_NEAR(std::sin(s[k] + i), p[i], 1e-12);
+		}
+
+		if (k > 0  &&  k < N-1) {
+			jp_type pl, vl, al, pr, vr, ar;
+			spline.eval(s[k] - eps, &pl, &vl, &al);
+			spline.eval(s[k] + eps, &pr, &vr, &ar);
+			for (size_t i = 0; i < DOF; ++i) {
+				EXPECT_NEAR(pl[i], pr[i], 1e-8);
+				EXPECT_NEAR(vl[i], vr[i], 1e-7);
+				EXPECT_NEAR(al[i], ar[i], 1e-6);
+			}
+		}
+	}
+
+	// Natural end conditions
+	jp_type a = spline.evalSecondDerivative(s[0]);
+	for (size_t i = 0; i < DOF; ++i) {
+		EXPECT_NEAR(0.0, a[i], 1e-9);
+	}
+	a = spline.evalSecondDerivative(s[N-1]);
+	for (size_t i = 0; i < DOF; ++i) {
+		EXPECT_NEAR(0.0, a[i], 1e-9);
+	}
+}
+
+TEST(SplineTest, QuaternionMatchesSlerp) {
+	typedef math::Spline<Eigen::Quaterniond>::tuple_type tuple_type;
+	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > samples;
+
+	const size_t N = 50;
+	for (size_t k = 0; k < N; ++k) {
+		Eigen::Quaterniond q(Eigen::AngleAxisd(0.3 * k, Eigen::Vector3d(1.0, 0.5 * std::sin(double(k)), 0.2).normalized()));
+		if (k % 7 == 3) {
+			q.coeffs() = -q.coeffs();  // same rotation, opposite hemisphere
+		}
+		samples.push_back(boost::make_tuple(0.1 * k + 0.02 * (k % 2), q));
+	}
+
+	math::Spline<Eigen::Quaterniond> spline(samples);
+	EXPECT_EQ(samples.front().get<0>(), spline.initialS());
+	EXPECT_EQ(samples.back().get<0>(), spline.finalS());
+
+	// Random access, forward, and backward evaluation must all agree with slerp.
+	math::Spline<Eigen::Quaterniond>::Cursor cursor;
+	for (int pass = 0; pass < 3; ++pass) {
+		for (int j = 0; j < 1000; ++j) {
+			double s;
+			switch (pass) {
+			case 0: s = spline.initialS() + spline.changeInS() * ((j * 7919) % 1000) / 1000.0; break;
+			case 1: s = spline.initialS() + spline.changeInS() * j / 1000.0; break;
+			default: s = spline.finalS() - spline.changeInS() * j / 1000.0; break;
+			}
+
+			size_t k = 0;
+			while (k < N-2  &&  s >= samples[k+1].get<0>()) {
+				++k;
+			}
+			double t = (s - samples[k].get<0>()) / (samples[k+1].get<0>() - samples[k].get<0>());
+			Eigen::Quaterniond expected = samples[k].get<1>().slerp(t, samples[k+1].get<1>());
+
+			EXPECT_TRUE(expected.coeffs().isApprox(spline.eval(s).coeffs(), 1e-12));
+			EXPECT_TRUE(expected.coeffs().isApprox(spline.eval(s, &cursor).coeffs(), 1e-12));
+		}
+	}
+
+	EXPECT_EQ(samples.front().get<1>().coeffs(), spline.eval(-1.0).coeffs());
+	EXPECT_EQ(samples.back().get<1>().coeffs(), spline.eval(100.0, &cursor).coeffs());
+}
+
 
 }
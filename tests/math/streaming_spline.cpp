@@ -0,0 +1,177 @@
+/*
+ * streaming_spline.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include <boost/tuple/tuple.hpp>
+
+#define EIGEN_USE_NEW_STDVECTOR
+#include <Eigen/StdVector>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/streaming_spline.h>
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+typedef units::JointPositions<DOF>::type jp_type;
+
+
+jp_type sample(double s) {
+	jp_type jp;
+	for (size_t i = 0; i < DOF; ++i) {
+		jp[i] = std::sin(2.0 * s + i) + 0.1 * s;
+	}
+	return jp;
+}
+
+
+TEST(StreamingSplineTest, SingleSample) {
+	math::StreamingSpline<jp_type> spline;
+	jp_type jp(1.5);
+
+	EXPECT_TRUE(spline.add(2.0, jp));
+	EXPECT_FALSE(spline.isReady());
+	EXPECT_TRUE(spline.finish());
+	EXPECT_TRUE(spline.isReady());
+	EXPECT_TRUE(spline.isFinished());
+
+	EXPECT_EQ(2.0, spline.initialS());
+	EXPECT_EQ(2.0, spline.finalS());
+	EXPECT_EQ(jp, spline.eval(1.0));
+	EXPECT_EQ(jp, spline.eval(3.0));
+}
+
+TEST(StreamingSplineTest, Linear) {
+	math::StreamingSpline<jp_type> spline(32, 4);
+	for (int k = 0; k < 20; ++k) {
+		EXPECT_TRUE(spline.add(0.1 * k, jp_type(0.3 * k)));
+	}
+	EXPECT_TRUE(spline.finish());
+
+	jp_type p, v, a;
+	for (double s = 0.0; s <= 1.9; s += 0.013) {
+		spline.eval(s, &p, &v, &a);
+		for (size_t i = 0; i < DOF; ++i) {
+			EXPECT_NEAR(3.0 * s, p[i], 1e-12);
+			EXPECT_NEAR(3.0, v[i], 1e-10);
+			EXPECT_NEAR(0.0, a[i], 1e-8);
+		}
+	}
+}
+
+TEST(StreamingSplineTest, MatchesSpline) {
+	typedef math::Spline<jp_type>::tuple_type tuple_type;
+	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > samples;
+
+	const size_t N = 200;
+	math::StreamingSpline<jp_type> streaming(N);
+	for (size_t k = 0; k < N; ++k) {
+		double s = 0.05 * k + 0.01 * std::sin(double(k));  // uneven spacing
+		samples.push_back(boost::make_tuple(s, sample(s)));
+		EXPECT_TRUE(streaming.add(samples.back()));
+	}
+	EXPECT_TRUE(streaming.finish());
+
+	math::Spline<jp_type> spline(samples);
+	EXPECT_DOUBLE_EQ(spline.initialS(), streaming.initialS());
+	EXPECT_DOUBLE_EQ(spline.finalS(), streaming.finalS());
+
+	for (double s = spline.initialS(); s <= spline.finalS(); s += 0.0037) {
+		jp_type expected = spline.eval(s);
+		jp_type actual = streaming.eval(s);
+		for (size_t i = 0; i < DOF; ++i) {
+			EXPECT_NEAR(expected[i], actual[i], 1e-5);
+		}
+	}
+}
+
+TEST(StreamingSplineTest, ContinuousAtKnots) {
+	math::StreamingSpline<jp_type> spline;
+	std::vector<double> knots;
+	for (size_t k = 0; k < 40; ++k) {
+		knots.push_back(0.1 * k + 0.03 * (k % 3));
+		EXPECT_TRUE(spline.add(knots.back(), sample(knots.back())));
+	}
+	EXPECT_TRUE(spline.finish());
+
+	const double eps = 1e-9;
+	for (size_t k = 1; k < knots.size() - 1; ++k) {
+		jp_type pl, vl, al, pr, vr, ar;
+		spline.eval(knots[k] - eps, &pl, &vl, &al);
+		spline.eval(knots[k] + eps, &pr, &vr, &ar);
+		for (size_t i = 0; i < DOF; ++i) {
+			EXPECT_NEAR(sample(knots[k])[i], pr[i], 1e-8);
+			EXPECT_NEAR(pl[i], pr[i], 1e-7);
+			EXPECT_NEAR(vl[i], vr[i], 1e-6);
+			EXPECT_NEAR(al[i], ar[i], 1e-3);  // Only approximately C2
+		}
+	}
+}
+
+TEST(StreamingSplineTest, BoundedMemory) {
+	const size_t CAPACITY = 4;
+	const size_t LOOKAHEAD = 2;
+	math::StreamingSpline<jp_type> spline(CAPACITY, LOOKAHEAD);
+
+	// The first segment is finalized by the (LOOKAHEAD + 2)th sample.
+	size_t k = 0;
+	while (spline.add(0.1 * k, sample(0.1 * k))) {
+		++k;
+	}
+	EXPECT_EQ(CAPACITY + LOOKAHEAD + 1, k);
+	EXPECT_TRUE(spline.isReady());
+	EXPECT_FALSE(spline.isFinished());
+	EXPECT_DOUBLE_EQ(0.1 * CAPACITY, spline.availableS());
+	EXPECT_FALSE(spline.finish());
+
+	// Holds the last finalized position until more is available
+	jp_type p = spline.eval(0.1 * (CAPACITY + 1));
+	for (size_t i = 0; i < DOF; ++i) {
+		EXPECT_NEAR(sample(0.1 * CAPACITY)[i], p[i], 1e-12);
+	}
+
+	// Evaluating releases the earlier segments.
+	EXPECT_TRUE(spline.add(0.1 * k, sample(0.1 * k)));
+	++k;
+	for (; k < 1000; ++k) {
+		spline.eval(spline.availableS());
+		EXPECT_TRUE(spline.add(0.1 * k, sample(0.1 * k)));
+	}
+	EXPECT_TRUE(spline.finish());
+	EXPECT_DOUBLE_EQ(0.1 * (k-1), spline.finalS());
+
+	p = spline.eval(spline.finalS());
+	for (size_t i = 0; i < DOF; ++i) {
+		EXPECT_NEAR(sample(0.1 * (k-1))[i], p[i], 1e-12);
+	}
+
+	spline.clear();
+	EXPECT_FALSE(spline.isReady());
+	EXPECT_TRUE(spline.add(5.0, sample(5.0)));
+	EXPECT_EQ(5.0, spline.initialS());
+}
+
+TEST(StreamingSplineTest, Throws) {
+	math::StreamingSpline<jp_type> spline;
+
+	EXPECT_TRUE(spline.add(1.0, sample(1.0)));
+	EXPECT_THROW(spline.add(1.0, sample(1.0)), std::logic_error);
+	EXPECT_TRUE(spline.finish());
+	EXPECT_THROW(spline.add(2.0, sample(2.0)), std::logic_error);
+
+	EXPECT_THROW(math::StreamingSpline<jp_type>(0), std::logic_error);
+}
+
+
+}
@@ -0,0 +1,154 @@
+/*
+ * trajectory_validator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <libconfig.h++>
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/trajectory_validator.h>
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 7;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+typedef math::TrajectoryValidator<DOF> validator_type;
+
+
+jp_type start() {
+	jp_type jp;
+	jp << 0.0, 1.0, 0.0, 1.5, 0.0, 0.0, 0.0;
+	return jp;
+}
+
+jp_type still(double t) {
+	return start();
+}
+
+// A smooth swing of the shoulder and elbow, lasting 1 second
+jp_type swing(double t) {
+	jp_type amplitude;
+	amplitude << 1.0, 0.5, 0.0, 1.0, 0.0, 0.0, 0.0;
+	return start() + amplitude * (1.0 - std::cos(M_PI * t)) / 2.0;
+}
+
+
+class TrajectoryValidatorTest : public ::testing::Test {
+public:
+	TrajectoryValidatorTest() {
+		config.readFile("test.config");
+	}
+
+protected:
+	libconfig::Config config;
+	validator_type::Limits limits;
+};
+
+
+TEST_F(TrajectoryValidatorTest, StillIsOk) {
+	limits.velocityLimit = 0.1;
+	limits.torqueLimit = 1000.0;
+	validator_type v(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits);
+
+	validator_type::Report r = v.validate(&still, 1.0);
+	EXPECT_TRUE(r.ok());
+	EXPECT_NEAR(0.0, r.maxSpeed, 1e-9);
+	EXPECT_GT(r.maxTorqueRatio, 0.0);  // Gravity
+	EXPECT_EQ(1.0, r.timeScale);
+}
+
+TEST_F(TrajectoryValidatorTest, JointLimit) {
+	limits.upperJointLimit[3] = 2.0;
+	validator_type v(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits);
+
+	validator_type::Report r = v.validate(&swing, 1.0);
+	EXPECT_EQ(validator_type::JOINT_LIMIT, r.violation);
+	EXPECT_EQ(3u, r.index);
+	EXPECT_NEAR(0.5, r.time, v.getSamplePeriod());  // Joint 4 passes 2.0 half way
+	EXPECT_EQ(std::numeric_limits<double>::infinity(), r.timeScale);
+}
+
+TEST_F(TrajectoryValidatorTest, VelocityLimit) {
+	validator_type v(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits);
+	validator_type::Report r = v.validate(&swing, 1.0);
+	EXPECT_TRUE(r.ok());
+	ASSERT_GT(r.maxSpeed, 0.0);
+
+	limits.velocityLimit = r.maxSpeed / 2.0;
+	v.setLimits(limits);
+	r = v.validate(&swing, 1.0);
+	EXPECT_EQ(validator_type::VELOCITY_LIMIT, r.violation);
+	EXPECT_LE(r.index, DOF);
+	EXPECT_NEAR(2.0, r.timeScale, 1e-9);
+
+	r = v.validate(validator_type::timeScaled(&swing, r.timeScale), r.timeScale);
+	EXPECT_NEAR(limits.velocityLimit, r.maxSpeed, 1e-3 * limits.velocityLimit);
+}
+
+TEST_F(TrajectoryValidatorTest, TorqueLimit) {
+	// Without gravity, slowing down by k divides all torques by k^2.
+	limits.torqueLimit = 1.0;
+	validator_type v(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits,
+			0.002, 0, ca_type(0.0));
+	validator_type::Report r = v.validate(&swing, 1.0);
+	ASSERT_GT(r.maxTorqueRatio, 0.0);
+
+	limits.torqueLimit = r.maxTorqueRatio / 4.0;
+	v.setLimits(limits);
+	r = v.validate(&swing, 1.0);
+	EXPECT_EQ(validator_type::TORQUE_LIMIT, r.violation);
+	EXPECT_NEAR(4.0, r.maxTorqueRatio, 1e-9);
+	EXPECT_NEAR(2.0, r.timeScale, 1e-9);
+
+	r = v.validate(validator_type::timeScaled(&swing, r.timeScale), r.timeScale);
+	EXPECT_NEAR(1.0, r.maxTorqueRatio, 1e-2);
+}
+
+TEST_F(TrajectoryValidatorTest, GravityExceedsTorqueLimit) {
+	limits.torqueLimit = 0.01;
+	validator_type v(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits);
+
+	validator_type::Report r = v.validate(&still, 1.0);
+	EXPECT_EQ(validator_type::TORQUE_LIMIT, r.violation);
+	EXPECT_EQ(0.0, r.time);
+	EXPECT_EQ(std::numeric_limits<double>::infinity(), r.timeScale);
+}
+
+TEST_F(TrajectoryValidatorTest, ThreadsAgree) {
+	limits.upperJointLimit[3] = 2.0;
+	limits.velocityLimit = 0.5;
+	limits.torqueLimit = 20.0;
+	validator_type v1(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits, 0.002, 1);
+	validator_type v4(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits, 0.002, 4);
+	EXPECT_EQ(4u, v4.getThreadCount());
+
+	validator_type::Report r1 = v1.validate(&swing, 1.0);
+	validator_type::Report r4 = v4.validate(&swing, 1.0);
+	EXPECT_EQ(r1.violation, r4.violation);
+	EXPECT_EQ(r1.time, r4.time);
+	EXPECT_EQ(r1.index, r4.index);
+	EXPECT_EQ(r1.maxSpeed, r4.maxSpeed);
+	EXPECT_EQ(r1.maxTorqueRatio, r4.maxTorqueRatio);
+	EXPECT_EQ(r1.timeScale, r4.timeScale);
+}
+
+TEST_F(TrajectoryValidatorTest, Throws) {
+	EXPECT_THROW(validator_type(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits, 0.0),
+			std::logic_error);
+
+	validator_type v(config.lookup("wam.kinematics"), config.lookup("wam.dynamics"), limits);
+	EXPECT_THROW(v.validate(&still, -1.0), std::logic_error);
+}
+
+
+}
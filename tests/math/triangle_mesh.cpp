@@ -0,0 +1,208 @@
+/*
+ * triangle_mesh.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/math/triangle_mesh.h>
+
+
+namespace {
+using namespace barrett;
+
+typedef math::TriangleMesh::vector_type vector_type;
+typedef math::TriangleMesh::Triangle Triangle;
+
+
+double random(double low, double high) {
+	return low + (high - low) * std::rand() / RAND_MAX;
+}
+
+vector_type randomPoint(double range) {
+	return vector_type(random(-range, range), random(-range, range), random(-range, range));
+}
+
+
+const double HALF_SIZE = 0.1;
+
+// A cube centered on the origin, as quads with outward-facing (counterclockwise) corners
+const int QUADS[6][4] = {
+	{0, 2, 3, 1}, {4, 5, 7, 6},  // -z, +z
+	{0, 1, 5, 4}, {2, 6, 7, 3},  // -y, +y
+	{0, 4, 6, 2}, {1, 3, 7, 5},  // -x, +x
+};
+
+vector_type corner(int i) {
+	return HALF_SIZE * vector_type((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1);
+}
+
+// Triangle soup, as an STL file would have it
+void cube(std::vector<vector_type>* v, std::vector<Triangle>* t) {
+	for (int q = 0; q < 6; ++q) {
+		const int tri[2][3] = { {QUADS[q][0], QUADS[q][1], QUADS[q][2]}, {QUADS[q][0], QUADS[q][2], QUADS[q][3]} };
+		for (int j = 0; j < 2; ++j) {
+			for (int k = 0; k < 3; ++k) {
+				v->push_back(corner(tri[j][k]));
+			}
+			t->push_back(Triangle(v->size() - 3, v->size() - 2, v->size() - 1));
+		}
+	}
+}
+
+// Compares a mesh of the cube against the analytic answer.
+void expectCube(const math::TriangleMesh& mesh) {
+	EXPECT_EQ(8u, mesh.getVertices().size());
+	EXPECT_EQ(12u, mesh.getTriangles().size());
+
+	std::srand(3);
+	double depth;
+	vector_type dir;
+	for (size_t j = 0; j < 2000; ++j) {
+		vector_type p = randomPoint(2.0 * HALF_SIZE);
+		vector_type inside = vector_type::Constant(HALF_SIZE) - p.cwiseAbs();
+
+		if ((inside.array() <= 0.0).any()) {
+			EXPECT_FALSE(mesh.penetration(p, HALF_SIZE, &depth, &dir));
+		} else {
+			int index;
+			double expectedDepth = inside.minCoeff(&index);
+			vector_type expectedDir = vector_type::Unit(index) * (p[index] > 0.0 ? 1.0 : -1.0);
+
+			ASSERT_TRUE(mesh.penetration(p, HALF_SIZE, &depth, &dir));
+			EXPECT_NEAR(expectedDepth, depth, 1e-12);
+			EXPECT_TRUE((expectedDir - dir).norm() < 1e-9);
+		}
+	}
+}
+
+void writeFile(const std::string& fileName, const std::string& contents) {
+	std::ofstream file(fileName.c_str(), std::ios_base::binary);
+	file << contents;
+}
+
+
+TEST(TriangleMeshTest, Cube) {
+	std::vector<vector_type> v;
+	std::vector<Triangle> t;
+	cube(&v, &t);
+	math::TriangleMesh mesh(v, t);
+	expectCube(mesh);
+
+	EXPECT_TRUE(mesh.getBounds().min.isApprox(corner(0)));
+	EXPECT_TRUE(mesh.getBounds().max.isApprox(corner(7)));
+}
+
+TEST(TriangleMeshTest, Edges) {
+	std::vector<vector_type> v;
+	std::vector<Triangle> t;
+	cube(&v, &t);
+	math::TriangleMesh mesh(v, t);
+
+	// Just outside an edge and a corner, the nearest points are on an edge
+	// and a vertex, where the face normals disagree.
+	double depth;
+	vector_type dir;
+	EXPECT_FALSE(mesh.penetration(vector_type(0.0, 0.101, 0.1001), 0.05, &depth, &dir));
+	EXPECT_FALSE(mesh.penetration(vector_type(0.1001, 0.101, 0.1001), 0.05, &depth, &dir));
+
+	// Pushed through
+	EXPECT_FALSE(mesh.penetration(vector_type(0.0, 0.0, 0.0), 0.05, &depth, &dir));
+	EXPECT_TRUE(mesh.penetration(vector_type(0.0, 0.0, 0.06), 0.05, &depth, &dir));
+	EXPECT_NEAR(0.04, depth, 1e-12);
+}
+
+TEST(TriangleMeshTest, Obj) {
+	std::string obj = "# cube\no cube\n";
+	for (int i = 0; i < 8; ++i) {
+		char line[100];
+		std::sprintf(line, "v %.17g %.17g %.17g\n", corner(i)[0], corner(i)[1], corner(i)[2]);
+		obj += line;
+	}
+	obj += "vn 0 0 1\n";
+	for (int q = 0; q < 6; ++q) {
+		char line[100];
+		// Quads, with a mix of index formats
+		std::sprintf(line, "f %d//1 %d %d/1/1 %d\n",
+				QUADS[q][0] + 1, QUADS[q][1] + 1, QUADS[q][2] - 8, QUADS[q][3] + 1);
+		obj += line;
+	}
+
+	writeFile("triangle_mesh_test.obj", obj);
+	math::TriangleMesh mesh("triangle_mesh_test.obj");
+	std::remove("triangle_mesh_test.obj");
+	expectCube(mesh);
+}
+
+TEST(TriangleMeshTest, Stl) {
+	std::vector<vector_type> v;
+	std::vector<Triangle> t;
+	cube(&v, &t);
+
+	// In millimeters
+	std::string ascii = "solid cube\n";
+	std::string binary(80, ' ');
+	binary.replace(0, 10, "solid cube");
+	unsigned char count[4] = {static_cast<unsigned char>(t.size()), 0, 0, 0};
+	binary.append(reinterpret_cast<char*>(count), 4);
+	for (size_t i = 0; i < t.size(); ++i) {
+		ascii += "facet normal 0 0 0\n outer loop\n";
+		binary.append(12, '\0');
+		for (size_t j = 0; j < 3; ++j) {
+			const vector_type& p = v[t[i].v[j]];
+			char line[100];
+			std::sprintf(line, "  vertex %g %g %g\n", 1000.0 * p[0], 1000.0 * p[1], 1000.0 * p[2]);
+			ascii += line;
+
+			for (size_t k = 0; k < 3; ++k) {
+				float f = 1000.0 * p[k];
+				unsigned char bytes[4];
+				std::memcpy(bytes, &f, 4);  // The tests only run on little-endian hosts
+				binary.append(reinterpret_cast<char*>(bytes), 4);
+			}
+		}
+		binary.append(2, '\0');
+		ascii += " endloop\nendfacet\n";
+	}
+	ascii += "endsolid cube\n";
+
+	writeFile("triangle_mesh_test.stl", ascii);
+	math::TriangleMesh asciiMesh("triangle_mesh_test.stl", 0.001);
+	expectCube(asciiMesh);
+
+	writeFile("triangle_mesh_test.STL", binary);
+	math::TriangleMesh binaryMesh("triangle_mesh_test.STL", 0.001);
+	expectCube(binaryMesh);
+
+	std::remove("triangle_mesh_test.stl");
+	std::remove("triangle_mesh_test.STL");
+}
+
+TEST(TriangleMeshTest, Throws) {
+	EXPECT_THROW(math::TriangleMesh("does_not_exist.stl"), std::runtime_error);
+
+	writeFile("triangle_mesh_test.ply", "ply\n");
+	EXPECT_THROW(math::TriangleMesh("triangle_mesh_test.ply"), std::runtime_error);
+	std::remove("triangle_mesh_test.ply");
+
+	writeFile("triangle_mesh_test.obj", "v 0 0 0\nv 1 0 0\nf 1 2 3\n");
+	EXPECT_THROW(math::TriangleMesh("triangle_mesh_test.obj"), std::runtime_error);
+	std::remove("triangle_mesh_test.obj");
+
+	std::vector<vector_type> v(2, vector_type::Zero());
+	std::vector<Triangle> t(1, Triangle(0, 1, 2));
+	EXPECT_THROW(math::TriangleMesh(v, t), std::logic_error);
+}
+
+
+}
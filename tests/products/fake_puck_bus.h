@@ -0,0 +1,155 @@
+/*
+ * fake_puck_bus.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef FAKE_PUCK_BUS_H_
+#define FAKE_PUCK_BUS_H_
+
+
+#include <map>
+#include <vector>
+#include <deque>
+#include <cstring>
+
+#include <barrett/os.h>
+#include <barrett/thread/null_mutex.h>
+#include <barrett/bus/abstract/communications_bus.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_group.h>
+
+
+// A bus with Pucks on it. Each Puck replies to a GET request with the value
+// stored for the requested property ID, if there is one. A request sent to a
+// group is answered by each of the group's members. Each reply is stamped with
+// the current value of clock, which then advances by REPLY_INTERVAL. If
+// txQueueLength is positive, sends fail once that many requests have been sent
+// without a receive or a pause of Puck::TX_QUEUE_DRAIN_TIME in between, like a
+// burst that overflows SocketCAN's transmit queue. A Puck given a position
+// with setPosition() answers a GET of that property in the 3-byte format
+// MotorPuck::MotorPositionParser expects, on PuckGroup::FGRP_MOTOR_POSITION.
+class FakePuckBus : public barrett::bus::CommunicationsBus {
+public:
+	FakePuckBus() :
+		requests(0), requestsBeforeFirstReceive(-1), clock(1.0), txQueueLength(0),
+		queued(0), queueStart(0.0), lastReceiveTime(0.0) {}
+
+	void setValue(int id, int propId, int value) {
+		values[id][propId] = value;
+	}
+	void setPosition(int id, int propId, int counts) {
+		positions[id][propId] = counts;
+	}
+	void setGroup(int groupId, const std::vector<int>& ids) {
+		groups[groupId] = ids;
+	}
+
+	virtual barrett::thread::Mutex& getMutex() const { return barrett::thread::NullMutex::aNullMutex; }
+
+	virtual void open(int port) {}
+	virtual void close() {}
+	virtual bool isOpen() const { return true; }
+
+	virtual int send(int busId, const unsigned char* data, size_t len) const {
+		int fromId, toId;
+		barrett::Puck::decodeBusId(busId, &fromId, &toId);
+		int propId = data[0] & barrett::Puck::PROPERTY_MASK;
+		double now = barrett::highResolutionSystemTime();
+		if (now - queueStart >= barrett::Puck::TX_QUEUE_DRAIN_TIME) {
+			queued = 0;
+		}
+		if (txQueueLength > 0  &&  queued >= txQueueLength) {
+			return 2;  // ENOBUFS
+		}
+		if (queued == 0) {
+			queueStart = now;
+		}
+		++queued;
+		++requests;
+
+		if (len == 1) {
+			++getRequests[propId];
+			if (groups.count(toId)) {
+				for (size_t i = 0; i < groups[toId].size(); ++i) {
+					reply(groups[toId][i], propId);
+				}
+			} else {
+				reply(toId, propId);
+			}
+		}
+		return 0;
+	}
+
+	virtual int receiveRaw(int& busId, unsigned char* data, size_t& len, bool blocking = true) const {
+		if (requestsBeforeFirstReceive == -1) {
+			requestsBeforeFirstReceive = requests;
+		}
+		queued = 0;
+		if (replies.empty()) {
+			return 1;
+		}
+
+		busId = replies.front().busId;
+		len = replies.front().len;
+		memcpy(data, replies.front().data, len);
+		lastReceiveTime = replies.front().time;
+		replies.pop_front();
+		return 0;
+	}
+
+	virtual double getLastReceiveTime() const { return lastReceiveTime; }
+
+	static constexpr double REPLY_INTERVAL = 0.001;
+
+	mutable int requests;
+	mutable int requestsBeforeFirstReceive;
+	mutable std::map<int, int> getRequests;  // GET requests sent, by property ID
+	mutable double clock;
+	int txQueueLength;
+
+protected:
+	struct Reply {
+		int busId;
+		unsigned char data[6];
+		size_t len;
+		double time;
+	};
+
+	void reply(int id, int propId) const {
+		Reply r;
+		if (positions.count(id)  &&  positions[id].count(propId)) {
+			int counts = positions[id][propId];
+			r.busId = barrett::Puck::encodeBusId(id, barrett::PuckGroup::FGRP_MOTOR_POSITION);
+			r.data[0] = (counts >> 16) & 0x3f;
+			r.data[1] = (counts >> 8) & 0xff;
+			r.data[2] = counts & 0xff;
+			r.len = 3;
+		} else if (values.count(id)  &&  values[id].count(propId)) {
+			int value = values[id][propId];
+			r.busId = barrett::Puck::encodeBusId(id, barrett::PuckGroup::FGRP_OTHER);
+			r.data[0] = propId | barrett::Puck::SET_MASK;
+			r.data[1] = 0;
+			for (int i = 0; i < 4; ++i) {
+				r.data[i + 2] = (value >> (8 * i)) & 0xff;
+			}
+			r.len = 6;
+		} else {
+			return;
+		}
+		r.time = clock;
+		clock += REPLY_INTERVAL;
+		replies.push_back(r);
+	}
+
+	mutable std::map<int, std::map<int, int> > values;
+	mutable std::map<int, std::map<int, int> > positions;
+	mutable std::map<int, std::vector<int> > groups;
+	mutable std::deque<Reply> replies;
+	mutable int queued;
+	mutable double queueStart;
+	mutable double lastReceiveTime;
+};
+
+
+#endif /* FAKE_PUCK_BUS_H_ */
@@ -0,0 +1,128 @@
+/*
+ * low_level_wam.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <libconfig.h++>
+
+#include <gtest/gtest.h>
+#include <barrett/units.h>
+#include <barrett/bus/bus_manager.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_group.h>
+#include <barrett/products/low_level_wam.h>
+
+#include "fake_puck_bus.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 7;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const int CTS = 4096;
+
+class LowLevelWamTest : public ::testing::Test {
+public:
+	LowLevelWamTest() :
+		bus(&fakeBus), wam(NULL), positionPropId(-1)
+	{
+		std::vector<int> ids;
+		for (size_t i = 0; i < DOF; ++i) {
+			int id = 1 + i;
+			ids.push_back(id);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), 0x0000);  // ROLE_TATER
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), 200);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 200), 2);
+			pucks.push_back(new Puck(bus, id));
+
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::CTS), CTS);
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::IPNM), 2000);
+		}
+		fakeBus.setGroup(PuckGroup::BGRP_WAM, ids);
+
+		positionPropId = pucks[0]->getPropertyId(Puck::P);
+		setCounts(0);
+
+		libconfig::Config config;
+		config.readFile("test.config");
+		wam = new LowLevelWam<DOF>(pucks, NULL, config.lookup("wam.low_level"));
+	}
+	~LowLevelWamTest() {
+		delete wam;
+		for (size_t i = 0; i < pucks.size(); ++i) {
+			delete pucks[i];
+		}
+	}
+
+	// Gives each Puck a different position, some of them negative.
+	void setCounts(int offset) {
+		for (size_t i = 0; i < DOF; ++i) {
+			int c = offset + 1000 * (static_cast<int>(i) - 3);
+			counts[i] = c;
+			fakeBus.setPosition(pucks[i]->getId(), positionPropId, c);
+		}
+	}
+
+	jp_type expectedPosition() const {
+		return wam->getMotorToJointPositionTransform() * (counts * (2*M_PI / CTS));
+	}
+
+	int positionRequests() const {
+		return fakeBus.getRequests[positionPropId];
+	}
+
+protected:
+	FakePuckBus fakeBus;
+	bus::BusManager bus;
+	std::vector<Puck*> pucks;
+	LowLevelWam<DOF>* wam;
+	int positionPropId;
+	v_type counts;
+};
+
+
+TEST_F(LowLevelWamTest, UpdateRequestsAndDecodesPositions) {
+	for (int cycle = 1; cycle <= 5; ++cycle) {
+		setCounts(37 * cycle);
+		int requests = positionRequests();
+
+		wam->update();
+		EXPECT_EQ(requests + 1, positionRequests());
+		EXPECT_TRUE(wam->getJointPositions().isApprox(expectedPosition(), 1e-12));
+	}
+}
+
+TEST_F(LowLevelWamTest, RequestUpdateSendsTheRequestForTheNextUpdate) {
+	for (int cycle = 1; cycle <= 5; ++cycle) {
+		setCounts(37 * cycle);
+		jp_type expected = expectedPosition();
+		int requests = positionRequests();
+
+		wam->requestUpdate();
+		wam->requestUpdate();  // Already outstanding: does nothing
+		EXPECT_EQ(requests + 1, positionRequests());
+
+		// The Pucks answered when the request went out, so update() must
+		// collect that answer rather than ask again.
+		setCounts(-37 * cycle);
+		wam->update();
+		EXPECT_EQ(requests + 1, positionRequests());
+		EXPECT_TRUE(wam->getJointPositions().isApprox(expected, 1e-12));
+	}
+
+	// Without requestUpdate(), update() goes back to sending its own request.
+	int requests = positionRequests();
+	wam->update();
+	EXPECT_EQ(requests + 1, positionRequests());
+	EXPECT_TRUE(wam->getJointPositions().isApprox(expectedPosition(), 1e-12));
+}
+
+
+}
@@ -7,9 +7,14 @@
 
 
 #include <stdexcept>
+#include <vector>
 #include <gtest/gtest.h>
+#include <barrett/os.h>
+#include <barrett/bus/bus_manager.h>
 #include <barrett/products/puck.h>
 
+#include "fake_puck_bus.h"
+
 
 namespace {
 using namespace barrett;
@@ -68,5 +73,123 @@ TEST(PuckTest, GetPropertyEnumTest) {
 	EXPECT_THROW(Puck::getPropertyEnum("omgthispropertynameisreallyreallylong"), std::invalid_argument);
 }
 
+TEST(PuckTest, TryGetPropertyFromManyPucks) {
+	FakePuckBus fakeBus;
+	bus::BusManager bus(&fakeBus);
+	int statId = Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 0);
+	fakeBus.setValue(2, statId, 2);
+	fakeBus.setValue(5, statId, 0);
+
+	std::vector<int> ids;
+	for (int id = 1; id <= 6; ++id) {
+		ids.push_back(id);
+	}
+	std::vector<int> results;
+	std::vector<int> rets = Puck::tryGetProperty(bus, ids, statId, &results, 0.0);
+
+	// Every request goes out before any reply is read.
+	EXPECT_EQ(6, fakeBus.requestsBeforeFirstReceive);
+
+	ASSERT_EQ(6u, rets.size());
+	ASSERT_EQ(6u, results.size());
+	EXPECT_EQ(1, rets[0]);
+	EXPECT_EQ(0, rets[1]);
+	EXPECT_EQ(2, results[1]);
+	EXPECT_EQ(1, rets[2]);
+	EXPECT_EQ(1, rets[3]);
+	EXPECT_EQ(0, rets[4]);
+	EXPECT_EQ(0, results[4]);
+	EXPECT_EQ(1, rets[5]);
+}
+
+TEST(PuckTest, TryGetPropertyFromWholeBus) {
+	FakePuckBus fakeBus;
+	fakeBus.txQueueLength = 10;
+	bus::BusManager bus(&fakeBus);
+	int statId = Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 0);
+
+	std::vector<int> ids;
+	for (int id = Puck::MIN_ID; id <= Puck::MAX_ID; ++id) {
+		fakeBus.setValue(id, statId, 2);
+		ids.push_back(id);
+	}
+	std::vector<int> results;
+	const double timeout = 0.02;
+	double start = highResolutionSystemTime();
+	std::vector<int> rets = Puck::tryGetProperty(bus, ids, statId, &results, timeout);
+	double elapsed = highResolutionSystemTime() - start;
+
+	// The requests go out in batches that fit in the transmit queue, and all
+	// of the replies are collected after a single timeout.
+	EXPECT_EQ((int) ids.size(), fakeBus.requestsBeforeFirstReceive);
+	EXPECT_EQ((int) ids.size(), fakeBus.requests);
+	EXPECT_GE(elapsed, timeout);
+	EXPECT_LT(elapsed, 1.5 * timeout);
+	for (size_t i = 0; i < ids.size(); ++i) {
+		EXPECT_EQ(0, rets[i]);
+		EXPECT_EQ(2, results[i]);
+	}
+}
+
+TEST(PuckTest, UpdateRoleAndStatus) {
+	FakePuckBus fakeBus;
+	bus::BusManager bus(&fakeBus);
+
+	// A Motor Puck that is awake and a Safety Puck that isn't
+	const int vers[] = { 200, 150 };
+	const int ids[] = { 1, 10 };
+	const int roles[] = { 0x0100, 0x0002 };
+	const int stats[] = { 2, 0 };
+	std::vector<Puck*> pucks;
+	for (int i = 0; i < 2; ++i) {
+		fakeBus.setValue(ids[i], Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), roles[i]);
+		fakeBus.setValue(ids[i], Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), vers[i]);
+		fakeBus.setValue(ids[i], Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, vers[i]), stats[i]);
+
+		pucks.push_back(new Puck(bus, ids[i], false));
+		EXPECT_EQ(0, fakeBus.requests);
+		EXPECT_EQ(-1, pucks[i]->getVers());
+		EXPECT_EQ(Puck::PT_Unknown, pucks[i]->getType());
+	}
+
+	Puck::updateRoleAndStatus(pucks);
+	EXPECT_EQ(2, fakeBus.requestsBeforeFirstReceive);
+	EXPECT_EQ(6, fakeBus.requests);
+
+	EXPECT_EQ(0x0100, pucks[0]->getRole());
+	EXPECT_EQ(200, pucks[0]->getVers());
+	EXPECT_TRUE(pucks[0]->hasOption(Puck::RO_MagEncOnSerial));
+	EXPECT_EQ(Puck::PT_Motor, pucks[0]->getType());
+	EXPECT_EQ(Puck::PT_Motor, pucks[0]->getEffectiveType());
+
+	EXPECT_EQ(150, pucks[1]->getVers());
+	EXPECT_EQ(Puck::PT_Safety, pucks[1]->getType());
+	EXPECT_EQ(Puck::PT_Monitor, pucks[1]->getEffectiveType());
+
+	delete pucks[0];
+	delete pucks[1];
+}
+
+TEST(PuckTest, UpdateRoleAndStatusOfManyPucks) {
+	FakePuckBus fakeBus;
+	fakeBus.txQueueLength = 10;
+	bus::BusManager bus(&fakeBus);
+
+	std::vector<Puck*> pucks;
+	for (int id = 1; id <= 20; ++id) {
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), 0x0100);
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), 200);
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 200), 2);
+		pucks.push_back(new Puck(bus, id, false));
+	}
+
+	Puck::updateRoleAndStatus(pucks);
+	EXPECT_EQ(3 * 20, fakeBus.requests);
+	for (size_t i = 0; i < pucks.size(); ++i) {
+		EXPECT_EQ(Puck::PT_Motor, pucks[i]->getEffectiveType());
+		delete pucks[i];
+	}
+}
+
 
 }
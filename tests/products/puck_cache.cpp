@@ -0,0 +1,193 @@
+/*
+ * puck_cache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <barrett/bus/bus_manager.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_cache.h>
+
+#include "fake_puck_bus.h"
+
+
+namespace {
+using namespace barrett;
+
+
+class PuckCacheTest : public ::testing::Test {
+public:
+	PuckCacheTest() :
+		bus(&fakeBus)
+	{
+		// A Motor Puck and a Safety Puck, both awake
+		setPuck(0, 1, 1234, 200, 0x0100);
+		setPuck(1, 10, 5678, 150, 0x0002);
+		fakeBus.setValue(ids[0], Puck::getPropertyId(Puck::CTS, Puck::PT_Motor, 200), 4096);
+	}
+
+	virtual void SetUp() {
+		strcpy(fileName, "/tmp/btXXXXXX");
+		ASSERT_TRUE(mkstemp(fileName) != -1);
+	}
+	virtual void TearDown() {
+		std::remove(fileName);
+	}
+
+protected:
+	void setPuck(int i, int id, int sn, int vers, int role) {
+		ids[i] = id;
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::SN, Puck::PT_Unknown, -1), sn);
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), vers);
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), role);
+		fakeBus.setValue(id, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, vers), 2);
+	}
+
+	// Enumerates the Pucks the way ProductManager does, returning the number of requests.
+	int enumerate(PuckCache* cache, std::vector<Puck*>* pucks) {
+		for (int i = 0; i < 2; ++i) {
+			pucks->push_back(new Puck(bus, ids[i], false));
+		}
+
+		int before = fakeBus.requests;
+		cache->validate(*pucks);
+		Puck::updateRoleAndStatus(*pucks);
+		cache->save();
+		return fakeBus.requests - before;
+	}
+
+	void purge(std::vector<Puck*>* pucks) {
+		for (size_t i = 0; i < pucks->size(); ++i) {
+			delete (*pucks)[i];
+		}
+		pucks->clear();
+	}
+
+	FakePuckBus fakeBus;
+	bus::BusManager bus;
+	int ids[2];
+	char fileName[16];
+};
+
+
+TEST_F(PuckCacheTest, ColdThenWarm) {
+	std::vector<Puck*> pucks;
+	{
+		PuckCache cache(fileName);
+		EXPECT_EQ(2*5, enumerate(&cache, &pucks));  // SN, VERS, ROLE, VERS, STAT
+		EXPECT_EQ(&cache, pucks[0]->getCache());
+		EXPECT_EQ(4096, pucks[0]->getCachedProperty(Puck::CTS));
+		EXPECT_EQ(2*5 + 1, fakeBus.requests);
+		purge(&pucks);
+	}
+
+	PuckCache cache(fileName);
+	EXPECT_TRUE(cache.hasProperty(ids[0], Puck::CTS));
+	EXPECT_EQ(2*3, enumerate(&cache, &pucks));  // SN, VERS, STAT
+
+	EXPECT_EQ(0x0100, pucks[0]->getRole());
+	EXPECT_EQ(200, pucks[0]->getVers());
+	EXPECT_EQ(Puck::PT_Motor, pucks[0]->getEffectiveType());
+	EXPECT_EQ(0x0002, pucks[1]->getRole());
+	EXPECT_EQ(150, pucks[1]->getVers());
+	EXPECT_EQ(Puck::PT_Safety, pucks[1]->getEffectiveType());
+
+	int requests = fakeBus.requests;
+	EXPECT_TRUE(pucks[0]->isPropertyCached(Puck::CTS));
+	EXPECT_EQ(4096, pucks[0]->getCachedProperty(Puck::CTS));
+	EXPECT_EQ(requests, fakeBus.requests);
+
+	purge(&pucks);
+}
+
+TEST_F(PuckCacheTest, ChangedPuckIsReread) {
+	std::vector<Puck*> pucks;
+	{
+		PuckCache cache(fileName);
+		enumerate(&cache, &pucks);
+		pucks[0]->getCachedProperty(Puck::CTS);
+		purge(&pucks);
+	}
+
+	// New firmware on one Puck, and a new Puck in place of the other
+	setPuck(0, 1, 1234, 201, 0x0100);
+	fakeBus.setValue(ids[0], Puck::getPropertyId(Puck::CTS, Puck::PT_Motor, 201), 4096);
+	setPuck(1, 10, 9999, 150, 0x0002);
+
+	PuckCache cache(fileName);
+	EXPECT_EQ(2*5, enumerate(&cache, &pucks));
+	EXPECT_EQ(201, pucks[0]->getVers());
+	EXPECT_FALSE(pucks[0]->isPropertyCached(Puck::CTS));
+	purge(&pucks);
+}
+
+TEST_F(PuckCacheTest, UnattachedPucksAreUnaffected) {
+	Puck p(bus, ids[0], false);
+	EXPECT_EQ(NULL, p.getCache());
+	p.updateRole();
+	p.updateStatus();
+	EXPECT_FALSE(p.isPropertyCached(Puck::CTS));
+	EXPECT_EQ(4096, p.getCachedProperty(Puck::CTS));
+	int requests = fakeBus.requests;
+	EXPECT_EQ(4096, p.getCachedProperty(Puck::CTS));
+	EXPECT_EQ(requests + 1, fakeBus.requests);
+}
+
+TEST_F(PuckCacheTest, BadFileIsIgnored) {
+	{
+		std::ofstream file(fileName);
+		file << "# comment\n";
+		file << "1 1234\n";
+		file << "10 5678 150 NOTAPROPERTY=3\n";
+		file << "garbage\n";
+	}
+
+	PuckCache cache(fileName);
+	std::vector<Puck*> pucks;
+	EXPECT_EQ(2*5, enumerate(&cache, &pucks));
+	purge(&pucks);
+}
+
+TEST_F(PuckCacheTest, Clear) {
+	PuckCache cache(fileName);
+	std::vector<Puck*> pucks;
+	enumerate(&cache, &pucks);
+	EXPECT_TRUE(cache.hasProperty(ids[0], Puck::ROLE));
+
+	cache.clear();
+	EXPECT_FALSE(cache.hasProperty(ids[0], Puck::ROLE));
+	cache.setProperty(ids[0], Puck::ROLE, 3);  // Ignored: not validated
+	EXPECT_FALSE(cache.hasProperty(ids[0], Puck::ROLE));
+	purge(&pucks);
+}
+
+TEST_F(PuckCacheTest, ManyPucks) {
+	fakeBus.txQueueLength = 10;
+
+	std::vector<Puck*> pucks;
+	for (int id = 1; id <= 12; ++id) {
+		setPuck(0, id, 1000 + id, 200, 0x0100);
+		pucks.push_back(new Puck(bus, id, false));
+	}
+
+	PuckCache cache(fileName);
+	cache.validate(pucks);
+	Puck::updateRoleAndStatus(pucks);
+	for (size_t i = 0; i < pucks.size(); ++i) {
+		EXPECT_EQ(&cache, pucks[i]->getCache());
+		EXPECT_EQ(200, pucks[i]->getVers());
+	}
+	purge(&pucks);
+}
+
+
+}
@@ -0,0 +1,142 @@
+/*
+ * puck_group.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <barrett/bus/bus_manager.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_group.h>
+
+#include "fake_puck_bus.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const int GROUP_ID = PuckGroup::BGRP_HAND;
+const int NUM_PUCKS = 4;
+
+class PuckGroupTest : public ::testing::Test {
+public:
+	PuckGroupTest() :
+		bus(&fakeBus)
+	{
+		std::vector<int> ids;
+		for (int i = 0; i < NUM_PUCKS; ++i) {
+			int id = 11 + i;
+			ids.push_back(id);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), 0x0005);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), 200);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 200), 2);
+			pucks.push_back(new Puck(bus, id));
+
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::SG), 100 + i);
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::TEMP), 30 + i);
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::MODE), i);
+		}
+		fakeBus.setGroup(GROUP_ID, ids);
+
+		fakeBus.requests = 0;
+		fakeBus.requestsBeforeFirstReceive = -1;
+	}
+	~PuckGroupTest() {
+		for (size_t i = 0; i < pucks.size(); ++i) {
+			delete pucks[i];
+		}
+	}
+
+protected:
+	FakePuckBus fakeBus;
+	bus::BusManager bus;
+	std::vector<Puck*> pucks;
+};
+
+
+TEST_F(PuckGroupTest, GetProperty) {
+	PuckGroup group(GROUP_ID, pucks);
+	int results[NUM_PUCKS];
+	group.getProperty(Puck::SG, results);
+	for (int i = 0; i < NUM_PUCKS; ++i) {
+		EXPECT_EQ(100 + i, results[i]);
+	}
+	EXPECT_EQ(1, fakeBus.requests);
+}
+
+TEST_F(PuckGroupTest, PropertyBatch) {
+	PuckGroup group(GROUP_ID, pucks);
+	int sg[NUM_PUCKS], temp[NUM_PUCKS], mode[NUM_PUCKS];
+
+	PuckGroup::PropertyBatch batch(group);
+	EXPECT_EQ(0u, batch.size());
+	batch.add(Puck::SG, sg);
+	batch.add<Puck::StandardParser>(Puck::TEMP, temp);
+	batch.add(Puck::MODE, mode);
+	EXPECT_EQ(3u, batch.size());
+
+	batch.update();
+
+	// Every request goes out before any reply is read.
+	EXPECT_EQ(3, fakeBus.requestsBeforeFirstReceive);
+	EXPECT_EQ(3, fakeBus.requests);
+	for (int i = 0; i < NUM_PUCKS; ++i) {
+		EXPECT_EQ(100 + i, sg[i]);
+		EXPECT_EQ(30 + i, temp[i]);
+		EXPECT_EQ(i, mode[i]);
+	}
+
+	// Batches can be reused
+	fakeBus.setValue(11, pucks[0]->getPropertyId(Puck::SG), -5);
+	batch.update();
+	EXPECT_EQ(-5, sg[0]);
+	EXPECT_EQ(6, fakeBus.requests);
+
+	batch.clear();
+	EXPECT_EQ(0u, batch.size());
+	batch.update();
+	EXPECT_EQ(6, fakeBus.requests);
+}
+
+TEST_F(PuckGroupTest, PropertyBatchIsBounded) {
+	PuckGroup group(GROUP_ID, pucks);
+	int results[NUM_PUCKS];
+
+	PuckGroup::PropertyBatch batch(group);
+	for (size_t i = 0; i < PuckGroup::PropertyBatch::MAX_PROPERTIES; ++i) {
+		batch.add(Puck::SG, results);
+	}
+	EXPECT_THROW(batch.add(Puck::SG, results), std::logic_error);
+}
+
+TEST_F(PuckGroupTest, ReceiveTimes) {
+	PuckGroup group(GROUP_ID, pucks);
+	int propId = group.getPropertyId(Puck::SG);
+	int result;
+
+	fakeBus.clock = 5.0;
+	group.sendGetPropertyRequest(propId);
+
+	// Replies that were buffered keep the time at which they arrived.
+	ASSERT_EQ(0, Puck::receiveGetPropertyReply<Puck::StandardParser>(bus, 13, propId, &result, true, false));
+	EXPECT_EQ(102, result);
+	EXPECT_DOUBLE_EQ(5.0 + 2*FakePuckBus::REPLY_INTERVAL, bus.getLastReceiveTime());
+	ASSERT_EQ(0, Puck::receiveGetPropertyReply<Puck::StandardParser>(bus, 11, propId, &result, true, false));
+	EXPECT_EQ(100, result);
+	EXPECT_DOUBLE_EQ(5.0, bus.getLastReceiveTime());
+	ASSERT_EQ(0, Puck::receiveGetPropertyReply(bus, 14, propId, &result, true, false));
+	EXPECT_DOUBLE_EQ(5.0 + 3*FakePuckBus::REPLY_INTERVAL, bus.getLastReceiveTime());
+	ASSERT_EQ(0, Puck::receiveGetPropertyReply(bus, 12, propId, &result, true, false));
+	EXPECT_DOUBLE_EQ(5.0 + FakePuckBus::REPLY_INTERVAL, bus.getLastReceiveTime());
+
+	int results[NUM_PUCKS];
+	group.getProperty(Puck::SG, results);
+	EXPECT_DOUBLE_EQ(5.0 + (2*NUM_PUCKS - 1)*FakePuckBus::REPLY_INTERVAL, bus.getLastReceiveTime());
+}
+
+
+}
@@ -0,0 +1,58 @@
+/*
+ * tactile_puck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <barrett/products/tactile_puck.h>
+
+
+namespace {
+using namespace barrett;
+
+
+TEST(TactilePuckTest, Top10Parser) {
+	// The example from the TACT documentation
+	const unsigned char data[8] = { 0x98, 0x3A, 0x83, 0x64, 0x5E, 0x77, 0xB6, 0x93 };
+	const size_t sensors[10] = { 1, 2, 8, 10, 12, 13, 14, 20, 21, 24 };
+	const double pressures[10] = { 6, 4, 5, 14, 7, 7, 11, 6, 9, 3 };
+
+	TactilePuck::v_type expected(0.0);
+	for (size_t i = 0; i < 10; ++i) {
+		expected[sensors[i] - 1] = pressures[i];
+	}
+
+	TactilePuck::v_type result(-1.0);
+	EXPECT_EQ(0, TactilePuck::Top10TactParser::parse(0, 0, &result, data, 8));
+	EXPECT_EQ(expected, result);
+
+	EXPECT_NE(0, TactilePuck::Top10TactParser::parse(0, 0, &result, data, 7));
+}
+
+TEST(TactilePuckTest, Top10ParserFewerSensors) {
+	const unsigned char data[8] = { 0x00, 0x00, 0x05, 0xF1, 0x00, 0x00, 0x00, 0x00 };
+
+	TactilePuck::v_type result(-1.0);
+	EXPECT_EQ(0, TactilePuck::Top10TactParser::parse(0, 0, &result, data, 8));
+	EXPECT_EQ(15.0, result[0]);
+	EXPECT_EQ(1.0, result[2]);
+	EXPECT_EQ(16.0, result.sum());  // Everything else is zero
+}
+
+TEST(TactilePuckTest, FullParser) {
+	// The third message: cells 10 through 14
+	const unsigned char data[8] = { 0x21, 0x00, 0x20, 0x00, 0x00, 0x30, 0x00, 0x80 };
+
+	TactilePuck::v_type result(0.0);
+	EXPECT_EQ(0, TactilePuck::FullTactParser::parse(0, 0, &result, data, 8));
+	EXPECT_EQ(1.0, result[10]);
+	EXPECT_EQ(2.0, result[11]);
+	EXPECT_EQ(0.0, result[12]);
+	EXPECT_EQ(3.0, result[13]);
+	EXPECT_EQ(0.5, result[14]);
+	EXPECT_EQ(6.5, result.sum());
+}
+
+
+}
@@ -0,0 +1,201 @@
+/*
+ * admittance.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <libconfig.h++>
+#include <gtest/gtest.h>
+#include <Eigen/Geometry>
+
+#include <barrett/math/kinematics.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/exposed_output.h>
+#include <barrett/systems/kinematics_base.h>
+#include <barrett/systems/admittance.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 7;
+const double T_s = 0.002;
+typedef systems::Admittance<DOF> admittance_type;
+
+// Takes the tool orientation from a member instead of kinInput.
+class TestAdmittance : public admittance_type {
+public:
+	explicit TestAdmittance(systems::ExecutionManager* em) :
+		admittance_type(em, cartesian_gain_type(2.0), cartesian_gain_type(20.0),
+				cartesian_gain_type(0.0), 0.5),
+		toolRotation(Eigen::Matrix3d::Identity()) {}
+
+	math::Matrix<3,3> toolRotation;
+
+protected:
+	virtual bool inputsValid() {
+		return anchored  &&  forceInput.valueDefined();
+	}
+	virtual void readKinematics() {
+		R = toolRotation;
+	}
+};
+
+class AdmittanceTest : public ::testing::Test {
+public:
+	AdmittanceTest() :
+		mem(T_s), adm(&mem), force(units::CartesianForce::type(0.0)), start(0.0)
+	{
+		start << 0.5, 0.0, 0.3;
+		mem.startManaging(eios);
+		systems::connect(force.output, adm.forceInput);
+		systems::connect(adm.output, eios.input);
+	}
+
+protected:
+	void run(int n) {
+		for (int i = 0; i < n; ++i) {
+			mem.runExecutionCycle();
+		}
+	}
+
+	systems::ManualExecutionManager mem;
+	TestAdmittance adm;
+	systems::ExposedOutput<units::CartesianForce::type> force;
+	ExposedIOSystem<units::CartesianPosition::type> eios;
+	units::CartesianPosition::type start;
+};
+
+
+TEST_F(AdmittanceTest, UndefinedUntilReset) {
+	run(10);
+	EXPECT_FALSE(eios.inputValueDefined());
+
+	adm.reset(start);
+	run(10);
+	EXPECT_EQ(start, eios.getInputValue());
+	EXPECT_EQ(start, adm.getAnchor());
+}
+
+TEST_F(AdmittanceTest, SteadyVelocity) {
+	adm.reset(start);
+	units::CartesianForce::type f(0.0);
+	f[1] = 4.0;
+	force.setValue(f);
+
+	// Terminal velocity is f / damping
+	run(5000);
+	EXPECT_NEAR(0.2, adm.getVelocity()[1], 1e-9);
+	EXPECT_EQ(0.0, adm.getVelocity()[0]);
+	EXPECT_GT(eios.getInputValue()[1], 1.0);
+	EXPECT_EQ(start[2], eios.getInputValue()[2]);
+
+	// Stops when released
+	force.setValue(units::CartesianForce::type(0.0));
+	run(5000);
+	EXPECT_NEAR(0.0, adm.getVelocity().norm(), 1e-9);
+}
+
+TEST_F(AdmittanceTest, ForceIsInToolFrame) {
+	adm.reset(start);
+	adm.toolRotation = Eigen::AngleAxisd(M_PI_2, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+	units::CartesianForce::type f(0.0);
+	f[0] = 4.0;  // Tool x is world y
+	force.setValue(f);
+
+	run(100);
+	EXPECT_NEAR(0.0, adm.getVelocity()[0], 1e-9);
+	EXPECT_GT(adm.getVelocity()[1], 0.0);
+}
+
+TEST_F(AdmittanceTest, StiffnessAndLimits) {
+	adm.setParameters(admittance_type::cartesian_gain_type(2.0), admittance_type::cartesian_gain_type(20.0),
+			admittance_type::cartesian_gain_type(100.0));
+	adm.reset(start);
+	units::CartesianForce::type f(0.0);
+	f[2] = 10.0;
+	force.setValue(f);
+
+	// Settles at f / stiffness from the anchor
+	run(5000);
+	EXPECT_NEAR(start[2] + 0.1, eios.getInputValue()[2], 1e-6);
+
+	// The speed is limited
+	f[2] = 1000.0;
+	force.setValue(f);
+	run(1);
+	EXPECT_NEAR(0.5, adm.getVelocity().norm(), 1e-9);
+
+	// Small forces are ignored
+	adm.reset(start);
+	adm.setDeadBand(1.0);
+	f[2] = 0.5;
+	force.setValue(f);
+	run(100);
+	EXPECT_EQ(start, eios.getInputValue());
+}
+
+TEST_F(AdmittanceTest, Throws) {
+	typedef admittance_type::cartesian_gain_type g;
+	EXPECT_THROW(adm.setParameters(g(0.0), g(1.0), g(1.0)), std::invalid_argument);
+	EXPECT_THROW(adm.setParameters(g(1.0), g(-1.0), g(1.0)), std::invalid_argument);
+	EXPECT_THROW(adm.setMaxVelocity(0.0), std::invalid_argument);
+}
+
+// Uses kinInput as Wam does, instead of TestAdmittance's member.
+TEST(AdmittanceKinematicsTest, ReadsKinematics) {
+	typedef units::JointPositions<DOF>::type jp_type;
+	typedef units::JointVelocities<DOF>::type jv_type;
+	typedef units::CartesianPosition::type cp_type;
+
+	libconfig::Config config;
+	config.readFile("test.config");
+
+	jp_type jp;
+	jp << 0.3, -1.2, 0.1, 2.1, -0.4, 0.9, 0.2;
+
+	const double mass = 2.0;
+	systems::ManualExecutionManager mem(T_s);
+	systems::KinematicsBase<DOF> kinBase(config.lookup("wam.kinematics"));
+	admittance_type adm(&mem, admittance_type::cartesian_gain_type(mass),
+			admittance_type::cartesian_gain_type(20.0), admittance_type::cartesian_gain_type(0.0), 0.5);
+	systems::ExposedOutput<jp_type> jpSource(jp);
+	systems::ExposedOutput<jv_type> jvSource(jv_type(0.0));
+	systems::ExposedOutput<units::CartesianForce::type> force;
+	ExposedIOSystem<cp_type> eios;
+	mem.startManaging(eios);
+
+	systems::connect(jpSource.output, kinBase.jpInput);
+	systems::connect(jvSource.output, kinBase.jvInput);
+	systems::connect(kinBase.kinOutput, adm.kinInput);
+	systems::connect(force.output, adm.forceInput);
+	systems::connect(adm.output, eios.input);
+
+	cp_type start(0.0);
+	units::CartesianForce::type f;
+	f << 1.0, -2.0, 3.0;
+	adm.reset(start);
+	force.setValue(f);
+	mem.runExecutionCycle();
+
+	// The first step moves the output along the force, rotated into the world frame.
+	math::Kinematics<DOF> kin(config.lookup("wam.kinematics"));
+	kin.eval(jp, jv_type(0.0));
+	math::Matrix<3,3> R;
+	R.copyFrom(kin.impl->tool->rot_to_world);
+	cp_type expected = (T_s * T_s / mass) * (R * f);
+
+	ASSERT_TRUE(eios.inputValueDefined());
+	for (size_t i = 0; i < 3; ++i) {
+		EXPECT_NEAR(expected[i], eios.getInputValue()[i], 1e-12);
+	}
+}
+
+
+}
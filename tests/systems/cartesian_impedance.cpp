@@ -0,0 +1,174 @@
+/*
+ * cartesian_impedance.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <libconfig.h++>
+#include <gtest/gtest.h>
+#include <Eigen/Geometry>
+
+#include <barrett/math/kinematics.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/exposed_output.h>
+#include <barrett/systems/kinematics_base.h>
+#include <barrett/systems/cartesian_impedance.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 4;
+typedef systems::CartesianImpedance<DOF> impedance_type;
+typedef units::CartesianPosition::type cp_type;
+typedef units::JointTorques<DOF>::type jt_type;
+
+// Takes the Jacobian, tool rotation, and tool velocity from members instead of kinInput.
+class TestImpedance : public impedance_type {
+public:
+	TestImpedance() :
+		toolJacobian(0.0), toolRotation(Eigen::Matrix3d::Identity()), toolVelocity(0.0) {}
+
+	math::Matrix<3,DOF> toolJacobian;
+	math::Matrix<3,3> toolRotation;
+	units::CartesianVelocity::type toolVelocity;
+
+protected:
+	virtual bool inputsValid() {
+		return this->referenceInput.valueDefined()  &&  this->feedbackInput.valueDefined();
+	}
+	virtual void readKinematics() {
+		J = toolJacobian;
+		R = toolRotation;
+		cv = toolVelocity;
+	}
+};
+
+class CartesianImpedanceTest : public ::testing::Test {
+public:
+	CartesianImpedanceTest() :
+		mem(0.002), reference(cp_type(0.0)), feedback(cp_type(0.0))
+	{
+		// Joint i moves the tool along axis i; joint 3 doesn't move it.
+		imp.toolJacobian.leftCols<3>().setIdentity();
+
+		mem.startManaging(eios);
+		systems::connect(reference.output, imp.referenceInput);
+		systems::connect(feedback.output, imp.feedbackInput);
+		systems::connect(imp.controlOutput, eios.input);
+	}
+
+protected:
+	systems::ManualExecutionManager mem;
+	TestImpedance imp;
+	systems::ExposedOutput<cp_type> reference, feedback;
+	ExposedIOSystem<jt_type> eios;
+};
+
+
+TEST_F(CartesianImpedanceTest, SpringAndDamper) {
+	imp.setStiffness(impedance_type::cartesian_gain_type(100.0));
+	imp.setDamping(impedance_type::cartesian_gain_type(10.0));
+
+	cp_type cp(0.0);
+	cp << 0.1, -0.2, 0.0;
+	reference.setValue(cp);
+	imp.toolVelocity << 0.0, 0.0, 1.0;
+	mem.runExecutionCycle();
+
+	EXPECT_NEAR(10.0, eios.getInputValue()[0], 1e-12);
+	EXPECT_NEAR(-20.0, eios.getInputValue()[1], 1e-12);
+	EXPECT_NEAR(-10.0, eios.getInputValue()[2], 1e-12);
+	EXPECT_EQ(0.0, eios.getInputValue()[3]);
+}
+
+TEST_F(CartesianImpedanceTest, GainsAreInToolFrame) {
+	// Stiff only along the tool's z axis, which points along world x.
+	impedance_type::cartesian_gain_type k(0.0);
+	k[2] = 100.0;
+	imp.setStiffness(k);
+	imp.toolRotation = Eigen::AngleAxisd(M_PI_2, Eigen::Vector3d::UnitY()).toRotationMatrix();
+
+	cp_type cp(0.0);
+	cp << 0.1, 0.1, 0.1;
+	reference.setValue(cp);
+	mem.runExecutionCycle();
+
+	EXPECT_NEAR(10.0, eios.getInputValue()[0], 1e-12);
+	EXPECT_NEAR(0.0, eios.getInputValue()[1], 1e-12);
+	EXPECT_NEAR(0.0, eios.getInputValue()[2], 1e-12);
+}
+
+TEST_F(CartesianImpedanceTest, Throws) {
+	impedance_type::cartesian_gain_type g(1.0);
+	g[1] = -1.0;
+	EXPECT_THROW(imp.setStiffness(g), std::invalid_argument);
+	EXPECT_THROW(imp.setDamping(g), std::invalid_argument);
+}
+
+// Uses kinInput as Wam does, instead of TestImpedance's members.
+TEST(CartesianImpedanceKinematicsTest, ReadsKinematics) {
+	const size_t WAM_DOF = 7;
+	typedef units::JointPositions<WAM_DOF>::type wam_jp_type;
+	typedef units::JointVelocities<WAM_DOF>::type wam_jv_type;
+	typedef units::JointTorques<WAM_DOF>::type wam_jt_type;
+
+	libconfig::Config config;
+	config.readFile("test.config");
+
+	wam_jp_type jp;
+	jp << 0.3, -1.2, 0.1, 2.1, -0.4, 0.9, 0.2;
+	wam_jv_type jv;
+	jv << 0.2, -0.1, 0.3, 0.0, 0.5, -0.2, 0.1;
+	cp_type e(0.0);
+	e << 0.05, -0.02, 0.03;
+
+	systems::ManualExecutionManager mem(0.002);
+	systems::KinematicsBase<WAM_DOF> kinBase(config.lookup("wam.kinematics"));
+	systems::CartesianImpedance<WAM_DOF> imp;
+	systems::ExposedOutput<wam_jp_type> jpSource(jp);
+	systems::ExposedOutput<wam_jv_type> jvSource(jv);
+	systems::ExposedOutput<cp_type> reference(e), feedback(cp_type(0.0));
+	ExposedIOSystem<wam_jt_type> eios;
+	mem.startManaging(eios);
+
+	systems::connect(jpSource.output, kinBase.jpInput);
+	systems::connect(jvSource.output, kinBase.jvInput);
+	systems::connect(kinBase.kinOutput, imp.kinInput);
+	systems::connect(reference.output, imp.referenceInput);
+	systems::connect(feedback.output, imp.feedbackInput);
+	systems::connect(imp.controlOutput, eios.input);
+
+	impedance_type::cartesian_gain_type k, d;
+	k << 100.0, 200.0, 300.0;
+	d << 10.0, 20.0, 30.0;
+	imp.setStiffness(k);
+	imp.setDamping(d);
+	mem.runExecutionCycle();
+
+	math::Kinematics<WAM_DOF> kin(config.lookup("wam.kinematics"));
+	kin.eval(jp, jv);
+	math::Matrix<3,WAM_DOF> J;
+	J.copyFrom(kin.impl->tool_jacobian_linear);
+	math::Matrix<3,3> R;
+	R.copyFrom(kin.impl->tool->rot_to_world);
+	units::CartesianVelocity::type cv;
+	cv.copyFrom(kin.impl->tool_velocity);
+
+	wam_jt_type expected = J.transpose() *
+			(R * (k.cwiseProduct(R.transpose() * e) - d.cwiseProduct(R.transpose() * cv)));
+	ASSERT_TRUE(eios.inputValueDefined());
+	ASSERT_GT(expected.norm(), 1e-3);
+	for (size_t i = 0; i < WAM_DOF; ++i) {
+		EXPECT_NEAR(expected[i], eios.getInputValue()[i], 1e-9);
+	}
+}
+
+
+}
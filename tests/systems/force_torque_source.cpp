@@ -0,0 +1,194 @@
+/*
+ * force_torque_source.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <Eigen/Geometry>
+
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/exposed_output.h>
+#include <barrett/systems/force_torque_source.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const double T_s = 0.002;
+
+// Serves samples from member variables instead of a ForceTorqueSensor.
+class FakeForceTorqueSource : public systems::ForceTorqueSource {
+public:
+	FakeForceTorqueSource(systems::ExecutionManager* em) :
+		systems::ForceTorqueSource(em, 0.0, "FakeForceTorqueSource"),
+		sensorForce(0.0), sensorTorque(0.0), requests(0), cancels(0), outstanding(false), delayed(false) {}
+
+	cf_type sensorForce;
+	ct_type sensorTorque;
+	int requests, cancels;
+	bool outstanding, delayed;
+
+protected:
+	virtual void requestSample() {
+		++requests;
+		outstanding = true;
+	}
+	virtual bool collectSample(cf_type* force, ct_type* torque) {
+		EXPECT_TRUE(outstanding);
+		if (delayed) {
+			return false;
+		}
+		outstanding = false;
+		*force = sensorForce;
+		*torque = sensorTorque;
+		return true;
+	}
+	virtual void cancelSample() {
+		EXPECT_TRUE(outstanding);
+		++cancels;
+		outstanding = false;
+	}
+};
+
+class ForceTorqueSourceTest : public ::testing::Test {
+public:
+	ForceTorqueSourceTest() :
+		mem(T_s), fts(&mem)
+	{
+		mem.startManaging(force);
+		mem.startManaging(torque);
+		systems::connect(fts.forceOutput, force.input);
+		systems::connect(fts.torqueOutput, torque.input);
+	}
+
+protected:
+	systems::ManualExecutionManager mem;
+	FakeForceTorqueSource fts;
+	ExposedIOSystem<systems::ForceTorqueSource::cf_type> force;
+	ExposedIOSystem<systems::ForceTorqueSource::ct_type> torque;
+};
+
+
+TEST_F(ForceTorqueSourceTest, SplitPhase) {
+	fts.sensorForce << 1, 2, 3;
+	fts.sensorTorque << 4, 5, 6;
+
+	// The first cycle only sends a request.
+	mem.runExecutionCycle();
+	EXPECT_EQ(1, fts.requests);
+	EXPECT_TRUE(fts.outstanding);
+	EXPECT_FALSE(force.inputValueDefined());
+
+	mem.runExecutionCycle();
+	EXPECT_EQ(2, fts.requests);
+	EXPECT_EQ(fts.sensorForce, force.getInputValue());
+	EXPECT_EQ(fts.sensorTorque, torque.getInputValue());
+
+	// Late samples hold the last value without sending another request.
+	fts.delayed = true;
+	fts.sensorForce << 7, 8, 9;
+	for (int i = 0; i < 3; ++i) {
+		mem.runExecutionCycle();
+	}
+	EXPECT_EQ(2, fts.requests);
+	EXPECT_EQ(0, fts.cancels);
+	EXPECT_EQ(3u, fts.getMissedSampleCount());
+	EXPECT_EQ(1.0, force.getInputValue()[0]);
+
+	fts.delayed = false;
+	mem.runExecutionCycle();
+	EXPECT_EQ(3, fts.requests);
+	EXPECT_EQ(fts.sensorForce, force.getInputValue());
+}
+
+TEST_F(ForceTorqueSourceTest, LostSampleIsRequestedAgain) {
+	mem.runExecutionCycle();
+	fts.delayed = true;
+	for (int i = 0; i < systems::ForceTorqueSource::MAX_MISSED_CYCLES; ++i) {
+		mem.runExecutionCycle();
+	}
+	EXPECT_EQ(1, fts.cancels);
+	EXPECT_EQ(2, fts.requests);
+}
+
+TEST_F(ForceTorqueSourceTest, Tare) {
+	fts.sensorForce << 1, 2, 3;
+	fts.sensorTorque << 4, 5, 6;
+	mem.runExecutionCycle();
+	fts.tare();
+	mem.runExecutionCycle();
+	EXPECT_TRUE(force.getInputValue().isZero());
+	EXPECT_TRUE(torque.getInputValue().isZero());
+
+	fts.sensorForce << 1, 2, 4;
+	mem.runExecutionCycle();
+	EXPECT_EQ(1.0, force.getInputValue()[2]);
+
+	fts.clearTare();
+	mem.runExecutionCycle();
+	EXPECT_EQ(fts.sensorForce, force.getInputValue());
+	EXPECT_EQ(fts.sensorTorque, torque.getInputValue());
+}
+
+TEST_F(ForceTorqueSourceTest, ToolGravityCompensation) {
+	const double m = 2.0;
+	const double W = m * systems::ForceTorqueSource::GRAVITY;
+	systems::ForceTorqueSource::cp_type com(0.0);
+	com[2] = 0.1;
+	fts.setToolMass(m, com);
+
+	// Sensor z axis pointing down: the tool pulls on it along +z.
+	systems::ExposedOutput<Eigen::Quaterniond> orientation(
+			Eigen::Quaterniond(Eigen::AngleAxisd(M_PI, Eigen::Vector3d::UnitX())));
+	systems::connect(orientation.output, fts.toolOrientationInput);
+	fts.sensorForce << 0, 0, W;
+	fts.sensorTorque.setZero();
+	mem.runExecutionCycle();
+	mem.runExecutionCycle();
+	EXPECT_NEAR(0.0, force.getInputValue().norm(), 1e-9);
+	EXPECT_NEAR(0.0, torque.getInputValue().norm(), 1e-9);
+
+	// Sensor x axis pointing down: the weight pulls along +x and twists about y.
+	orientation.setValue(Eigen::Quaterniond(Eigen::AngleAxisd(-M_PI_2, Eigen::Vector3d::UnitY())));
+	fts.sensorForce << W, 0, 0;
+	fts.sensorTorque << 0, 0.1 * W, 0;
+	mem.runExecutionCycle();
+	EXPECT_NEAR(0.0, force.getInputValue().norm(), 1e-9);
+	EXPECT_NEAR(0.0, torque.getInputValue().norm(), 1e-9);
+
+	// Without an orientation, there is no compensation.
+	orientation.setValueUndefined();
+	mem.runExecutionCycle();
+	EXPECT_EQ(fts.sensorForce, force.getInputValue());
+}
+
+TEST_F(ForceTorqueSourceTest, LowPass) {
+	fts.setLowPass(10.0);
+	EXPECT_EQ(10.0, fts.getLowPass());
+	fts.sensorForce << 1, 0, 0;
+	mem.runExecutionCycle();
+	mem.runExecutionCycle();
+	EXPECT_GT(force.getInputValue()[0], 0.0);
+	EXPECT_LT(force.getInputValue()[0], 0.1);
+
+	for (int i = 0; i < 5000; ++i) {
+		mem.runExecutionCycle();
+	}
+	EXPECT_NEAR(1.0, force.getInputValue()[0], 1e-6);
+}
+
+TEST_F(ForceTorqueSourceTest, Throws) {
+	EXPECT_THROW(systems::ForceTorqueSource(&mem, NULL), std::invalid_argument);
+	EXPECT_THROW(fts.setLowPass(-1.0), std::invalid_argument);
+	EXPECT_THROW(fts.setToolMass(-1.0, systems::ForceTorqueSource::cp_type(0.0)), std::invalid_argument);
+}
+
+
+}
@@ -0,0 +1,209 @@
+/*
+ * hand_sensors.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/products/hand.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/hand_sensors.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const double T_s = 0.002;
+const size_t NUM_TACTILE_PUCKS = 4;
+
+// Records the reads instead of talking to a Hand.
+class FakeHandSensors : public systems::HandSensors {
+public:
+	FakeHandSensors(systems::ExecutionManager* em, size_t maxReadsPerCycle = 1) :
+		systems::HandSensors(em, true, NUM_TACTILE_PUCKS, maxReadsPerCycle, "FakeHandSensors"),
+		positionReads(0), fingertipTorqueReads(0), top10Reads(NUM_TACTILE_PUCKS), fullReads(NUM_TACTILE_PUCKS),
+		readsThisCycle(0), maxReadsSeen(0) {}
+
+	// Call before each execution cycle
+	void startCycle() {
+		readsThisCycle = 0;
+	}
+
+	int positionReads, fingertipTorqueReads;
+	std::vector<int> top10Reads, fullReads;
+	int readsThisCycle, maxReadsSeen;
+
+protected:
+	void count() {
+		++readsThisCycle;
+		maxReadsSeen = std::max(maxReadsSeen, readsThisCycle);
+	}
+
+	virtual void readPosition(jp_type* innerJp, jp_type* outerJp) {
+		count();
+		++positionReads;
+		innerJp->setConstant(positionReads);
+		outerJp->setConstant(-positionReads);
+	}
+	virtual void readFingertipTorque(v_type* fingertipTorque) {
+		count();
+		++fingertipTorqueReads;
+		fingertipTorque->setConstant(fingertipTorqueReads);
+	}
+	virtual void readTactTop10(size_t i, TactilePuck::v_type* tactile) {
+		count();
+		++top10Reads[i];
+		tactile->setConstant(10 * i + 1);
+	}
+	virtual void readTactFull(size_t i, TactilePuck::v_type* tactile) {
+		count();
+		++fullReads[i];
+		tactile->setConstant(10 * i + 2);
+	}
+};
+
+class HandSensorsTest : public ::testing::Test {
+public:
+	HandSensorsTest() :
+		mem(T_s) {}
+
+protected:
+	void run(FakeHandSensors* hs, int n) {
+		for (int i = 0; i < n; ++i) {
+			hs->startCycle();
+			mem.runExecutionCycle();
+		}
+	}
+
+	systems::ManualExecutionManager mem;
+};
+
+
+TEST_F(HandSensorsTest, NothingReadByDefault) {
+	FakeHandSensors hs(&mem);
+	ExposedIOSystem<systems::HandSensors::jp_type> eios;
+	mem.startManaging(eios);
+	systems::connect(hs.innerJpOutput, eios.input);
+
+	run(&hs, 10);
+	EXPECT_EQ(0, hs.maxReadsSeen);
+	EXPECT_FALSE(eios.inputValueDefined());
+
+	systems::HandSensors::Snapshot snapshot;
+	EXPECT_FALSE(hs.getSnapshot(&snapshot));
+	EXPECT_EQ(0.0, hs.getRate(Hand::S_POSITION));
+}
+
+TEST_F(HandSensorsTest, Rates) {
+	FakeHandSensors hs(&mem);
+	hs.setRate(Hand::S_POSITION, 100.0);  // Every 5 cycles
+	hs.setRate(Hand::S_FINGERTIP_TORQUE, 50.0);  // Every 10 cycles
+	EXPECT_EQ(100.0, hs.getRate(Hand::S_POSITION));
+	EXPECT_EQ(50.0, hs.getRate(Hand::S_FINGERTIP_TORQUE));
+
+	run(&hs, 100);
+	EXPECT_EQ(20, hs.positionReads);
+	EXPECT_EQ(10, hs.fingertipTorqueReads);
+	EXPECT_EQ(1, hs.maxReadsSeen);
+	EXPECT_EQ(0u, hs.getOverrunCount());
+
+	hs.setRate(Hand::S_POSITION | Hand::S_FINGERTIP_TORQUE, 0.0);
+	run(&hs, 100);
+	EXPECT_EQ(20, hs.positionReads);
+	EXPECT_EQ(10, hs.fingertipTorqueReads);
+}
+
+TEST_F(HandSensorsTest, ReadsAreBoundedAndShared) {
+	FakeHandSensors hs(&mem);
+	hs.setRate(Hand::S_POSITION, 100.0);
+	hs.setRate(Hand::S_TACT_FULL, 50.0);  // 4 reads every 10 cycles
+
+	run(&hs, 100);
+	EXPECT_EQ(1, hs.maxReadsSeen);
+	EXPECT_EQ(20, hs.positionReads);
+	for (size_t i = 0; i < NUM_TACTILE_PUCKS; ++i) {
+		EXPECT_EQ(10, hs.fullReads[i]);
+		EXPECT_EQ(0, hs.top10Reads[i]);
+	}
+	EXPECT_EQ(0u, hs.getOverrunCount());
+}
+
+TEST_F(HandSensorsTest, Overrun) {
+	FakeHandSensors hs(&mem);
+	hs.setRate(Hand::S_TACT_FULL | Hand::S_TACT_TOP10, 1.0 / T_s);  // 8 reads per cycle
+
+	run(&hs, 80);
+	EXPECT_EQ(1, hs.maxReadsSeen);
+	EXPECT_GT(hs.getOverrunCount(), 0u);
+
+	// Round-robin: everyone gets a turn.
+	for (size_t i = 0; i < NUM_TACTILE_PUCKS; ++i) {
+		EXPECT_EQ(10, hs.fullReads[i]);
+		EXPECT_EQ(10, hs.top10Reads[i]);
+	}
+
+	hs.setMaxReadsPerCycle(8);
+	hs.maxReadsSeen = 0;
+	run(&hs, 10);
+	EXPECT_EQ(8, hs.maxReadsSeen);
+}
+
+TEST_F(HandSensorsTest, OutputsAndSnapshot) {
+	FakeHandSensors hs(&mem, 2);
+	ExposedIOSystem<systems::HandSensors::jp_type> inner, outer;
+	ExposedIOSystem<systems::HandSensors::v_type> ftt;
+	ExposedIOSystem<systems::HandSensors::tactile_type> tact;
+	mem.startManaging(inner);
+	mem.startManaging(outer);
+	mem.startManaging(ftt);
+	mem.startManaging(tact);
+	systems::connect(hs.innerJpOutput, inner.input);
+	systems::connect(hs.outerJpOutput, outer.input);
+	systems::connect(hs.fingertipTorqueOutput, ftt.input);
+	systems::connect(hs.tactileOutput, tact.input);
+
+	hs.setRate(Hand::S_POSITION | Hand::S_TACT_FULL, 1.0 / T_s);
+	run(&hs, 1);
+	EXPECT_EQ(1, hs.positionReads);
+	EXPECT_EQ(1, hs.fullReads[0]);
+	EXPECT_TRUE(inner.inputValueDefined());
+	EXPECT_EQ(1.0, inner.getInputValue()[0]);
+	EXPECT_EQ(-1.0, outer.getInputValue()[3]);
+	EXPECT_FALSE(ftt.inputValueDefined());
+	EXPECT_TRUE(tact.inputValueDefined());
+	EXPECT_EQ(2.0, tact.getInputValue()(0, 23));
+	EXPECT_EQ(0.0, tact.getInputValue()(1, 0));
+
+	systems::HandSensors::Snapshot snapshot;
+	ASSERT_TRUE(hs.getSnapshot(&snapshot));
+	EXPECT_EQ(1.0, snapshot.innerJp[2]);
+	EXPECT_EQ(2.0, snapshot.tactile(0, 0));
+	EXPECT_GT(snapshot.positionTime, 0.0);
+	EXPECT_GT(snapshot.tactileTime, 0.0);
+	EXPECT_EQ(0.0, snapshot.fingertipTorqueTime);
+
+	run(&hs, 3);
+	ASSERT_TRUE(hs.getSnapshot(&snapshot));
+	EXPECT_EQ(12.0, snapshot.tactile(1, 5));
+	EXPECT_EQ(32.0, snapshot.tactile(3, 5));
+}
+
+TEST_F(HandSensorsTest, Throws) {
+	EXPECT_THROW(FakeHandSensors(&mem, 0), std::invalid_argument);
+	EXPECT_THROW(systems::HandSensors(&mem, NULL), std::invalid_argument);
+
+	FakeHandSensors hs(&mem);
+	EXPECT_THROW(hs.setRate(Hand::S_POSITION, -1.0), std::invalid_argument);
+	EXPECT_THROW(hs.getRate(Hand::S_POSITION | Hand::S_TACT_FULL), std::invalid_argument);
+	EXPECT_THROW(hs.setMaxReadsPerCycle(0), std::invalid_argument);
+}
+
+
+}
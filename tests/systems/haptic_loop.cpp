@@ -0,0 +1,153 @@
+/*
+ * haptic_loop.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <algorithm>
+
+#include <libconfig.h++>
+
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/kinematics_base.h>
+#include <barrett/systems/haptic_loop.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 7;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const double MAX_AGE = 0.05;
+
+
+// Publishes whatever Snapshot the test gives it.
+class FakeKinematicsBase : public systems::KinematicsBase<DOF> {
+public:
+	explicit FakeKinematicsBase(const libconfig::Setting& setting) :
+		systems::KinematicsBase<DOF>(setting) {}
+
+	void publish(const Snapshot& snapshot) {
+		snapshotLock.write(snapshot);
+	}
+};
+
+class HapticLoopTest : public ::testing::Test {
+public:
+	HapticLoopTest() :
+		kb(NULL), loop(NULL)
+	{
+		libconfig::Config config;
+		config.readFile("test.config");
+		kb = new FakeKinematicsBase(config.lookup("wam.kinematics"));
+		loop = new systems::HapticLoop<DOF>(&mem, *kb, MAX_AGE);
+
+		systems::connect(loop->toolPosition, tpEios.input);
+		systems::connect(loop->toolVelocity, tvEios.input);
+		systems::connect(forceEios.output, loop->toolForceInput);
+		mem.startManaging(tpEios);
+		mem.startManaging(tvEios);
+
+		snapshot.toolPosition << 0.4, -0.1, 0.3;
+		snapshot.toolOrientation = Eigen::Quaterniond::Identity();
+		snapshot.toolVelocity << 0.2, -0.5, 0.1;
+		for (size_t r = 0; r < 6; ++r) {
+			for (size_t c = 0; c < DOF; ++c) {
+				snapshot.toolJacobian(r, c) = 0.1 * r - 0.05 * c + 0.3;
+			}
+		}
+
+		force << 3.0, -1.0, 2.0;
+		forceEios.setOutputValue(force);
+	}
+	~HapticLoopTest() {
+		delete loop;
+		delete kb;
+	}
+
+	void publish(double age) {
+		snapshot.timestamp = highResolutionSystemTime() - age;
+		kb->publish(snapshot);
+	}
+
+protected:
+	systems::ManualExecutionManager mem;
+	FakeKinematicsBase* kb;
+	systems::HapticLoop<DOF>* loop;
+	ExposedIOSystem<cp_type> tpEios;
+	ExposedIOSystem<cv_type> tvEios;
+	ExposedIOSystem<cf_type> forceEios;
+
+	systems::KinematicsBase<DOF>::Snapshot snapshot;
+	cf_type force;
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+TEST_F(HapticLoopTest, ExtrapolatesToolPosition) {
+	publish(0.01);
+	double t0 = highResolutionSystemTime();
+	mem.runExecutionCycle();
+	double t1 = highResolutionSystemTime();
+
+	ASSERT_TRUE(tpEios.inputValueDefined());
+	ASSERT_TRUE(tvEios.inputValueDefined());
+	EXPECT_EQ(snapshot.toolVelocity, tvEios.getInputValue());
+
+	// The position is extrapolated to some time during the cycle.
+	for (size_t i = 0; i < 3; ++i) {
+		double a = snapshot.toolPosition[i] + (t0 - snapshot.timestamp) * snapshot.toolVelocity[i];
+		double b = snapshot.toolPosition[i] + (t1 - snapshot.timestamp) * snapshot.toolVelocity[i];
+		EXPECT_GE(tpEios.getInputValue()[i], std::min(a, b));
+		EXPECT_LE(tpEios.getInputValue()[i], std::max(a, b));
+	}
+}
+
+TEST_F(HapticLoopTest, PublishesJacobianTransposeForce) {
+	const thread::SeqLock<jt_type>& mailbox = loop->getTorqueMailbox();
+	EXPECT_FALSE(mailbox.hasBeenWritten());
+
+	publish(0.01);
+	mem.runExecutionCycle();
+
+	EXPECT_EQ(1u, mailbox.getWriteCount());
+	jt_type expected = snapshot.toolJacobian.topRows<3>().transpose() * force;
+	EXPECT_TRUE(mailbox.read().isApprox(expected, 1e-12));
+}
+
+TEST_F(HapticLoopTest, StopsPublishingWhenSnapshotIsStale) {
+	const thread::SeqLock<jt_type>& mailbox = loop->getTorqueMailbox();
+
+	// No snapshot yet
+	mem.runExecutionCycle();
+	EXPECT_FALSE(tpEios.inputValueDefined());
+	EXPECT_FALSE(mailbox.hasBeenWritten());
+
+	publish(0.01);
+	mem.runExecutionCycle();
+	EXPECT_TRUE(tpEios.inputValueDefined());
+	EXPECT_EQ(1u, mailbox.getWriteCount());
+	jt_type published = mailbox.read();
+
+	// Older than MAX_AGE
+	publish(2 * MAX_AGE);
+	forceEios.setOutputValue(cf_type(-force));
+	mem.runExecutionCycle();
+	EXPECT_FALSE(tpEios.inputValueDefined());
+	EXPECT_FALSE(tvEios.inputValueDefined());
+	EXPECT_EQ(1u, mailbox.getWriteCount());
+	EXPECT_EQ(published, mailbox.read());
+}
+
+
+}
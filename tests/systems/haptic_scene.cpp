@@ -0,0 +1,197 @@
+/*
+ * haptic_scene.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/triangle_mesh.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/haptic_scene.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
+
+
+class HapticSceneTest : public ::testing::Test {
+public:
+	HapticSceneTest() :
+		mem(0.002), scene(0.05)
+	{
+		mem.startManaging(depthEios);
+		mem.startManaging(dirEios);
+		systems::connect(posEios.output, scene.input);
+		systems::connect(scene.depthOutput, depthEios.input);
+		systems::connect(scene.directionOutput, dirEios.input);
+	}
+
+	void evaluate(const cp_type& p) {
+		posEios.setOutputValue(p);
+		mem.runExecutionCycle();
+	}
+
+protected:
+	systems::ManualExecutionManager mem;
+	systems::HapticScene scene;
+	ExposedIOSystem<cp_type> posEios;
+	ExposedIOSystem<double> depthEios;
+	ExposedIOSystem<cf_type> dirEios;
+};
+
+
+double random(double low, double high) {
+	return low + (high - low) * std::rand() / RAND_MAX;
+}
+
+cp_type randomPoint(double range) {
+	return cp_type(random(-range, range), random(-range, range), random(-range, range));
+}
+
+
+TEST_F(HapticSceneTest, Empty) {
+	evaluate(cp_type(0.1, 0.2, 0.3));
+	EXPECT_EQ(0.0, depthEios.getInputValue());
+	EXPECT_EQ(cf_type(0.0), dirEios.getInputValue());
+}
+
+TEST_F(HapticSceneTest, Sphere) {
+	scene.addSphere(cp_type(0.5, 0.0, 0.0), 0.1);
+
+	evaluate(cp_type(0.5, 0.0, 0.11));
+	EXPECT_EQ(0.0, depthEios.getInputValue());
+
+	evaluate(cp_type(0.5, 0.0, 0.09));
+	EXPECT_NEAR(0.01, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(0.0, 0.0, 1.0)));
+
+	// Pushed through
+	evaluate(cp_type(0.5, 0.0, 0.04));
+	EXPECT_EQ(0.0, depthEios.getInputValue());
+}
+
+TEST_F(HapticSceneTest, BoxCapsuleAndPlane) {
+	scene.addBox(cp_type(0.0, 0.0, 0.0), math::Vector<3>::type(0.2, 0.4, 0.6));
+	scene.addCapsule(cp_type(1.0, 0.0, 0.0), cp_type(1.0, 1.0, 0.0), 0.1);
+	scene.addPlane(cp_type(0.0, 0.0, -1.0), cf_type(0.0, 0.0, 2.0));
+	EXPECT_EQ(3u, scene.size());
+
+	evaluate(cp_type(0.09, 0.0, 0.1));
+	EXPECT_NEAR(0.01, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(1.0, 0.0, 0.0)));
+
+	evaluate(cp_type(0.93, 0.5, 0.0));
+	EXPECT_NEAR(0.03, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(-1.0, 0.0, 0.0)));
+
+	evaluate(cp_type(5.0, 5.0, -1.02));
+	EXPECT_NEAR(0.02, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(0.0, 0.0, 1.0)));
+}
+
+TEST_F(HapticSceneTest, BoxRemembersEntryFace) {
+	scene.addBox(cp_type(0.0, 0.0, 0.0), math::Vector<3>::type(0.2, 0.4, 0.6));
+
+	// Enter through +x
+	evaluate(cp_type(0.09, 0.0, 0.1));
+	EXPECT_NEAR(0.01, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(1.0, 0.0, 0.0)));
+
+	// The +z face is nearer now, but the tool is still pushed out through +x
+	evaluate(cp_type(0.08, 0.0, 0.295));
+	EXPECT_NEAR(0.02, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(1.0, 0.0, 0.0)));
+
+	// Pushed through
+	evaluate(cp_type(0.04, 0.0, 0.295));
+	EXPECT_EQ(0.0, depthEios.getInputValue());
+
+	// Leave, then come back in through +z
+	evaluate(cp_type(0.0, 0.0, 0.35));
+	EXPECT_EQ(0.0, depthEios.getInputValue());
+	evaluate(cp_type(0.0, 0.0, 0.29));
+	EXPECT_NEAR(0.01, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(0.0, 0.0, 1.0)));
+}
+
+TEST_F(HapticSceneTest, Mesh) {
+	// A tetrahedron
+	std::vector<math::TriangleMesh::vector_type> v;
+	v.push_back(math::TriangleMesh::vector_type(0.0, 0.0, 0.0));
+	v.push_back(math::TriangleMesh::vector_type(1.0, 0.0, 0.0));
+	v.push_back(math::TriangleMesh::vector_type(0.0, 1.0, 0.0));
+	v.push_back(math::TriangleMesh::vector_type(0.0, 0.0, 1.0));
+	std::vector<math::TriangleMesh::Triangle> t;
+	t.push_back(math::TriangleMesh::Triangle(0, 2, 1));
+	t.push_back(math::TriangleMesh::Triangle(0, 1, 3));
+	t.push_back(math::TriangleMesh::Triangle(0, 3, 2));
+	t.push_back(math::TriangleMesh::Triangle(1, 2, 3));
+	scene.addMesh(math::TriangleMesh(v, t));
+
+	evaluate(cp_type(0.2, 0.3, 0.01));
+	EXPECT_NEAR(0.01, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(0.0, 0.0, -1.0)));
+
+	evaluate(cp_type(0.2, 0.3, -0.01));
+	EXPECT_EQ(0.0, depthEios.getInputValue());
+}
+
+TEST_F(HapticSceneTest, SumsForces) {
+	scene.addPlane(cp_type(0.0, 0.0, 0.0), cf_type(0.0, 0.0, 1.0));
+	scene.addPlane(cp_type(0.0, 0.0, 0.0), cf_type(1.0, 0.0, 0.0));
+
+	evaluate(cp_type(-0.03, 0.0, -0.04));
+	EXPECT_NEAR(0.05, depthEios.getInputValue(), 1e-12);
+	EXPECT_TRUE(dirEios.getInputValue().isApprox(cf_type(0.6, 0.0, 0.8)));
+}
+
+TEST_F(HapticSceneTest, MatchesBruteForce) {
+	std::srand(7);
+	for (size_t i = 0; i < 300; ++i) {
+		cp_type c = randomPoint(1.0);
+		switch (i % 3) {
+		case 0:
+			scene.addSphere(c, random(0.01, 0.1));
+			break;
+		case 1:
+			scene.addBox(c, math::Vector<3>::type(random(0.01, 0.2), random(0.01, 0.2), random(0.01, 0.2)));
+			break;
+		default:
+			scene.addCapsule(c, c + randomPoint(0.1), random(0.01, 0.05));
+			break;
+		}
+	}
+
+	size_t touching = 0;
+	for (size_t j = 0; j < 2000; ++j) {
+		cp_type p = randomPoint(1.0);
+		evaluate(p);
+
+		cf_type expected(0.0);
+		for (size_t i = 0; i < scene.size(); ++i) {
+			double d;
+			cf_type n;
+			if (scene.getPrimitive(i).penetration(p, &d, &n)  &&  d <= scene.getMaxDepth()) {
+				expected += d * n;
+			}
+		}
+
+		EXPECT_NEAR(expected.norm(), depthEios.getInputValue(), 1e-12);
+		if (expected.norm() > 0.0) {
+			++touching;
+			EXPECT_TRUE((expected.normalized() - dirEios.getInputValue()).norm() < 1e-9);
+		}
+	}
+	EXPECT_GT(touching, 0u);
+}
+
+
+}
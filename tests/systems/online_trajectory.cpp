@@ -0,0 +1,205 @@
+/*
+ * online_trajectory.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/systems/online_trajectory.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const double T_s = 0.002;
+const double V = 1.0;
+const double A = 2.0;
+const double J = 20.0;
+
+typedef units::JointPositions<3>::type jp_type;
+typedef jp_type::unitless_type v_type;
+
+
+class OnlineTrajectoryTest : public ::testing::Test {
+public:
+	OnlineTrajectoryTest() :
+		mem(T_s), traj(&mem)
+	{
+		mem.startManaging(eios);
+		systems::connect(traj.output, eios.input);
+	}
+
+protected:
+	systems::ManualExecutionManager mem;
+	systems::OnlineTrajectory<jp_type> traj;
+	ExposedIOSystem<jp_type> eios;
+};
+
+
+TEST_F(OnlineTrajectoryTest, HoldsResetPosition) {
+	jp_type p(0.1, 0.2, 0.3);
+	traj.reset(p);
+
+	for (int i = 0; i < 10; ++i) {
+		mem.runExecutionCycle();
+		EXPECT_EQ(p, eios.getInputValue());
+	}
+	EXPECT_TRUE(traj.isDone());
+}
+
+TEST_F(OnlineTrajectoryTest, ReachesGoal) {
+	jp_type dest(1.0, -0.5, 0.0);
+	traj.reset(jp_type(0.0));
+
+	systems::OnlineTrajectory<jp_type>::goal_id_type id = traj.setGoal(dest, V, A, J);
+	EXPECT_FALSE(traj.isDone(id));
+
+	int i = 0;
+	while ( !traj.isDone(id) ) {
+		mem.runExecutionCycle();
+		ASSERT_LT(++i, 10000);
+	}
+	EXPECT_GT(i, 1);
+	EXPECT_EQ(dest, eios.getInputValue());
+	EXPECT_TRUE(traj.isDone());
+}
+
+TEST_F(OnlineTrajectoryTest, RetargetingIsSmooth) {
+	traj.reset(jp_type(0.0));
+	traj.setGoal(jp_type(1.0, 1.0, 1.0), V, A, J);
+
+	jp_type pLast(0.0);
+	v_type vLast(0.0), vNew;
+	for (int i = 0; i < 1500; ++i) {
+		if (i % 100 == 50) {
+			// New goal every 0.2 s, like a teleoperation stream
+			double s = (i % 200 == 50) ? -1.0 : 1.0;
+			traj.setGoal(jp_type(s, 0.5 * s, -s), V, A, J);
+		}
+
+		mem.runExecutionCycle();
+		vNew = (eios.getInputValue() - pLast) / T_s;
+
+		// Finite-difference velocity is bounded and changes no faster than A allows.
+		ASSERT_LE(vNew.cwiseAbs().maxCoeff(), V + 1e-6) << "cycle " << i;
+		ASSERT_LE((vNew - vLast).cwiseAbs().maxCoeff(), A * T_s + 1e-6) << "cycle " << i;
+
+		pLast = eios.getInputValue();
+		vLast = vNew;
+	}
+}
+
+TEST_F(OnlineTrajectoryTest, PathLimits) {
+	jp_type dest(1.0, -0.5, 0.25);
+	traj.setPathLimits(true);
+	traj.reset(jp_type(0.0));
+	traj.setGoal(dest, V, A, J);
+
+	jp_type pLast(0.0);
+	v_type vLast(0.0), vNew;
+	double vPeak = 0.0;
+	for (int i = 0; i < 2000; ++i) {
+		mem.runExecutionCycle();
+		const jp_type& p = eios.getInputValue();
+		vNew = (p - pLast) / T_s;
+
+		// The speed and acceleration along the path respect the limits, and
+		// the path is a straight line.
+		ASSERT_LE(vNew.norm(), V + 1e-6) << "cycle " << i;
+		ASSERT_LE((vNew - vLast).norm(), A * T_s + 1e-6) << "cycle " << i;
+		ASSERT_NEAR(0.0, (p - p.dot(dest) / dest.squaredNorm() * dest).norm(), 1e-9) << "cycle " << i;
+
+		vPeak = std::max(vPeak, vNew.norm());
+		pLast = p;
+		vLast = vNew;
+	}
+	EXPECT_NEAR(V, vPeak, 1e-3);
+	EXPECT_EQ(dest, eios.getInputValue());
+	EXPECT_TRUE(traj.isDone());
+}
+
+TEST_F(OnlineTrajectoryTest, PathLimitsWhileRetargeting) {
+	traj.setPathLimits(true);
+	traj.reset(jp_type(0.0));
+
+	// Like a teleoperation master at 50 Hz: moving along x, then each new
+	// goal turns the path by 90 degrees.
+	const jp_type goals[] = {
+		jp_type(2.0, 0.0, 0.0), jp_type(0.5, 2.0, 0.0), jp_type(0.5, 0.5, 2.0),
+		jp_type(-1.5, 0.5, 0.5), jp_type(-1.5, -1.5, 0.5), jp_type(0.0, 0.0, 0.0)
+	};
+	const size_t numGoals = sizeof(goals) / sizeof(goals[0]);
+
+	jp_type pLast(0.0);
+	for (int i = 0; i < 4000; ++i) {
+		if (i % 10 == 0) {
+			traj.setGoal(goals[std::min(i / 500, (int) numGoals - 1)], V, A, J);
+		}
+		mem.runExecutionCycle();
+		const jp_type& p = eios.getInputValue();
+		ASSERT_LE(((p - pLast) / T_s).norm(), V + 1e-6) << "cycle " << i;
+		pLast = p;
+	}
+	EXPECT_EQ(goals[numGoals - 1], eios.getInputValue());
+}
+
+TEST_F(OnlineTrajectoryTest, ResetDiscardsGoal) {
+	traj.reset(jp_type(0.0));
+	systems::OnlineTrajectory<jp_type>::goal_id_type id = traj.setGoal(jp_type(1.0), V, A, J);
+	mem.runExecutionCycle();
+
+	traj.reset(jp_type(0.5));
+	EXPECT_TRUE(traj.isDone(id));
+	for (int i = 0; i < 10; ++i) {
+		mem.runExecutionCycle();
+		EXPECT_EQ(jp_type(0.5), eios.getInputValue());
+	}
+}
+
+TEST_F(OnlineTrajectoryTest, BadLimitsThrow) {
+	EXPECT_THROW(traj.setGoal(jp_type(1.0), 0.0, A, J), std::logic_error);
+	EXPECT_THROW(traj.setGoal(jp_type(1.0), v_type(V), v_type(-A), v_type(J)), std::logic_error);
+}
+
+
+void runCycles(systems::ManualExecutionManager* mem, boost::atomic<bool>* stop) {
+	while ( !stop->load() ) {
+		mem->runExecutionCycle();
+		boost::this_thread::sleep(boost::posix_time::microseconds(100));
+	}
+}
+
+TEST_F(OnlineTrajectoryTest, WaitUntilDone) {
+	traj.reset(jp_type(0.0));
+	systems::OnlineTrajectory<jp_type>::goal_id_type id = traj.setGoal(jp_type(0.2), V, A, J);
+
+	boost::atomic<bool> stop(false);
+	boost::thread t(runCycles, &mem, &stop);
+
+	EXPECT_TRUE(traj.waitUntilDone(id));
+	EXPECT_TRUE(traj.isDone(id));
+
+	stop = true;
+	t.join();
+	EXPECT_EQ(jp_type(0.2), eios.getInputValue());
+}
+
+TEST(OnlineTrajectoryNoEmTest, WaitReturnsWithoutExecutionManager) {
+	systems::OnlineTrajectory<jp_type> traj;
+	traj.reset(jp_type(0.0));
+	EXPECT_FALSE(traj.waitUntilDone(traj.setGoal(jp_type(1.0), V, A, J)));
+}
+
+
+}
@@ -0,0 +1,163 @@
+/*
+ * playback_clock.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/exposed_output.h>
+#include <barrett/systems/playback_clock.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const double T_s = 0.001;
+const double MAX_ACCELERATION = 1.0;
+const double MAX_JERK = 5.0;
+
+class PlaybackClockTest : public ::testing::Test {
+public:
+	PlaybackClockTest() :
+		mem(T_s), clock(&mem, MAX_ACCELERATION, MAX_JERK),
+		lastRate(0.0), lastAcceleration(0.0)
+	{
+		mem.startManaging(eios);
+		systems::connect(clock.output, eios.input);
+		mem.runExecutionCycle();
+	}
+
+protected:
+	// Runs n cycles, checking that the rate respects the limits.
+	void run(int n) {
+		for (int i = 0; i < n; ++i) {
+			double lastOutput = eios.getInputValue();
+			mem.runExecutionCycle();
+			EXPECT_DOUBLE_EQ(lastOutput + T_s * clock.getRate(), eios.getInputValue());
+
+			double acceleration = (clock.getRate() - lastRate) / T_s;
+			EXPECT_LE(std::abs(acceleration), MAX_ACCELERATION + 1e-9);
+			EXPECT_LE(std::abs(acceleration - lastAcceleration), MAX_JERK * T_s + 1e-9);
+			EXPECT_GE(clock.getRate(), 0.0);
+			EXPECT_LE(clock.getRate(), clock.getMaxSpeed());
+
+			lastRate = clock.getRate();
+			lastAcceleration = acceleration;
+		}
+	}
+
+	systems::ManualExecutionManager mem;
+	systems::PlaybackClock clock;
+	ExposedIOSystem<double> eios;
+
+	double lastRate, lastAcceleration;
+};
+
+
+TEST_F(PlaybackClockTest, DefaultToStopped) {
+	EXPECT_FALSE(clock.isRunning());
+	EXPECT_EQ(1.0, clock.getSpeed());
+	EXPECT_EQ(2.0, clock.getMaxSpeed());
+
+	run(10);
+	EXPECT_EQ(0.0, eios.getInputValue());
+}
+
+TEST_F(PlaybackClockTest, StartsSmoothly) {
+	clock.start();
+	EXPECT_TRUE(clock.isRunning());
+
+	run(10);
+	EXPECT_GT(clock.getRate(), 0.0);
+	EXPECT_LT(clock.getRate(), 0.01);
+
+	run(3000);
+	EXPECT_EQ(1.0, clock.getRate());
+
+	double output = eios.getInputValue();
+	mem.runExecutionCycle();
+	EXPECT_DOUBLE_EQ(output + T_s, eios.getInputValue());
+}
+
+TEST_F(PlaybackClockTest, StopsSmoothly) {
+	clock.start();
+	run(3000);
+
+	clock.stop();
+	EXPECT_TRUE(clock.isRunning());
+	run(10);
+	EXPECT_GT(clock.getRate(), 0.99);
+
+	run(3000);
+	EXPECT_EQ(0.0, clock.getRate());
+	EXPECT_FALSE(clock.isRunning());
+
+	double output = eios.getInputValue();
+	run(10);
+	EXPECT_EQ(output, eios.getInputValue());
+}
+
+TEST_F(PlaybackClockTest, SetSpeed) {
+	clock.setSpeed(1.5);
+	EXPECT_EQ(1.5, clock.getSpeed());
+	clock.start();
+	run(4000);
+	EXPECT_EQ(1.5, clock.getRate());
+
+	clock.setSpeed(0.25);
+	run(4000);
+	EXPECT_EQ(0.25, clock.getRate());
+
+	clock.setSpeed(5.0);
+	EXPECT_EQ(2.0, clock.getSpeed());
+	clock.setSpeed(-1.0);
+	EXPECT_EQ(0.0, clock.getSpeed());
+	run(4000);
+	EXPECT_EQ(0.0, clock.getRate());
+	EXPECT_TRUE(clock.isRunning());
+}
+
+TEST_F(PlaybackClockTest, SpeedInput) {
+	systems::ExposedOutput<double> override(0.5);
+	mem.startManaging(override);
+	systems::connect(override.output, clock.speedInput);
+
+	clock.start();
+	run(4000);
+	EXPECT_EQ(0.5, clock.getRate());
+
+	override.setValue(3.0);  // Saturated
+	run(4000);
+	EXPECT_EQ(2.0, clock.getRate());
+
+	// Falls back to setSpeed()
+	override.setValueUndefined();
+	run(4000);
+	EXPECT_EQ(1.0, clock.getRate());
+}
+
+TEST_F(PlaybackClockTest, Reset) {
+	clock.start();
+	run(2000);
+	EXPECT_GT(eios.getInputValue(), 0.0);
+
+	clock.reset();
+	EXPECT_FALSE(clock.isRunning());
+	mem.runExecutionCycle();
+	EXPECT_EQ(0.0, eios.getInputValue());
+	EXPECT_EQ(0.0, clock.getRate());
+
+	clock.setOutput(3.0);
+	mem.runExecutionCycle();
+	EXPECT_EQ(3.0, eios.getInputValue());
+}
+
+
+}
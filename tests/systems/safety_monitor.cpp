@@ -0,0 +1,335 @@
+/*
+ * safety_monitor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <deque>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/bus/bus_manager.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/safety_module.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/safety_monitor.h>
+
+#include "exposed_io_system.h"
+#include "../products/fake_puck_bus.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const double T_s = 0.002;
+
+// Every parameter SAFE, no button pressed
+const int PEN_SAFE = 0x0C001249;
+// The same, with the velocity parameter at WARNING
+const int PEN_WARNING = 0x0C00124A;
+
+// Serves MODE and PEN from member variables instead of a SafetyModule. Like
+// the bus, replies arrive in the order they were requested, delay cycles
+// after the request.
+class FakeSafetyMonitor : public systems::SafetyMonitor {
+public:
+	FakeSafetyMonitor(systems::ExecutionManager* em, double rate) :
+		systems::SafetyMonitor(em, rate, "FakeSafetyMonitor"),
+		mode(SafetyModule::IDLE), pen(PEN_SAFE), requests(0), delay(1), failPenRequests(0), now(0) {}
+
+	int mode, pen;
+	int requests;
+	int delay;
+	int failPenRequests;
+
+	// Call before each execution cycle
+	void startCycle() {
+		++now;
+	}
+
+	// Queues a reply to a property other than MODE or PEN
+	void addUnexpectedReply() {
+		Reply r = { Puck::STAT, now };
+		replies.push_back(r);
+	}
+	size_t outstanding() const { return replies.size(); }
+	void dropReplies() { replies.clear(); }
+
+protected:
+	struct Reply {
+		enum Puck::Property prop;
+		int arrival;
+	};
+
+	virtual int requestProperty(enum Puck::Property prop) {
+		++requests;
+		if (prop == Puck::PEN  &&  failPenRequests > 0) {
+			--failPenRequests;
+			return 2;
+		}
+
+		Reply r = { prop, now + delay };
+		replies.push_back(r);
+		return 0;
+	}
+	virtual int receiveReply(enum Puck::Property* prop, int* value) {
+		if (replies.empty()  ||  replies.front().arrival > now) {
+			return 1;
+		}
+
+		*prop = replies.front().prop;
+		replies.pop_front();
+		if (*prop == Puck::MODE) {
+			*value = mode;
+		} else if (*prop == Puck::PEN) {
+			*value = pen;
+		} else {
+			return -1;
+		}
+		return 0;
+	}
+
+	std::deque<Reply> replies;
+	int now;
+};
+
+class SafetyMonitorTest : public ::testing::Test {
+public:
+	SafetyMonitorTest() :
+		mem(T_s), sm(&mem, 50.0)  // Every 10 cycles
+	{
+		mem.startManaging(eios);
+		systems::connect(sm.modeOutput, eios.input);
+	}
+
+	void modeChanged(enum SafetyModule::SafetyMode from, enum SafetyModule::SafetyMode to) {
+		modeChanges.push_back(from);
+		modeChanges.push_back(to);
+	}
+	void pendantStateChanged(const SafetyModule::PendantState& ps) {
+		pendantStates.push_back(ps);
+	}
+
+protected:
+	void run(int n) {
+		for (int i = 0; i < n; ++i) {
+			sm.startCycle();
+			mem.runExecutionCycle();
+		}
+	}
+
+	systems::ManualExecutionManager mem;
+	FakeSafetyMonitor sm;
+	ExposedIOSystem<enum SafetyModule::SafetyMode> eios;
+
+	std::vector<enum SafetyModule::SafetyMode> modeChanges;
+	std::vector<SafetyModule::PendantState> pendantStates;
+};
+
+
+TEST_F(SafetyMonitorTest, SplitPhaseReads) {
+	systems::SafetyMonitor::Snapshot snapshot;
+	EXPECT_FALSE(sm.getSnapshot(&snapshot));
+
+	// The first cycle only sends the requests.
+	run(1);
+	EXPECT_EQ(2, sm.requests);
+	EXPECT_FALSE(eios.inputValueDefined());
+	EXPECT_FALSE(sm.getSnapshot(&snapshot));
+
+	run(1);
+	EXPECT_EQ(SafetyModule::IDLE, eios.getInputValue());
+	ASSERT_TRUE(sm.getSnapshot(&snapshot));
+	EXPECT_EQ(SafetyModule::IDLE, snapshot.mode);
+	EXPECT_TRUE(snapshot.pendantState.allSafe());
+	EXPECT_EQ(SafetyModule::PendantState::NONE, snapshot.pendantState.pressedButton);
+	EXPECT_GT(snapshot.modeTime, 0.0);
+	EXPECT_GT(snapshot.pendantStateTime, 0.0);
+
+	run(98);
+	EXPECT_EQ(20, sm.requests);
+	EXPECT_EQ(0u, sm.getErrorCount());
+
+	sm.setRate(0.0);
+	run(100);
+	EXPECT_EQ(20, sm.requests);
+}
+
+TEST_F(SafetyMonitorTest, Callbacks) {
+	sm.setModeChangeCallback(boost::bind(&SafetyMonitorTest::modeChanged, this, _1, _2));
+	sm.setPendantStateChangeCallback(boost::bind(&SafetyMonitorTest::pendantStateChanged, this, _1));
+
+	// Not called for the first values, or if nothing changed
+	run(30);
+	EXPECT_EQ(0u, modeChanges.size());
+	EXPECT_EQ(0u, pendantStates.size());
+
+	sm.mode = SafetyModule::ESTOP;
+	sm.pen = PEN_WARNING;
+	run(10);
+	ASSERT_EQ(2u, modeChanges.size());
+	EXPECT_EQ(SafetyModule::IDLE, modeChanges[0]);
+	EXPECT_EQ(SafetyModule::ESTOP, modeChanges[1]);
+	EXPECT_EQ(SafetyModule::ESTOP, eios.getInputValue());
+	ASSERT_EQ(1u, pendantStates.size());
+	EXPECT_EQ(SafetyModule::PendantState::WARNING,
+			pendantStates[0].safetyParameters[SafetyModule::PendantState::VELOCITY]);
+
+	run(10);
+	EXPECT_EQ(2u, modeChanges.size());
+	EXPECT_EQ(1u, pendantStates.size());
+}
+
+TEST_F(SafetyMonitorTest, Errors) {
+	// Lost replies are given up on.
+	sm.delay = 1000;
+	run(1 + systems::SafetyMonitor::MAX_MISSED_CYCLES);
+	EXPECT_EQ(1u, sm.getErrorCount());
+	EXPECT_FALSE(eios.inputValueDefined());
+	sm.dropReplies();
+
+	// Bad values are ignored.
+	sm.delay = 1;
+	sm.mode = 7;
+	sm.pen = 0;
+	run(10);
+	EXPECT_EQ(3u, sm.getErrorCount());
+	EXPECT_FALSE(eios.inputValueDefined());
+}
+
+TEST_F(SafetyMonitorTest, LateRepliesDontShiftLaterReads) {
+	// The first round's replies arrive after they were given up on.
+	const int LATE = systems::SafetyMonitor::MAX_MISSED_CYCLES + 5;
+	sm.delay = LATE;
+	run(1 + systems::SafetyMonitor::MAX_MISSED_CYCLES);
+	EXPECT_EQ(1u, sm.getErrorCount());
+	sm.delay = 1;
+
+	// They are used when they arrive, and every later read gets its own reply.
+	run(LATE);
+	EXPECT_EQ(SafetyModule::IDLE, eios.getInputValue());
+	sm.mode = SafetyModule::ESTOP;
+	sm.pen = PEN_WARNING;
+	run(20);
+	EXPECT_EQ(SafetyModule::ESTOP, eios.getInputValue());
+	systems::SafetyMonitor::Snapshot snapshot;
+	ASSERT_TRUE(sm.getSnapshot(&snapshot));
+	EXPECT_EQ(SafetyModule::ESTOP, snapshot.mode);
+	EXPECT_EQ(SafetyModule::PendantState::WARNING,
+			snapshot.pendantState.safetyParameters[SafetyModule::PendantState::VELOCITY]);
+	EXPECT_EQ(1u, sm.getErrorCount());
+	EXPECT_EQ(0u, sm.outstanding());
+}
+
+TEST_F(SafetyMonitorTest, UnexpectedRepliesAreDiscarded) {
+	run(10);
+	sm.addUnexpectedReply();
+	sm.mode = SafetyModule::ACTIVE;
+	run(10);
+	EXPECT_EQ(1u, sm.getErrorCount());
+	EXPECT_EQ(SafetyModule::ACTIVE, eios.getInputValue());
+	EXPECT_EQ(0u, sm.outstanding());
+}
+
+TEST_F(SafetyMonitorTest, FailedRequest) {
+	// Only the MODE request goes out. Its reply is still used, and the next
+	// round isn't offset by it.
+	sm.failPenRequests = 1;
+	run(2);
+	EXPECT_EQ(1u, sm.getErrorCount());
+	EXPECT_EQ(SafetyModule::IDLE, eios.getInputValue());
+	systems::SafetyMonitor::Snapshot snapshot;
+	ASSERT_TRUE(sm.getSnapshot(&snapshot));
+	EXPECT_EQ(0.0, snapshot.pendantStateTime);
+
+	sm.mode = SafetyModule::ESTOP;
+	run(10);
+	EXPECT_EQ(SafetyModule::ESTOP, eios.getInputValue());
+	ASSERT_TRUE(sm.getSnapshot(&snapshot));
+	EXPECT_GT(snapshot.pendantStateTime, 0.0);
+	EXPECT_EQ(1u, sm.getErrorCount());
+}
+
+TEST_F(SafetyMonitorTest, StateSource) {
+	enum SafetyModule::SafetyMode mode;
+	SafetyModule::PendantState ps;
+	EXPECT_FALSE(sm.getMode(&mode));
+
+	run(2);
+	ASSERT_TRUE(sm.getMode(&mode));
+	EXPECT_EQ(SafetyModule::IDLE, mode);
+	ASSERT_TRUE(sm.getPendantState(&ps));
+	EXPECT_TRUE(ps.allSafe());
+
+	// Without reads, the values go stale.
+	sm.setRate(0.0);
+	run(100);
+	btsleep(0.1);
+	EXPECT_FALSE(sm.getMode(&mode));
+}
+
+TEST_F(SafetyMonitorTest, WaitForMode) {
+	run(2);
+	EXPECT_TRUE(sm.waitForMode(SafetyModule::IDLE));
+	EXPECT_FALSE(sm.waitForMode(SafetyModule::ACTIVE, 0.05));
+}
+
+TEST(SafetyMonitorBusTest, SharesTheSafetyModule) {
+	const int ID = 10;
+	FakePuckBus fakeBus;
+	bus::BusManager bus(&fakeBus);
+	fakeBus.setValue(ID, Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), 0x0002);
+	fakeBus.setValue(ID, Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), 150);
+	fakeBus.setValue(ID, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 150), 2);
+	fakeBus.setValue(ID, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 0), 2);
+	Puck puck(bus, ID);
+	fakeBus.setValue(ID, puck.getPropertyId(Puck::MODE), SafetyModule::ACTIVE);
+	fakeBus.setValue(ID, puck.getPropertyId(Puck::PEN), PEN_SAFE);
+
+	SafetyModule safetyModule(&puck);
+	systems::ManualExecutionManager mem(T_s);
+	{
+		systems::SafetyMonitor monitor(&mem, &safetyModule, 50.0);
+		EXPECT_EQ(&monitor, safetyModule.getStateSource());
+
+		// Before the monitor has a value, SafetyModule reads from the bus,
+		// receiving the monitor's MODE reply. The monitor uses the extra
+		// reply instead.
+		mem.runExecutionCycle();
+		EXPECT_EQ(SafetyModule::ACTIVE, safetyModule.getMode());
+		mem.runExecutionCycle();
+		mem.runExecutionCycle();
+		EXPECT_EQ(0u, monitor.getErrorCount());
+
+		// Afterwards, it doesn't touch the bus.
+		int requests = fakeBus.requests;
+		EXPECT_EQ(SafetyModule::ACTIVE, safetyModule.getMode());
+		SafetyModule::PendantState ps;
+		safetyModule.getPendantState(&ps);
+		EXPECT_TRUE(ps.allSafe());
+		EXPECT_EQ(requests, fakeBus.requests);
+
+		// A reply to something else is discarded.
+		Puck::sendGetPropertyRequest(bus, ID, puck.getPropertyId(Puck::STAT));
+		fakeBus.setValue(ID, puck.getPropertyId(Puck::MODE), SafetyModule::IDLE);
+		for (int i = 0; i < 10; ++i) {
+			mem.runExecutionCycle();
+		}
+		EXPECT_EQ(1u, monitor.getErrorCount());
+		EXPECT_EQ(SafetyModule::IDLE, safetyModule.getMode());
+	}
+	EXPECT_EQ(NULL, safetyModule.getStateSource());
+}
+
+TEST_F(SafetyMonitorTest, Throws) {
+	EXPECT_THROW(systems::SafetyMonitor(&mem, NULL), std::invalid_argument);
+	EXPECT_THROW(sm.setRate(-1.0), std::invalid_argument);
+}
+
+
+}
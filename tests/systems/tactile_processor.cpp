@@ -0,0 +1,135 @@
+/*
+ * tactile_processor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/products/hand.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/exposed_output.h>
+#include <barrett/systems/tactile_processor.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+typedef systems::TactileProcessor::tactile_type tactile_type;
+
+class TactileProcessorTest : public ::testing::Test {
+public:
+	TactileProcessorTest() :
+		mem(0.002), raw(tactile_type(0.0)), tp(0.5, 1.0)
+	{
+		mem.startManaging(pressure);
+		mem.startManaging(totalForce);
+		mem.startManaging(centroid);
+		systems::connect(raw.output, tp.input);
+		systems::connect(tp.output, pressure.input);
+		systems::connect(tp.totalForceOutput, totalForce.input);
+		systems::connect(tp.centroidOutput, centroid.input);
+	}
+
+protected:
+	// Cell index from (column, row)
+	static int cell(int col, int row) {
+		return row * systems::TactileProcessor::TACT_COLUMNS + col;
+	}
+
+	systems::ManualExecutionManager mem;
+	systems::ExposedOutput<tactile_type> raw;
+	systems::TactileProcessor tp;
+	ExposedIOSystem<tactile_type> pressure;
+	ExposedIOSystem<systems::TactileProcessor::v_type> totalForce;
+	ExposedIOSystem<systems::TactileProcessor::centroid_type> centroid;
+};
+
+
+TEST_F(TactileProcessorTest, ForceAndCentroid) {
+	tactile_type t(0.0);
+	t(0, cell(0, 0)) = 2.0;
+	t(0, cell(2, 0)) = 2.0;
+	t(1, cell(2, 7)) = 4.0;
+	t(2, cell(1, 3)) = 0.5;  // Below the contact threshold
+	raw.setValue(t);
+	mem.runExecutionCycle();
+
+	EXPECT_EQ(t, pressure.getInputValue());
+	EXPECT_EQ(2.0, totalForce.getInputValue()[0]);
+	EXPECT_EQ(2.0, totalForce.getInputValue()[1]);
+	EXPECT_EQ(0.25, totalForce.getInputValue()[2]);
+	EXPECT_EQ(0.0, totalForce.getInputValue()[3]);
+
+	// (column, row) from the center of the pad
+	EXPECT_EQ(0.0, centroid.getInputValue()(0, 0));
+	EXPECT_EQ(-3.5, centroid.getInputValue()(0, 1));
+	EXPECT_EQ(1.0, centroid.getInputValue()(1, 0));
+	EXPECT_EQ(3.5, centroid.getInputValue()(1, 1));
+	EXPECT_EQ(0.0, centroid.getInputValue()(2, 0));
+	EXPECT_EQ(0.0, centroid.getInputValue()(2, 1));
+}
+
+TEST_F(TactileProcessorTest, Tare) {
+	tactile_type t(3.0);
+	raw.setValue(t);
+	tp.tare(Hand::F1 | Hand::F3);
+	mem.runExecutionCycle();
+	EXPECT_EQ(0.0, pressure.getInputValue().row(0).sum());
+	EXPECT_EQ(72.0, pressure.getInputValue().row(1).sum());
+	EXPECT_EQ(0.0, pressure.getInputValue().row(2).sum());
+	EXPECT_EQ(0.0, centroid.getInputValue()(0, 0));
+
+	// Negative pressures are clipped
+	t(0, 0) = 1.0;
+	t(0, 5) = 4.0;
+	raw.setValue(t);
+	mem.runExecutionCycle();
+	EXPECT_EQ(0.0, pressure.getInputValue()(0, 0));
+	EXPECT_EQ(1.0, pressure.getInputValue()(0, 5));
+	EXPECT_EQ(0.5, totalForce.getInputValue()[0]);
+
+	tp.clearTare();
+	EXPECT_TRUE(tp.getTare().isZero());
+	mem.runExecutionCycle();
+	EXPECT_EQ(t, pressure.getInputValue());
+}
+
+TEST_F(TactileProcessorTest, SpatialFilter) {
+	tactile_type t(0.0);
+	t(0, cell(1, 4)) = 16.0;
+	t(1, cell(0, 0)) = 9.0;
+	raw.setValue(t);
+	tp.setSpatialFilter(true);
+	EXPECT_TRUE(tp.getSpatialFilter());
+	mem.runExecutionCycle();
+
+	// An interior cell spreads with weights (1 2 1) x (1 2 1) / 16
+	const tactile_type& p = pressure.getInputValue();
+	EXPECT_DOUBLE_EQ(4.0, p(0, cell(1, 4)));
+	EXPECT_DOUBLE_EQ(2.0, p(0, cell(0, 4)));
+	EXPECT_DOUBLE_EQ(2.0, p(0, cell(1, 5)));
+	EXPECT_DOUBLE_EQ(1.0, p(0, cell(2, 3)));
+	EXPECT_EQ(0.0, p(0, cell(1, 6)));
+
+	// Smoothing doesn't change the total or move an interior centroid
+	EXPECT_NEAR(16.0 * 0.5, totalForce.getInputValue()[0], 1e-12);
+	EXPECT_NEAR(0.0, centroid.getInputValue()(0, 0), 1e-12);
+	EXPECT_NEAR(0.5, centroid.getInputValue()(0, 1), 1e-12);
+
+	// A corner cell keeps 4/9 of its pressure
+	EXPECT_DOUBLE_EQ(4.0, p(1, cell(0, 0)));
+	EXPECT_DOUBLE_EQ(1.0, p(1, cell(1, 1)));
+}
+
+TEST_F(TactileProcessorTest, Throws) {
+	EXPECT_THROW(systems::TactileProcessor(0.0), std::invalid_argument);
+}
+
+
+}
@@ -0,0 +1,135 @@
+/*
+ * wam.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <libconfig.h++>
+#include <Eigen/Geometry>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/kinematics.h>
+#include <barrett/bus/bus_manager.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_group.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/wam.h>
+
+#include "../products/fake_puck_bus.h"
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 7;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const int CTS = 4096;
+
+class WamTest : public ::testing::Test {
+public:
+	WamTest() :
+		bus(&fakeBus), mem(0.002), wam(NULL), kin(NULL), positionPropId(-1)
+	{
+		std::vector<int> ids;
+		for (size_t i = 0; i < DOF; ++i) {
+			int id = 1 + i;
+			ids.push_back(id);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::ROLE, Puck::PT_Unknown, -1), 0x0000);  // ROLE_TATER
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::VERS, Puck::PT_Unknown, -1), 200);
+			fakeBus.setValue(id, Puck::getPropertyId(Puck::STAT, Puck::PT_Unknown, 200), 2);
+			pucks.push_back(new Puck(bus, id));
+
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::CTS), CTS);
+			fakeBus.setValue(id, pucks[i]->getPropertyId(Puck::IPNM), 2000);
+		}
+		fakeBus.setGroup(PuckGroup::BGRP_WAM, ids);
+
+		positionPropId = pucks[0]->getPropertyId(Puck::P);
+		setCounts(0);
+
+		libconfig::Config config;
+		config.readFile("test.config");
+		wam = new systems::Wam<DOF>(&mem, pucks, NULL, config.lookup("wam"));
+		kin = new math::Kinematics<DOF>(config.lookup("wam.kinematics"));
+	}
+	~WamTest() {
+		delete kin;
+		delete wam;
+		for (size_t i = 0; i < pucks.size(); ++i) {
+			delete pucks[i];
+		}
+	}
+
+	// Moves each motor by a different amount, some of them negative.
+	void setCounts(int offset) {
+		for (size_t i = 0; i < DOF; ++i) {
+			int c = offset * (static_cast<int>(i) - 3);
+			counts[i] = c;
+			fakeBus.setPosition(pucks[i]->getId(), positionPropId, c);
+		}
+	}
+
+	jp_type expectedPosition() const {
+		return wam->getLowLevelWam().getMotorToJointPositionTransform() * (counts * (2*M_PI / CTS));
+	}
+
+protected:
+	FakePuckBus fakeBus;
+	bus::BusManager bus;
+	std::vector<Puck*> pucks;
+	systems::ManualExecutionManager mem;
+	systems::Wam<DOF>* wam;
+	math::Kinematics<DOF>* kin;
+	int positionPropId;
+	v_type counts;
+};
+
+
+TEST_F(WamTest, GetStateFailsBeforeTheFirstCycle) {
+	systems::Wam<DOF>::State state;
+	EXPECT_FALSE(wam->getState(&state));
+}
+
+TEST_F(WamTest, GetStatePublishesEachCycle) {
+	// Give the State non-zero torques.
+	wam->gravityCompensate();
+
+	systems::Wam<DOF>::State state;
+	double lastTimestamp = 0.0;
+	for (int cycle = 0; cycle < 5; ++cycle) {
+		setCounts(100 * (cycle + 1));
+		mem.runExecutionCycle();
+
+		ASSERT_TRUE(wam->getState(&state));
+		EXPECT_EQ(static_cast<boost::uint64_t>(cycle), state.cycle);
+
+		// Everything in the State comes from the same cycle.
+		EXPECT_TRUE(state.jp.isApprox(expectedPosition(), 1e-12));
+		EXPECT_EQ(wam->getLowLevelWam().getLastUpdateTime(), state.timestamp);
+		EXPECT_GT(state.timestamp, lastTimestamp);
+		lastTimestamp = state.timestamp;
+
+		EXPECT_EQ(wam->llww.input.getValue(), state.jt);
+		EXPECT_GT(state.jt.norm(), 0.0);
+
+		kin->eval(state.jp, state.jv);
+		EXPECT_TRUE(state.toolPosition.isApprox(cp_type(kin->impl->tool->origin_pos), 1e-12));
+		math::Matrix<3,3> rot(kin->impl->tool->rot_to_world);
+		EXPECT_NEAR(0.0, state.toolOrientation.angularDistance(Eigen::Quaterniond(rot.transpose())), 1e-9);
+
+		// The getters read the same snapshot.
+		EXPECT_EQ(state.jp, wam->getJointPositions());
+		EXPECT_EQ(state.jv, wam->getJointVelocities());
+		EXPECT_EQ(state.jt, wam->getJointTorques());
+	}
+}
+
+
+}
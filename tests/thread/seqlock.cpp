@@ -0,0 +1,167 @@
+/*
+ * seqlock.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <boost/thread.hpp>
+#include <gtest/gtest.h>
+
+#include <barrett/thread/seqlock.h>
+
+
+namespace {
+using namespace barrett;
+
+
+struct Pair {
+	long a, b;
+};
+
+
+TEST(SeqLockTest, InitialState) {
+	thread::SeqLock<int> sl(5);
+	EXPECT_FALSE(sl.hasBeenWritten());
+	EXPECT_EQ(0u, sl.getWriteCount());
+	EXPECT_EQ(5, sl.read());
+}
+
+TEST(SeqLockTest, WriteThenRead) {
+	thread::SeqLock<int> sl;
+
+	sl.write(3);
+	EXPECT_TRUE(sl.hasBeenWritten());
+	EXPECT_EQ(1u, sl.getWriteCount());
+	EXPECT_EQ(3, sl.read());
+
+	sl.beginWrite() = -8;
+	sl.endWrite();
+	EXPECT_EQ(2u, sl.getWriteCount());
+
+	int i = 0;
+	EXPECT_TRUE(sl.tryRead(&i));
+	EXPECT_EQ(-8, i);
+}
+
+TEST(SeqLockTest, TryReadFailsDuringWrite) {
+	thread::SeqLock<int> sl;
+	int i = 0;
+
+	sl.beginWrite() = 1;
+	EXPECT_FALSE(sl.tryRead(&i));
+	sl.endWrite();
+	EXPECT_TRUE(sl.tryRead(&i));
+	EXPECT_EQ(1, i);
+}
+
+TEST(SeqLockTest, BoundedTryRead) {
+	thread::SeqLock<int> sl(2);
+	int i = 0;
+
+	EXPECT_TRUE(sl.tryRead(&i, 1));
+	EXPECT_EQ(2, i);
+
+	sl.beginWrite() = 4;
+	EXPECT_FALSE(sl.tryRead(&i, 10));  // Gives up instead of spinning
+	sl.endWrite();
+	EXPECT_TRUE(sl.tryRead(&i, 10));
+	EXPECT_EQ(4, i);
+}
+
+
+const int MAX_STALE_CYCLES = 3;
+
+TEST(SeqLockReaderTest, StaleUntilWritten) {
+	thread::SeqLock<int> sl(7);
+	thread::SeqLockReader<int> reader(MAX_STALE_CYCLES);
+	EXPECT_FALSE(reader.update());
+
+	reader.setSource(&sl);
+	EXPECT_FALSE(reader.update());
+	EXPECT_FALSE(reader.isFresh());
+
+	sl.write(1);
+	EXPECT_TRUE(reader.update());
+	EXPECT_EQ(1, reader.getValue());
+	EXPECT_EQ(0, reader.getStaleCycles());
+
+	reader.setSource(NULL);
+	EXPECT_FALSE(reader.update());
+}
+
+TEST(SeqLockReaderTest, GoesStaleWhenWriterStops) {
+	thread::SeqLock<int> sl;
+	thread::SeqLockReader<int> reader(MAX_STALE_CYCLES);
+	reader.setSource(&sl);
+
+	sl.write(5);
+	EXPECT_TRUE(reader.update());
+	for (int i = 1; i < MAX_STALE_CYCLES; ++i) {
+		EXPECT_TRUE(reader.update());
+		EXPECT_EQ(5, reader.getValue());
+		EXPECT_EQ(i, reader.getStaleCycles());
+	}
+	EXPECT_FALSE(reader.update());
+	EXPECT_FALSE(reader.update());
+	EXPECT_EQ(MAX_STALE_CYCLES, reader.getStaleCycles());
+
+	sl.write(6);
+	EXPECT_TRUE(reader.update());
+	EXPECT_EQ(6, reader.getValue());
+}
+
+TEST(SeqLockReaderTest, KeepsPreviousValueDuringWrite) {
+	thread::SeqLock<int> sl;
+	thread::SeqLockReader<int> reader(MAX_STALE_CYCLES);
+	reader.setSource(&sl);
+
+	sl.write(5);
+	EXPECT_TRUE(reader.update());
+
+	// A writer that never finishes (e.g. preempted by the reader's thread)
+	// doesn't stall update(). The previous value is used, and the interrupted
+	// cycles count towards staleness.
+	sl.write(6);
+	sl.beginWrite() = 7;
+	for (int i = 1; i < MAX_STALE_CYCLES; ++i) {
+		EXPECT_TRUE(reader.update());
+		EXPECT_EQ(5, reader.getValue());
+	}
+	EXPECT_FALSE(reader.update());
+
+	sl.endWrite();
+	EXPECT_TRUE(reader.update());
+	EXPECT_EQ(7, reader.getValue());
+}
+
+
+void writer(thread::SeqLock<Pair>* sl, long n) {
+	for (long i = 1; i <= n; ++i) {
+		Pair& p = sl->beginWrite();
+		p.a = i;
+		p.b = -i;
+		sl->endWrite();
+	}
+}
+
+TEST(SeqLockTest, ReadsAreNeverTorn) {
+	const long N = 200000;
+	Pair init = { 0, 0 };
+	thread::SeqLock<Pair> sl(init);
+
+	boost::thread t(writer, &sl, N);
+	Pair p;
+	long last = 0;
+	do {
+		sl.read(&p);
+		ASSERT_EQ(p.a, -p.b);
+		ASSERT_GE(p.a, last);
+		last = p.a;
+	} while (last != N);
+	t.join();
+
+	EXPECT_EQ(static_cast<unsigned long>(N), sl.getWriteCount());
+}
+
+
+}